@@ -0,0 +1,132 @@
+/*---------------------------------------------------------*\
+||| apptray.cpp                                             |
+|||                                                         |
+|||   System tray resident mode                            |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "apptray.h"
+#include "mainwindow.h"
+#include "utils/trace.h"
+#include <QApplication>
+#include <QDebug>
+#include <QIcon>
+#include <QMenu>
+#include <QPixmapCache>
+#include <QSettings>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static AppTray *s_instance = nullptr;
+
+AppTray::AppTray(QObject *parent)
+    : QObject(parent)
+    , m_trayIcon(nullptr)
+    , m_menu(nullptr)
+{
+    s_instance = this;
+
+    // The window comes and goes; the application lives until Quit (or until the
+    // window closes with the tray off, see onWindowDestroyed)
+    qApp->setQuitOnLastWindowClosed(false);
+
+    setEnabled(trayEnabled());
+}
+
+AppTray::~AppTray()
+{
+    // Before QApplication goes: the window and menu are widgets
+    if (m_window) {
+        disconnect(m_window, nullptr, this, nullptr);
+        delete m_window;
+    }
+    delete m_menu;
+    s_instance = nullptr;
+}
+
+AppTray *AppTray::instance()
+{
+    return s_instance;
+}
+
+bool AppTray::trayEnabled()
+{
+    QSettings settings("LianLi", "LConnect3");
+    return settings.value("Tray/Enabled", false).toBool() && QSystemTrayIcon::isSystemTrayAvailable();
+}
+
+void AppTray::setEnabled(bool enabled)
+{
+    if (!enabled) {
+        if (m_trayIcon) {
+            m_trayIcon->hide();
+        }
+        return;
+    }
+
+    if (!QSystemTrayIcon::isSystemTrayAvailable()) {
+        qWarning() << "No system tray available - closing the window will quit";
+        return;
+    }
+
+    if (!m_trayIcon) {
+        m_menu = new QMenu();
+        connect(m_menu->addAction("Open LL-Connect 3"), &QAction::triggered, this, [this]() {
+            showWindow();
+        });
+        m_menu->addSeparator();
+        connect(m_menu->addAction("Quit"), &QAction::triggered, qApp, &QApplication::quit);
+
+        m_trayIcon = new QSystemTrayIcon(QIcon(":/icons/resources/logo.png"), this);
+        m_trayIcon->setToolTip("LL-Connect 3");
+        m_trayIcon->setContextMenu(m_menu);
+        connect(m_trayIcon, &QSystemTrayIcon::activated, this, &AppTray::onActivated);
+    }
+    m_trayIcon->show();
+}
+
+void AppTray::showWindow(bool minimized)
+{
+    TRACE_SCOPE("AppTray::showWindow");
+
+    if (!m_window) {
+        m_window = new MainWindow();
+        m_window->setAttribute(Qt::WA_DeleteOnClose);
+        connect(m_window, &QObject::destroyed, this, &AppTray::onWindowDestroyed);
+    }
+
+    if (minimized) {
+        m_window->showMinimized();
+        return;
+    }
+    m_window->setWindowState(m_window->windowState() & ~Qt::WindowMinimized);
+    m_window->show();
+    m_window->raise();
+    m_window->activateWindow();
+}
+
+void AppTray::onActivated(QSystemTrayIcon::ActivationReason reason)
+{
+    if (reason == QSystemTrayIcon::Trigger || reason == QSystemTrayIcon::DoubleClick) {
+        showWindow();
+    }
+}
+
+void AppTray::onWindowDestroyed()
+{
+    if (!m_trayIcon || !m_trayIcon->isVisible()) {
+        qApp->quit();
+        return;
+    }
+
+    // The pages are gone; drop their cached pixmaps and hand the freed heap back
+    // so the resident set shrinks to the service, the sensor hub and the tray
+    QPixmapCache::clear();
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    qDebug() << "Window closed - fan control keeps running in the tray";
+}
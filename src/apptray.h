@@ -0,0 +1,50 @@
+/*---------------------------------------------------------*\
+||| apptray.h                                               |
+|||                                                         |
+|||   System tray resident mode                            |
+|||   Owns the main window. With the tray enabled, closing |
+|||   the window destroys it and every page while fan      |
+|||   control keeps running in FanControlService; the tray |
+|||   icon builds a new window on demand.                  |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QSystemTrayIcon>
+
+class QMenu;
+class MainWindow;
+
+class AppTray : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AppTray(QObject *parent = nullptr);
+    ~AppTray();
+
+    // The one created in main(), null before and after
+    static AppTray *instance();
+
+    // Tray/Enabled setting; without a tray (or a system tray to put it in)
+    // closing the window quits
+    static bool trayEnabled();
+    void setEnabled(bool enabled);
+
+    // Build the window if it was closed, then show and raise it
+    void showWindow(bool minimized = false);
+
+private slots:
+    void onActivated(QSystemTrayIcon::ActivationReason reason);
+    void onWindowDestroyed();
+
+private:
+    QSystemTrayIcon *m_trayIcon;
+    QMenu *m_menu;
+    QPointer<MainWindow> m_window;
+};
@@ -0,0 +1,201 @@
+/*---------------------------------------------------------*\
+||| acousticcontroller.cpp                                  |
+|||                                                         |
+|||   Acoustic-budget fan control                          |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "acousticcontroller.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+double soundPower(double dba) {
+    return dba > 0.0 ? std::pow(10.0, dba / 10.0) : 0.0;
+}
+
+} // namespace
+
+AcousticController::AcousticController(const AcousticParams& params, const ThermalEstimatorParams& thermal)
+    : m_params(params)
+    , m_estimator(thermal)
+{
+    for (int i = 0; i < PORT_COUNT; ++i) {
+        m_weights[i] = 1.0;
+        m_enabled[i] = true;
+    }
+    reset();
+}
+
+void AcousticController::reset() {
+    m_estimator.reset();
+    m_integral = 0.0;
+    m_required = 0.0;
+    m_predictedDBA = 0.0;
+    m_predictedWeighted = 0.0;
+    m_airflow = 0.0;
+    std::fill(m_level, m_level + PORT_COUNT, 0.0);
+    std::fill(m_rpmOut, m_rpmOut + PORT_COUNT, 0);
+}
+
+void AcousticController::setPortModel(int port, const FanModel& model) {
+    if (port >= 1 && port <= PORT_COUNT) m_models[port - 1] = model;
+}
+
+void AcousticController::setPortWeight(int port, double weight) {
+    if (port >= 1 && port <= PORT_COUNT) m_weights[port - 1] = std::max(0.0, weight);
+}
+
+void AcousticController::setPortEnabled(int port, bool enabled) {
+    if (port >= 1 && port <= PORT_COUNT) m_enabled[port - 1] = enabled;
+}
+
+int AcousticController::lastRPM(int port) const {
+    if (port < 1 || port > PORT_COUNT) return 0;
+    return m_rpmOut[port - 1];
+}
+
+double AcousticController::portAirflow(int index, int rpm) const {
+    int maxRPM = m_models[index].maxRPM();
+    if (maxRPM <= 0 || rpm <= 0) return 0.0;
+    return std::pow(std::min(1.0, double(rpm) / maxRPM), m_params.airflowExponent);
+}
+
+// Greedy marginal-cost allocation: every port starts at its slowest running speed, then the
+// port that buys the most airflow per unit of weighted sound power is raised one duty step
+// at a time until the mean airflow covers the requirement. Noise grows convexly with speed,
+// so this lands on (or within one step of) the cheapest combination.
+void AcousticController::optimize(double required, int rpm[PORT_COUNT]) {
+    int duty[PORT_COUNT];
+    int enabledCount = 0;
+    double airflow = 0.0;
+
+    for (int i = 0; i < PORT_COUNT; ++i) {
+        if (!m_enabled[i]) {
+            duty[i] = 0;
+            rpm[i] = 0;
+            continue;
+        }
+        ++enabledCount;
+        duty[i] = m_models[i].rpmToPercent(m_models[i].minRunningRPM());
+        rpm[i] = m_models[i].percentToRPM(duty[i]);
+        if (rpm[i] < m_models[i].minRunningRPM()) {
+            duty[i] = std::min(100, duty[i] + 1);
+            rpm[i] = m_models[i].percentToRPM(duty[i]);
+        }
+        airflow += portAirflow(i, rpm[i]);
+    }
+    if (enabledCount == 0) return;
+
+    double target = std::min(1.0, required) * enabledCount;
+    while (airflow < target) {
+        int best = -1;
+        double bestCost = 0.0;
+        int bestDuty = 0, bestRPM = 0;
+        double bestGain = 0.0;
+
+        for (int i = 0; i < PORT_COUNT; ++i) {
+            if (!m_enabled[i] || duty[i] >= 100) continue;
+            int nextDuty = std::min(100, duty[i] + m_params.dutyStep);
+            int nextRPM = m_models[i].percentToRPM(nextDuty);
+            double gain = portAirflow(i, nextRPM) - portAirflow(i, rpm[i]);
+            if (gain <= 0.0) continue;
+            double cost = m_weights[i] * (soundPower(m_models[i].estimateDBA(nextRPM))
+                                          - soundPower(m_models[i].estimateDBA(rpm[i])));
+            double ratio = cost / gain;
+            if (best < 0 || ratio < bestCost) {
+                best = i;
+                bestCost = ratio;
+                bestDuty = nextDuty;
+                bestRPM = nextRPM;
+                bestGain = gain;
+            }
+        }
+        if (best < 0) break;    // Everything at full speed
+
+        duty[best] = bestDuty;
+        rpm[best] = bestRPM;
+        airflow += bestGain;
+    }
+}
+
+void AcousticController::step(double temperature, double dt, FanControlOutput out[PORT_COUNT]) {
+    if (dt <= 0) dt = 0.1;
+
+    // No previous output to slew from on the first step after a reset
+    const bool first = !m_estimator.primed();
+    m_estimator.update(temperature, m_airflow, dt);
+
+    const double aim = m_params.maxTemperature - m_params.margin;
+    const double tf = m_estimator.filteredTemperature();
+    const double error = tf - aim;
+
+    // Airflow that makes the model close in on the aim point with the approach time
+    // constant: dT/dt = (aim − T) / τ. Far below the aim this asks for nothing and the
+    // heatsink's thermal mass soaks up the load; at the aim it equals the steady-state need.
+    double required = 2.0;
+    double rise = tf - m_estimator.ambient();
+    if (rise > 0.1) {
+        double cooling = m_estimator.load() - (aim - tf) / m_params.approachSeconds;
+        required = (cooling / rise - m_estimator.g0()) / m_estimator.g1();
+    }
+
+    // Integral trim for whatever the model gets wrong, only once close to the aim
+    if (std::fabs(error) < m_params.trimBand) {
+        m_integral = std::clamp(m_integral + m_params.ki * error * dt, m_params.integralMin, m_params.integralMax);
+    }
+    required += m_integral;
+    if (tf >= m_params.maxTemperature) {
+        required = 1.0;     // Ceiling breached: everything to full until it recovers
+    }
+    m_required = std::clamp(required, 0.0, 1.0);
+
+    int wanted[PORT_COUNT];
+    optimize(m_required, wanted);
+
+    double levels[PORT_COUNT];
+    double weighted = 0.0;
+    double airflow = 0.0;
+    int enabledCount = 0;
+
+    for (int i = 0; i < PORT_COUNT; ++i) {
+        if (first) {
+            m_level[i] = wanted[i];
+        } else if (wanted[i] > m_level[i]) {
+            m_level[i] = std::min<double>(wanted[i], m_level[i] + m_params.upSlew * dt);
+        } else {
+            m_level[i] = std::max<double>(wanted[i], m_level[i] - m_params.downSlew * dt);
+        }
+
+        // Small moves accumulate in m_level until they are worth a write; reaching the
+        // wanted speed (or starting from stopped) always goes out
+        int gated = int(std::lround(m_level[i]));
+        int current = m_rpmOut[i];
+        bool write = gated != current
+                     && (std::abs(gated - current) >= m_params.writeThreshold
+                         || gated == wanted[i] || current == 0);
+        if (write) {
+            m_rpmOut[i] = gated;
+        }
+
+        out[i].rpm = m_rpmOut[i];
+        out[i].base = wanted[i];
+        out[i].target = wanted[i];
+        out[i].write = write;
+
+        levels[i] = m_enabled[i] ? m_models[i].estimateDBA(m_rpmOut[i]) : 0.0;
+        weighted += m_weights[i] * soundPower(levels[i]);
+        if (m_enabled[i]) {
+            airflow += portAirflow(i, m_rpmOut[i]);
+            ++enabledCount;
+        }
+    }
+
+    m_airflow = enabledCount > 0 ? airflow / enabledCount : 0.0;
+    m_predictedDBA = FanModel::combineDBA(levels, PORT_COUNT);
+    m_predictedWeighted = weighted > 0.0 ? 10.0 * std::log10(weighted) : 0.0;
+}
@@ -0,0 +1,80 @@
+/*---------------------------------------------------------*\
+||| acousticcontroller.h                                    |
+|||                                                         |
+|||   Acoustic-budget fan control                          |
+|||   Works out how much airflow the current load needs   |
+|||   to stay under a temperature ceiling (online thermal |
+|||   model plus an integral trim), then spreads it       |
+|||   over the ports so the weighted total dBA is lowest. |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "fancontroller.h"
+#include "fanmodel.h"
+#include "thermalestimator.h"
+
+struct AcousticParams {
+    double maxTemperature   = 75.0;     // °C ceiling to hold
+    double margin           = 2.0;      // °C below the ceiling the optimizer aims for
+    double approachSeconds  = 20.0;     // Time constant for closing in on the aim point
+    double ki               = 0.002;    // Airflow per °C·s, corrects model error near the aim
+    double trimBand         = 4.0;      // °C around the aim point where the trim integrates
+    double integralMin      = -0.3;
+    double integralMax      = 0.5;
+    double airflowExponent  = 0.8;      // Airflow ∝ (rpm / maxRPM)^exponent
+    int    dutyStep         = 2;        // % granularity of the search
+    double upSlew           = 1500.0;   // RPM/s
+    double downSlew         = 150.0;    // RPM/s, slow ramp-down keeps it unobtrusive
+    int    writeThreshold   = 10;       // RPM
+};
+
+class AcousticController {
+public:
+    static constexpr int PORT_COUNT = FanController::PORT_COUNT;
+
+    explicit AcousticController(const AcousticParams& params = AcousticParams(),
+                                const ThermalEstimatorParams& thermal = ThermalEstimatorParams());
+
+    const AcousticParams& params() const { return m_params; }
+    void setParams(const AcousticParams& params) { m_params = params; }
+
+    // Per-port fan model, noise weight (0 = ignore its noise, 2 = twice as objectionable)
+    // and whether anything is plugged in
+    void setPortModel(int port, const FanModel& model);
+    void setPortWeight(int port, double weight);
+    void setPortEnabled(int port, bool enabled);
+
+    // Advance by dt seconds. Fills one output per port (index 0 = port 1).
+    void step(double temperature, double dt, FanControlOutput out[PORT_COUNT]);
+
+    void reset();
+
+    const ThermalEstimator& estimator() const { return m_estimator; }
+    double requiredAirflow() const { return m_required; }
+    double predictedDBA() const { return m_predictedDBA; }          // Unweighted, all ports
+    double predictedWeightedDBA() const { return m_predictedWeighted; }
+    int lastRPM(int port) const;
+
+private:
+    double portAirflow(int index, int rpm) const;
+    void optimize(double required, int rpm[PORT_COUNT]);
+
+    AcousticParams m_params;
+    ThermalEstimator m_estimator;
+
+    FanModel m_models[PORT_COUNT];
+    double m_weights[PORT_COUNT];
+    bool m_enabled[PORT_COUNT];
+
+    double m_integral;
+    double m_required;
+    double m_predictedDBA;
+    double m_predictedWeighted;
+    double m_level[PORT_COUNT];     // Slew-limited speed, accumulates below the write threshold
+    int m_rpmOut[PORT_COUNT];       // Last speed handed out with write set
+    double m_airflow;
+};
@@ -0,0 +1,140 @@
+/*---------------------------------------------------------*\
+||| fancontroller.cpp                                       |
+|||                                                         |
+|||   Temperature-driven fan speed controller              |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "fancontroller.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+FanController::FanController(const FanControllerParams& params)
+    : m_params(params)
+{
+    std::fill(m_portMaxRPM, m_portMaxRPM + PORT_COUNT, 0);
+    reset();
+}
+
+void FanController::setPortMaxRPM(int port, int maxRPM) {
+    if (port >= 1 && port <= PORT_COUNT) {
+        m_portMaxRPM[port - 1] = std::max(0, maxRPM);
+    }
+}
+
+void FanController::reset() {
+    m_primed = false;
+    m_filtered = 0.0;
+    m_rate = 0.0;
+    m_heating = false;
+    m_history.clear();
+    m_loadInput = NAN;
+    m_loadPrimed = false;
+    m_loadFast = 0.0;
+    m_loadSlow = 0.0;
+    m_loadFF = 0;
+    std::fill(m_rpmOut, m_rpmOut + PORT_COUNT, 0);
+}
+
+int FanController::lastRPM(int port) const {
+    if (port < 1 || port > PORT_COUNT) {
+        return 0;
+    }
+    return m_rpmOut[port - 1];
+}
+
+void FanController::setLoad(double utilization, double packageWatts) {
+    if (std::isfinite(packageWatts)) {
+        m_loadInput = std::max(0.0, packageWatts);
+    } else if (std::isfinite(utilization)) {
+        m_loadInput = std::clamp(utilization, 0.0, 1.0) * m_params.utilizationWatts;
+    } else {
+        m_loadInput = NAN;
+    }
+}
+
+void FanController::step(double temperature, double dt, FanControlOutput out[PORT_COUNT]) {
+    if (dt <= 0) dt = 0.1;
+
+    // 1) Very fast asymmetric filter - almost instant response when heating.
+    // Seed with the first reading so start-up does not look like a heat spike.
+    if (!m_primed) {
+        m_filtered = temperature;
+        m_primed = true;
+    }
+    double alpha = (temperature >= m_filtered) ? m_params.alphaHeating : m_params.alphaCooling;
+    m_filtered += alpha * (temperature - m_filtered);
+
+    // Keep short history for derivative
+    int histMax = std::max(2, int(std::round(m_params.historySeconds / dt)));
+    m_history.push_back(m_filtered);
+    while ((int)m_history.size() > histMax) m_history.pop_front();
+
+    // 2) Calculate temperature rate of change (only heating matters)
+    m_rate = 0.0;
+    if (m_history.size() >= 2) {
+        m_rate = (m_history.back() - m_history.front()) / std::max(0.1, dt * (m_history.size() - 1));
+    }
+    m_rate = std::clamp(m_rate, 0.0, m_params.maxRate);
+    m_heating = (m_rate > m_params.heatingRate);
+
+    // 3) Load feedforward: a render or compile job shows up in package power (or
+    // utilization) immediately, seconds before the die temperature moves. The part of
+    // the load above its slow average is heat still on its way to the sensor.
+    m_loadFF = 0;
+    if (std::isfinite(m_loadInput)) {
+        if (!m_loadPrimed) {
+            m_loadFast = m_loadSlow = m_loadInput;
+            m_loadPrimed = true;
+        }
+        m_loadFast += (1.0 - std::exp(-dt / m_params.loadFastSeconds)) * (m_loadInput - m_loadFast);
+        m_loadSlow += (1.0 - std::exp(-dt / m_params.loadSlowSeconds)) * (m_loadInput - m_loadSlow);
+        double excess = m_loadFast - m_loadSlow - m_params.loadDeadband;
+        if (excess > 0) {
+            m_loadFF = std::min(m_params.loadMaxRPM, int(std::round(excess * m_params.loadGain)));
+        }
+    }
+
+    const bool hot = m_filtered > m_params.hotThreshold;
+    const double upSlew = hot ? m_params.hotUpSlew : m_params.upSlew;
+    const double downSlew = hot ? m_params.hotDownSlew : m_params.downSlew;
+    const int maxStepUp = std::max(1, int(std::round(upSlew * dt)));
+    const int maxStepDown = std::max(1, int(std::round(downSlew * dt)));
+
+    // 4) Control each port individually using its own curve
+    for (int i = 0; i < PORT_COUNT; ++i) {
+        int port = i + 1;
+        int baseNow = m_curve ? m_curve(port, int(std::round(m_filtered))) : 0;
+        int basePred = m_curve ? m_curve(port, int(std::round(m_filtered + m_rate * m_params.lookAheadSeconds))) : 0;
+        int base = m_heating ? std::max(baseNow, basePred) : baseNow;
+
+        // Feedforward proportional to heating rate, plus a boost when heating rapidly
+        int ff = m_heating ? int(std::round(m_rate * m_params.feedForwardGain)) : 0;
+        int boost = (m_heating && m_rate > m_params.boostRate) ? m_params.boostRPM : 0;
+
+        int maxRPM = m_portMaxRPM[i] > 0 ? m_portMaxRPM[i] : m_params.maxRPM;
+        int target = std::clamp(base + ff + boost + m_loadFF, 0, maxRPM);
+
+        // Slew limiting
+        int current = m_rpmOut[i];
+        int gated = current;
+        if (target > current) {
+            gated = std::min(target, current + maxStepUp);
+        } else if (target < current) {
+            gated = std::max(target, current - maxStepDown);
+        }
+
+        bool write = std::abs(gated - current) >= m_params.writeThreshold || current == 0;
+        if (write) {
+            m_rpmOut[i] = gated;
+        }
+
+        out[i].rpm = m_rpmOut[i];
+        out[i].base = base;
+        out[i].target = target;
+        out[i].write = write;
+    }
+}
@@ -0,0 +1,104 @@
+/*---------------------------------------------------------*\
+||| fancontroller.h                                         |
+|||                                                         |
+|||   Temperature-driven fan speed controller              |
+|||   Filtered temperature, look-ahead on heating, load    |
+|||   feedforward, slew limiting and a write threshold    |
+|||   per port. Time is passed in explicitly so it can run |
+|||   faster than real time in the offline simulator.      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cmath>
+#include <deque>
+#include <functional>
+
+struct FanControllerParams {
+    double alphaHeating     = 0.95;    // Filter gain when temperature rises
+    double alphaCooling     = 0.60;    // Filter gain when temperature falls
+    double historySeconds   = 0.3;     // Window for the rate estimate
+    double maxRate          = 10.0;    // °C/s clamp on the rate estimate
+    double heatingRate      = 0.02;    // °C/s above which we treat the system as heating
+    double lookAheadSeconds = 10.0;    // Curve is also evaluated at T + rate × lookAhead
+    double feedForwardGain  = 800.0;   // RPM per °C/s while heating
+    double boostRate        = 0.3;     // °C/s above which boostRPM is added
+    int    boostRPM         = 400;
+    double loadFastSeconds  = 1.0;     // Smoothing of the load signal (package W)
+    double loadSlowSeconds  = 40.0;    // ~heatsink time constant: load above this average
+                                       // has not reached the temperature sensor yet
+    double loadGain         = 15.0;    // RPM per W of load not yet seen by the sensor
+    double loadDeadband     = 5.0;     // W, ignores background jitter
+    int    loadMaxRPM       = 900;     // Cap on the load feedforward
+    double utilizationWatts = 100.0;   // W counted for 100% CPU when package power is unreadable
+    double upSlew           = 1500.0;  // RPM/s
+    double downSlew         = 200.0;   // RPM/s
+    double hotThreshold     = 65.0;    // °C above which the hot slew rates apply
+    double hotUpSlew        = 2000.0;
+    double hotDownSlew      = 300.0;
+    int    writeThreshold   = 10;      // Minimum RPM change before a new target is written
+    int    maxRPM           = 2100;
+};
+
+struct FanControlOutput {
+    int  rpm;    // Slew-limited target
+    int  base;   // Curve value before feedforward
+    int  target; // Curve + temperature and load feedforward, before slew limiting
+    bool write;  // True when rpm should be sent to the fan
+};
+
+class FanController {
+public:
+    static constexpr int PORT_COUNT = 4;
+
+    // Maps (port 1-4, temperature °C) to the curve RPM for that port
+    using CurveFunction = std::function<int(int port, int temperature)>;
+
+    explicit FanController(const FanControllerParams& params = FanControllerParams());
+
+    void setCurveFunction(CurveFunction curve) { m_curve = std::move(curve); }
+
+    // Full-speed RPM of the fan on a port (from its FanModel); 0 = params().maxRPM
+    void setPortMaxRPM(int port, int maxRPM);
+
+    const FanControllerParams& params() const { return m_params; }
+    void setParams(const FanControllerParams& params) { m_params = params; }
+
+    // Latest load reading, used by the following steps. Package power is preferred;
+    // utilization (0-1) stands in when it is NaN. Both NaN disables the load term.
+    void setLoad(double utilization, double packageWatts);
+
+    // Advance the controller by dt seconds with a new temperature reading.
+    // Fills one output per port (index 0 = port 1).
+    void step(double temperature, double dt, FanControlOutput out[PORT_COUNT]);
+
+    // Forget filter state and last outputs
+    void reset();
+
+    double filteredTemperature() const { return m_filtered; }
+    double rate() const { return m_rate; }
+    bool heating() const { return m_heating; }
+    double loadWatts() const { return m_loadFast; }
+    int loadFeedForward() const { return m_loadFF; }
+    int lastRPM(int port) const;
+
+private:
+    FanControllerParams m_params;
+    CurveFunction m_curve;
+
+    bool m_primed;
+    double m_filtered;
+    double m_rate;
+    bool m_heating;
+    std::deque<double> m_history;
+    double m_loadInput;
+    bool m_loadPrimed;
+    double m_loadFast;
+    double m_loadSlow;
+    int m_loadFF;
+    int m_rpmOut[PORT_COUNT];
+    int m_portMaxRPM[PORT_COUNT];
+};
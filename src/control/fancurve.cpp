@@ -0,0 +1,54 @@
+/*---------------------------------------------------------*\
+||| fancurve.cpp                                            |
+|||                                                         |
+|||   Temperature -> RPM curves and built-in profiles      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "fancurve.h"
+#include <algorithm>
+
+namespace FanCurves {
+
+FanCurve builtin(const std::string& profile) {
+    if (profile == "Standard") {
+        return { {0, 120}, {25, 420}, {40, 1050}, {55, 1260}, {70, 1680}, {90, 2100}, {100, 2100} };
+    }
+    if (profile == "High Speed") {
+        return { {0, 120}, {25, 910}, {35, 1140}, {50, 1470}, {70, 1800}, {85, 2100}, {100, 2100} };
+    }
+    if (profile == "Full Speed") {
+        return { {0, 120}, {25, 2100}, {40, 2100}, {55, 2100}, {70, 2100}, {90, 2100}, {100, 2100} };
+    }
+    // Quiet (original Lian Li curve) and default
+    return { {0, 120}, {25, 420}, {45, 840}, {65, 1050}, {80, 1680}, {90, 2100}, {100, 2100} };
+}
+
+int evaluate(const FanCurve& curve, int temperature) {
+    if (curve.size() < 2) {
+        return 0;
+    }
+
+    temperature = std::clamp(temperature, 0, 100);
+
+    for (size_t i = 0; i + 1 < curve.size(); ++i) {
+        const FanCurvePoint& a = curve[i];
+        const FanCurvePoint& b = curve[i + 1];
+        if (temperature >= a.temperature && temperature <= b.temperature) {
+            if (b.temperature == a.temperature) {
+                return static_cast<int>(b.rpm);
+            }
+            double t = (temperature - a.temperature) / (b.temperature - a.temperature);
+            return static_cast<int>(a.rpm + t * (b.rpm - a.rpm));
+        }
+    }
+
+    if (temperature < curve.front().temperature) {
+        return static_cast<int>(curve.front().rpm);
+    }
+    return static_cast<int>(curve.back().rpm);
+}
+
+} // namespace FanCurves
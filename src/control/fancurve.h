@@ -0,0 +1,32 @@
+/*---------------------------------------------------------*\
+||| fancurve.h                                              |
+|||                                                         |
+|||   Temperature -> RPM curves and built-in profiles      |
+|||   Plain C++ so the offline tools can share them        |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct FanCurvePoint {
+    double temperature;  // °C
+    double rpm;
+};
+
+using FanCurve = std::vector<FanCurvePoint>;
+
+namespace FanCurves {
+
+// Built-in profile curve by internal name ("Quiet", "Standard", "High Speed", "Full Speed").
+// Unknown names fall back to Quiet.
+FanCurve builtin(const std::string& profile);
+
+// Linear interpolation, temperature clamped to 0-100°C and to the curve ends
+int evaluate(const FanCurve& curve, int temperature);
+
+} // namespace FanCurves
@@ -0,0 +1,206 @@
+/*---------------------------------------------------------*\
+||| fanmodel.cpp                                            |
+|||                                                         |
+|||   Per-fan duty -> RPM -> dBA response model            |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "fanmodel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Minimum running speed of the stock model as a fraction of full speed (840 / 2100)
+constexpr double STOCK_MIN_RUNNING = 0.4;
+
+// Below this a calibrated fan is considered stalled
+constexpr double STALL_RPM = 50.0;
+
+// A sweep whose full speed comes out below this fraction of the fallback's is a failed
+// tach read, not a slow fan; using it would clamp every target to (nearly) zero
+constexpr double MIN_PLAUSIBLE_MAX = 0.25;
+
+double interpolate(const std::vector<std::pair<int, double>>& table, double x) {
+    if (table.empty()) return 0.0;
+    if (x <= table.front().first) return table.front().second;
+    for (size_t i = 1; i < table.size(); ++i) {
+        const auto& lo = table[i - 1];
+        const auto& hi = table[i];
+        if (x <= hi.first) {
+            if (hi.first == lo.first) return hi.second;
+            return lo.second + (x - lo.first) * (hi.second - lo.second) / (hi.first - lo.first);
+        }
+    }
+    return table.back().second;
+}
+
+} // namespace
+
+FanModel::FanModel()
+    : m_maxRPM(2100)
+    , m_minRunningRPM(840)
+    , m_idleRPM(120)
+    , m_rpmTable{ {0, 0.0}, {100, 2100.0} }
+    // Measured: 840 RPM = 34 dBA, 1040 = 39, 1260 = 45, 1480 = 49, 1680 = 52, 1880 = 56, 2100 = 60
+    , m_dbaTable{ {0, 0.0}, {840, 34.0}, {1040, 39.0}, {1260, 45.0},
+                  {1480, 49.0}, {1680, 52.0}, {1880, 56.0}, {2100, 60.0} }
+{
+}
+
+FanModel FanModel::stock(int maxRPM) {
+    FanModel model;
+    if (maxRPM <= 0 || maxRPM == model.m_maxRPM) {
+        return model;
+    }
+
+    // Same duty -> noise relation as the 120mm table, stretched to the new speed range
+    double scale = double(maxRPM) / model.m_maxRPM;
+    for (auto& point : model.m_dbaTable) {
+        point.first = int(std::lround(point.first * scale));
+    }
+    model.m_maxRPM = maxRPM;
+    model.m_minRunningRPM = int(std::lround(maxRPM * STOCK_MIN_RUNNING));
+    model.m_rpmTable = { {0, 0.0}, {100, double(maxRPM)} };
+    return model;
+}
+
+FanModel FanModel::fit(const std::vector<FanCalibrationSample>& samples, const FanModel& fallback) {
+    std::vector<FanCalibrationSample> sorted;
+    bool turned = false;
+    for (const FanCalibrationSample& s : samples) {
+        if (s.duty >= 0 && s.duty <= 100 && !std::isnan(s.rpm) && s.rpm >= 0.0) {
+            sorted.push_back(s);
+            turned = turned || s.rpm >= STALL_RPM;
+        }
+    }
+    if (sorted.size() < 2 || !turned) {
+        return fallback;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const FanCalibrationSample& a, const FanCalibrationSample& b) { return a.duty < b.duty; });
+
+    FanModel model = fallback;
+    model.m_samples = samples;
+    model.m_rpmTable.clear();
+
+    // Average repeated duties, then force the curve to be non-decreasing so it can be inverted
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        double sum = 0.0;
+        while (j < sorted.size() && sorted[j].duty == sorted[i].duty) {
+            sum += sorted[j].rpm;
+            ++j;
+        }
+        double rpm = sum / (j - i);
+        if (!model.m_rpmTable.empty()) {
+            rpm = std::max(rpm, model.m_rpmTable.back().second);
+        }
+        model.m_rpmTable.emplace_back(sorted[i].duty, rpm);
+        i = j;
+    }
+    if (model.m_rpmTable.front().first > 0) {
+        model.m_rpmTable.insert(model.m_rpmTable.begin(), { 0, 0.0 });
+    }
+    if (model.m_rpmTable.back().first < 100) {
+        // Extend to 100% with the slope of the last segment
+        const auto& lo = model.m_rpmTable[model.m_rpmTable.size() - 2];
+        const auto& hi = model.m_rpmTable.back();
+        double slope = (hi.second - lo.second) / std::max(1, hi.first - lo.first);
+        model.m_rpmTable.emplace_back(100, hi.second + slope * (100 - hi.first));
+    }
+
+    model.m_maxRPM = int(std::lround(model.m_rpmTable.back().second));
+    if (model.m_maxRPM < fallback.m_maxRPM * MIN_PLAUSIBLE_MAX) {
+        return fallback;
+    }
+
+    // Slowest measured speed at which the fan still turned
+    model.m_minRunningRPM = model.m_maxRPM;
+    for (const auto& point : model.m_rpmTable) {
+        if (point.second >= STALL_RPM) {
+            model.m_minRunningRPM = int(std::lround(point.second));
+            break;
+        }
+    }
+    model.m_idleRPM = std::min(fallback.m_idleRPM, model.m_minRunningRPM);
+
+    // Noise table from measured points, otherwise the fallback scaled to the measured range
+    std::vector<std::pair<int, double>> dba;
+    for (const FanCalibrationSample& s : sorted) {
+        if (!std::isnan(s.dba) && s.dba > 0.0) {
+            dba.emplace_back(int(std::lround(model.percentToRPM(s.duty))), s.dba);
+        }
+    }
+    if (dba.size() >= 2) {
+        std::sort(dba.begin(), dba.end());
+        dba.insert(dba.begin(), { 0, 0.0 });
+        model.m_dbaTable = dba;
+    } else if (fallback.m_maxRPM > 0) {
+        double scale = double(model.m_maxRPM) / fallback.m_maxRPM;
+        for (auto& point : model.m_dbaTable) {
+            point.first = int(std::lround(point.first * scale));
+        }
+    }
+
+    return model;
+}
+
+int FanModel::clampTarget(int rpm) const {
+    // Minimum operating speed to prevent fan shutdown (idle speed is allowed)
+    if (rpm > m_idleRPM && rpm < m_minRunningRPM) {
+        rpm = m_minRunningRPM;
+    }
+    return std::clamp(rpm, 0, m_maxRPM);
+}
+
+int FanModel::rpmToPercent(int rpm) const {
+    if (rpm <= 0) return 0;
+    if (rpm >= m_maxRPM) return 100;
+
+    // Invert the (monotone) duty -> RPM table and round down so the fan never overshoots
+    for (size_t i = 1; i < m_rpmTable.size(); ++i) {
+        const auto& lo = m_rpmTable[i - 1];
+        const auto& hi = m_rpmTable[i];
+        if (rpm <= hi.second) {
+            if (hi.second <= lo.second) {
+                return hi.first;
+            }
+            double duty = lo.first + (rpm - lo.second) * (hi.first - lo.first) / (hi.second - lo.second);
+            return std::clamp(int(std::floor(duty + 1e-9)), 0, 100);
+        }
+    }
+    return 100;
+}
+
+int FanModel::percentToRPM(int percent) const {
+    if (percent <= 0) return 0;
+    if (percent >= 100) return m_maxRPM;
+    return int(std::lround(interpolate(m_rpmTable, percent)));
+}
+
+double FanModel::estimateDBA(int rpm) const {
+    if (m_dbaTable.size() < 2) {
+        return 0.0;
+    }
+    if (rpm <= m_dbaTable.back().first) {
+        return interpolate(m_dbaTable, rpm);
+    }
+    // Extrapolate past the last point with the final slope
+    const auto& lo = m_dbaTable[m_dbaTable.size() - 2];
+    const auto& hi = m_dbaTable.back();
+    if (hi.first == lo.first) return hi.second;
+    return hi.second + (rpm - hi.first) * (hi.second - lo.second) / (hi.first - lo.first);
+}
+
+double FanModel::combineDBA(const double* levels, int count) {
+    double power = 0.0;
+    for (int i = 0; i < count; ++i) {
+        if (levels[i] > 0.0) {
+            power += std::pow(10.0, levels[i] / 10.0);
+        }
+    }
+    return power > 0.0 ? 10.0 * std::log10(power) : 0.0;
+}
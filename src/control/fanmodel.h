@@ -0,0 +1,66 @@
+/*---------------------------------------------------------*\
+||| fanmodel.h                                              |
+|||                                                         |
+|||   Per-fan duty -> RPM -> dBA response model            |
+|||   Stock models reproduce the SL Infinity datasheet     |
+|||   numbers; calibrated models are fitted from a duty    |
+|||   sweep of the actual fan                              |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+// One step of a calibration sweep. rpm / dba are NaN when not measured.
+struct FanCalibrationSample {
+    int duty;       // 0-100 %
+    double rpm;
+    double dba;
+};
+
+class FanModel {
+public:
+    // Stock 120mm calibration: RPM = percent × 21, 2100 RPM max, 840 RPM minimum running speed
+    FanModel();
+
+    // Linear stock model for a fan with the given full-speed RPM (2100 = 120mm, 1600 = 140mm)
+    static FanModel stock(int maxRPM);
+
+    // Fit a model to a calibration sweep. Samples without an RPM reading are ignored for the
+    // speed curve; if fewer than two dBA readings exist the fallback's noise table is kept
+    // (scaled to the measured speed range). Returns the fallback if nothing usable was measured:
+    // fewer than two readings, the fan never turned, or an implausibly low full speed.
+    static FanModel fit(const std::vector<FanCalibrationSample>& samples, const FanModel& fallback);
+
+    bool isCalibrated() const { return !m_samples.empty(); }
+    const std::vector<FanCalibrationSample>& samples() const { return m_samples; }
+
+    int maxRPM() const { return m_maxRPM; }
+    int minRunningRPM() const { return m_minRunningRPM; }
+    int idleRPM() const { return m_idleRPM; }
+
+    // Apply the minimum running speed (targets above idle are raised to it) and clamp to max
+    int clampTarget(int rpm) const;
+
+    // Highest duty whose predicted speed does not exceed rpm
+    int rpmToPercent(int rpm) const;
+    int percentToRPM(int percent) const;
+
+    // Expected noise level at the given speed, linear between calibration points
+    double estimateDBA(int rpm) const;
+
+    // Sum of several incoherent sources in dB
+    static double combineDBA(const double* levels, int count);
+
+private:
+    int m_maxRPM;
+    int m_minRunningRPM;
+    int m_idleRPM;
+    std::vector<std::pair<int, double>> m_rpmTable;   // (duty %, RPM), duty ascending, RPM non-decreasing
+    std::vector<std::pair<int, double>> m_dbaTable;   // (RPM, dBA), ascending
+    std::vector<FanCalibrationSample> m_samples;      // Source data for calibrated models
+};
@@ -0,0 +1,68 @@
+/*---------------------------------------------------------*\
+||| thermalestimator.cpp                                    |
+|||                                                         |
+|||   Online single-node thermal model                     |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "thermalestimator.h"
+#include <algorithm>
+#include <cmath>
+
+ThermalEstimator::ThermalEstimator(const ThermalEstimatorParams& params)
+    : m_params(params)
+{
+    reset();
+}
+
+void ThermalEstimator::reset() {
+    m_primed = false;
+    m_filtered = m_params.ambient;
+    m_slope = 0.0;
+    m_load = 0.0;
+    m_sinceUpdate = 0.0;
+    m_airflowAccum = 0.0;
+    m_clock = 0.0;
+    m_history.clear();
+}
+
+void ThermalEstimator::update(double temperature, double airflow, double dt) {
+    if (dt <= 0) return;
+    airflow = std::clamp(airflow, 0.0, 1.0);
+    m_clock += dt;
+
+    if (!m_primed) {
+        m_filtered = temperature;
+        m_primed = true;
+    }
+    m_filtered += (1.0 - std::exp(-dt / m_params.filterSeconds)) * (temperature - m_filtered);
+
+    m_history.emplace_back(m_clock, m_filtered);
+    while (m_history.size() > 2 && m_clock - m_history.front().first > m_params.slopeWindow) {
+        m_history.pop_front();
+    }
+    if (m_history.size() >= 2) {
+        double span = m_history.back().first - m_history.front().first;
+        if (span > 0) {
+            m_slope = (m_history.back().second - m_history.front().second) / span;
+        }
+    }
+
+    m_sinceUpdate += dt;
+    m_airflowAccum += airflow * dt;
+    if (m_sinceUpdate < m_params.updatePeriod) {
+        return;
+    }
+
+    // Load that explains the slope at the interval's mean airflow
+    double a = m_airflowAccum / m_sinceUpdate;
+    double rise = m_filtered - m_params.ambient;
+    double instant = m_slope + (g0() + g1() * a) * rise;
+    double k = 1.0 - std::exp(-m_sinceUpdate / m_params.loadSeconds);
+    m_load += k * (std::max(0.0, instant) - m_load);
+
+    m_sinceUpdate = 0.0;
+    m_airflowAccum = 0.0;
+}
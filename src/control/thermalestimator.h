@@ -0,0 +1,56 @@
+/*---------------------------------------------------------*\
+||| thermalestimator.h                                      |
+|||                                                         |
+|||   Online single-node thermal model                     |
+|||     dT/dt = p − (g0 + g1·a) · (T − Tambient)           |
+|||   p is the heat load (K/s), a the normalised airflow  |
+|||   (0-1). p is tracked online from the measured slope; |
+|||   g0/g1 only set the shape of the airflow response.   |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <deque>
+
+struct ThermalEstimatorParams {
+    double ambient          = 25.0;     // °C
+    double filterSeconds    = 2.0;      // Temperature smoothing time constant
+    double slopeWindow      = 5.0;      // s, window for the dT/dt estimate
+    double updatePeriod     = 1.0;      // s between load updates
+    double loadSeconds      = 5.0;      // Smoothing of the derived load
+    double g0               = 0.4 / 60.0;   // 1/s, passive cooling
+    double g1               = 2.6 / 60.0;   // 1/s, cooling added at full airflow
+};
+
+class ThermalEstimator {
+public:
+    explicit ThermalEstimator(const ThermalEstimatorParams& params = ThermalEstimatorParams());
+
+    void reset();
+
+    // Feed a temperature reading taken with the given airflow (0-1) over the last dt seconds
+    void update(double temperature, double airflow, double dt);
+
+    bool primed() const { return m_primed; }
+    double filteredTemperature() const { return m_filtered; }
+    double slope() const { return m_slope; }      // °C/s
+    double load() const { return m_load; }        // K/s
+    double g0() const { return m_params.g0; }
+    double g1() const { return m_params.g1; }
+    double ambient() const { return m_params.ambient; }
+
+private:
+    ThermalEstimatorParams m_params;
+
+    bool m_primed;
+    double m_filtered;
+    double m_slope;
+    double m_load;
+    double m_sinceUpdate;
+    double m_airflowAccum;
+    double m_clock;
+    std::deque<std::pair<double, double>> m_history;   // (time, filtered temp)
+};
@@ -0,0 +1,107 @@
+/*---------------------------------------------------------*\
+||| zerorpm.cpp                                             |
+|||                                                         |
+|||   Semi-passive (zero RPM) stage of the fan pipeline    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "zerorpm.h"
+#include <algorithm>
+#include <cmath>
+
+ZeroRpmStage::ZeroRpmStage() {
+    for (PortState& port : m_ports) {
+        port.maxRPM = 2100;
+    }
+    reset();
+}
+
+void ZeroRpmStage::reset() {
+    for (PortState& port : m_ports) {
+        port.state = RUNNING;
+        port.timer = 0.0;
+    }
+}
+
+void ZeroRpmStage::setPortParams(int port, const ZeroRpmParams& params) {
+    if (port < 1 || port > PORT_COUNT) return;
+    PortState& state = m_ports[port - 1];
+    state.params = params;
+    // Without a gap between the thresholds the port would cycle on sensor noise
+    state.params.startTemperature = std::max(params.startTemperature, params.stopTemperature + 1.0);
+    if (!params.enabled) {
+        // Leaving the mode: the controller owns the port again from the next step
+        state.state = RUNNING;
+        state.timer = 0.0;
+    }
+}
+
+const ZeroRpmParams& ZeroRpmStage::portParams(int port) const {
+    return m_ports[std::clamp(port, 1, PORT_COUNT) - 1].params;
+}
+
+void ZeroRpmStage::setPortMaxRPM(int port, int maxRPM) {
+    if (port >= 1 && port <= PORT_COUNT && maxRPM > 0) {
+        m_ports[port - 1].maxRPM = maxRPM;
+    }
+}
+
+ZeroRpmStage::State ZeroRpmStage::state(int port) const {
+    if (port < 1 || port > PORT_COUNT) return RUNNING;
+    return m_ports[port - 1].state;
+}
+
+void ZeroRpmStage::apply(double temperature, double dt, FanControlOutput out[PORT_COUNT]) {
+    if (dt <= 0) dt = 0.1;
+
+    for (int i = 0; i < PORT_COUNT; ++i) {
+        PortState& port = m_ports[i];
+        const ZeroRpmParams& p = port.params;
+        FanControlOutput& output = out[i];
+
+        if (!p.enabled) {
+            continue;
+        }
+
+        switch (port.state) {
+        case RUNNING:
+            port.timer = temperature < p.stopTemperature ? port.timer + dt : 0.0;
+            if (port.timer >= p.stopHoldSeconds) {
+                port.state = STOPPED;
+                port.timer = 0.0;
+                output.rpm = 0;
+                output.write = true;
+            }
+            break;
+
+        case STOPPED:
+            port.timer = temperature > p.startTemperature ? port.timer + dt : 0.0;
+            if (port.timer >= p.startHoldSeconds) {
+                // Starting from rest needs more torque than the slowest running speed
+                port.state = KICKING;
+                port.timer = p.kickSeconds;
+                output.rpm = std::max(output.rpm, int(std::lround(port.maxRPM * p.kickFraction)));
+                output.write = true;
+            } else {
+                output.rpm = 0;
+                output.write = false;
+            }
+            break;
+
+        case KICKING:
+            port.timer -= dt;
+            if (port.timer <= 0.0) {
+                // Hand over to the controller's (slew-limited) speed
+                port.state = RUNNING;
+                port.timer = 0.0;
+                output.write = true;
+            } else {
+                output.rpm = std::max(output.rpm, int(std::lround(port.maxRPM * p.kickFraction)));
+                output.write = false;
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*---------------------------------------------------------*\
+||| zerorpm.h                                               |
+|||                                                         |
+|||   Semi-passive (zero RPM) stage of the fan pipeline    |
+|||   Sits after FanController / AcousticController: stops |
+|||   a port once it has been below the stop temperature  |
+|||   for the stop hold time, restarts it only above the  |
+|||   higher start temperature, and starts it from rest    |
+|||   with a short high-duty kick.                         |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "fancontroller.h"
+
+struct ZeroRpmParams {
+    bool   enabled          = false;
+    double stopTemperature  = 40.0;     // °C, stop once below this...
+    double stopHoldSeconds  = 60.0;     // ...for this long
+    double startTemperature = 50.0;     // °C, restart once above this...
+    double startHoldSeconds = 2.0;      // ...for this long (rides out single-sample spikes)
+    double kickFraction     = 0.7;      // Kick speed as a fraction of the port's full speed
+    double kickSeconds      = 1.5;      // Kick duration before the controller takes over
+};
+
+class ZeroRpmStage {
+public:
+    static constexpr int PORT_COUNT = FanController::PORT_COUNT;
+
+    enum State {
+        RUNNING,
+        STOPPED,
+        KICKING
+    };
+
+    ZeroRpmStage();
+
+    void setPortParams(int port, const ZeroRpmParams& params);
+    const ZeroRpmParams& portParams(int port) const;
+
+    // Full-speed RPM of the fan on a port, for the kick speed
+    void setPortMaxRPM(int port, int maxRPM);
+
+    // Rewrite the controller outputs in place for the current temperature.
+    // Ports with the mode disabled pass through untouched.
+    void apply(double temperature, double dt, FanControlOutput out[PORT_COUNT]);
+
+    void reset();
+
+    State state(int port) const;
+
+private:
+    struct PortState {
+        ZeroRpmParams params;
+        int maxRPM;
+        State state;
+        double timer;       // Time spent past the relevant threshold, or kick time left
+    };
+
+    PortState m_ports[PORT_COUNT];
+};
@@ -0,0 +1,767 @@
+/*---------------------------------------------------------*\
+||| fancontrolservice.cpp                                   |
+|||                                                         |
+|||   Fan control without a window                         |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "fancontrolservice.h"
+#include "control/fancurve.h"
+#include "utils/qtdebugutil.h"
+#include "utils/trace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSettings>
+#include <QThread>
+#include <QTimer>
+#include <cmath>
+
+FanControlService &FanControlService::instance()
+{
+    static FanControlService *service = new FanControlService();
+    return *service;
+}
+
+FanControlService::FanControlService(QObject *parent)
+    : QObject(parent)
+    , m_started(false)
+    , m_hidController(nullptr)
+    , m_temperature(39)
+    , m_temperatureCounter(0)
+    , m_utilization(NAN)
+    , m_packageWatts(NAN)
+    , m_sensorSubscription(0)
+    , m_calibratingPort(0)
+    , m_acousticEnabled(false)
+    , m_controlTimer(nullptr)
+    , m_fanRPMTimer(nullptr)
+{
+    // All ports start on the stock 120mm model (2100 RPM max) and the Quiet profile
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        m_fanModels[port] = FanModel::stock(2100);
+        m_portProfiles[port] = "Quiet";
+        m_port140mm[port] = false;
+        m_acousticWeights[port] = 1.0;
+    }
+
+    for (int i = 1; i <= 3; ++i) {
+        m_customProfileNames[i] = "Cust" + QString::number(i);
+        m_customProfileCurves[i] = defaultCurve("Quiet");
+    }
+
+    // Each port follows its own curve (custom or profile default)
+    m_fanController.setCurveFunction([this](int port, int temperature) {
+        return curveRPM(port, temperature);
+    });
+}
+
+void FanControlService::start()
+{
+    if (m_started) return;
+    m_started = true;
+    TRACE_SCOPE("FanControlService::start");
+
+    loadCustomCurves();
+    loadCustomProfiles();
+    loadPortProfiles();
+    loadFanCalibration();
+    loadAcousticSettings();
+    loadZeroRpmSettings();
+
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &FanControlService::stop);
+
+    // Control loop tick; FanController's filters and slew limits assume ~50 ms steps
+    m_controlTimer = new QTimer(this);
+    connect(m_controlTimer, &QTimer::timeout, this, &FanControlService::controlFanSpeeds);
+    m_controlTimer->start(50);
+
+    // Fan RPMs for the telemetry log
+    m_fanRPMTimer = new QTimer(this);
+    connect(m_fanRPMTimer, &QTimer::timeout, this, &FanControlService::updateFanRPMs);
+    m_fanRPMTimer->start(1000);
+
+    // Open the hub on a worker thread so startup never waits on USB; the loop
+    // skips the hardware until m_hidController is handed over
+    LianLiSLInfinityController *controller = new LianLiSLInfinityController();
+    QThread *discovery = QThread::create([controller]() {
+        Trace::setThreadName("FanControlService discovery");
+        TRACE_SCOPE("LianLiSLInfinityController::Initialize");
+        controller->Initialize();
+    });
+    connect(discovery, &QThread::finished, this, [this, controller]() {
+        m_hidController = controller;
+        if (m_hidController->IsConnected()) {
+            qDebug() << "Lian Li device connected successfully";
+            qDebug() << "Device name:" << QString::fromStdString(m_hidController->GetDeviceName());
+            qDebug() << "Firmware version:" << QString::fromStdString(m_hidController->GetFirmwareVersion());
+        } else {
+            qDebug() << "Failed to connect to Lian Li device - fans will not work";
+        }
+        updateFanRPMs();
+        emit deviceReady();
+    });
+    connect(discovery, &QThread::finished, discovery, &QObject::deleteLater);
+    discovery->start();
+
+    // Temperature and load come from the shared sensor hub; snapshots arrive on
+    // its worker thread
+    m_sensorSubscription = SensorHub::instance().subscribe([this](const SensorSnapshotPtr &snapshot) {
+        QMetaObject::invokeMethod(this, [this, snapshot]() {
+            onSensorSnapshot(snapshot);
+        }, Qt::QueuedConnection);
+    });
+    if (SensorSnapshotPtr snapshot = SensorHub::instance().latest()) {
+        onSensorSnapshot(snapshot);
+    }
+}
+
+void FanControlService::stop()
+{
+    if (!m_started || !m_sensorSubscription) return;
+
+    // The hub is a function-local static and keeps sampling until exit; without
+    // this its worker would queue calls onto the service after QApplication is gone
+    SensorHub::instance().unsubscribe(m_sensorSubscription);
+    m_sensorSubscription = 0;
+    m_controlTimer->stop();
+    m_fanRPMTimer->stop();
+    m_controlStepTimer.invalidate();
+    m_actuatorStatsTimer.invalidate();
+}
+
+void FanControlService::onSensorSnapshot(const SensorSnapshotPtr &snapshot)
+{
+    if (snapshot->hasChanged(SensorSnapshot::CPU_LOAD)) {
+        m_utilization = snapshot->cpuUtilization;
+    }
+    if (snapshot->hasChanged(SensorSnapshot::CPU_POWER)) {
+        m_packageWatts = snapshot->packageWatts;
+    }
+
+    if (!snapshot->hasChanged(SensorSnapshot::CPU_TEMPERATURE)) {
+        return;
+    }
+
+    // Use the real CPU temperature, fall back to simulation
+    if (!std::isnan(snapshot->cpuTemperature) && snapshot->cpuTemperature > 0.0) {
+        m_temperature = static_cast<int>(snapshot->cpuTemperature);
+    } else {
+        // Smooth variation around 39°C
+        m_temperatureCounter++;
+        int baseTemp = 39;
+        int tempVariation = (m_temperatureCounter % 120) - 60; // -60 to +60 variation
+        m_temperature = qMax(25, qMin(85, baseTemp + tempVariation));
+    }
+}
+
+void FanControlService::controlNow()
+{
+    controlFanSpeeds();
+}
+
+void FanControlService::controlFanSpeeds()
+{
+    TRACE_SCOPE("FanControlService::controlFanSpeeds");
+
+    if (!m_hidController) {
+        return;
+    }
+
+    double dt = m_controlStepTimer.isValid() ? m_controlStepTimer.restart() / 1000.0 : 0.1;
+
+    // Filtering, look-ahead, feedforward and slew limiting live in FanController
+    // so the offline simulator (tools/fansim) runs exactly the same code.
+    // Package power and utilization lead the temperature, so a job that just started
+    // spins the fans up before the sensor sees it.
+    m_fanController.setLoad(m_utilization, m_packageWatts);
+
+    FanControlOutput outputs[FanController::PORT_COUNT];
+    if (m_acousticEnabled) {
+        m_acousticController.step(m_temperature, dt, outputs);
+    } else {
+        m_fanController.step(m_temperature, dt, outputs);
+    }
+
+    // Semi-passive ports: stop when cool, kick-start when hot again
+    m_zeroRpmStage.apply(m_temperature, dt, outputs);
+
+    for (int port = 1; port <= FanController::PORT_COUNT; ++port) {
+        const FanControlOutput &output = outputs[port - 1];
+        if (!output.write) {
+            continue;
+        }
+        setFanSpeed(port, output.rpm);
+        if (m_acousticEnabled) {
+            const ThermalEstimator &thermal = m_acousticController.estimator();
+            DEBUG_LOG_CATEGORY("FanSpeeds", "Port", port, ": T=", thermal.filteredTemperature(), "°C load=", thermal.load()
+                     , "K/s airflow=", m_acousticController.requiredAirflow(), " target=", output.target
+                     , " -> RPM=", output.rpm, " total=", m_acousticController.predictedDBA(), "dBA");
+        } else {
+            DEBUG_LOG_CATEGORY("FanSpeeds", "Port", port, ": T=", m_fanController.filteredTemperature(), "°C dT/dt=", m_fanController.rate(), "°C/s"
+                     , " heating=", m_fanController.heating(), " load=", m_fanController.loadWatts()
+                     , "W loadFF=", m_fanController.loadFeedForward(), " base=", output.base
+                     , " target=", output.target, " -> RPM=", output.rpm);
+        }
+    }
+
+    // Push out duties that were held back by the per-port minimum write interval
+    FanActuator &actuator = m_hidController->GetFanActuator();
+    actuator.FlushPending();
+
+    if (!m_actuatorStatsTimer.isValid()) {
+        m_actuatorStatsTimer.start();
+    } else if (m_actuatorStatsTimer.elapsed() >= 10000) {
+        m_actuatorStatsTimer.restart();
+        FanActuatorStats stats = actuator.GetStats();
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Actuator: writes=", stats.writes, "writes/s=", stats.writesPerSecond,
+                           "suppressed=", stats.suppressed, "deferred=", stats.deferred, "failures=", stats.failures,
+                           "latency us last/avg/max=", stats.lastLatencyUs, stats.avgLatencyUs, stats.maxLatencyUs);
+    }
+}
+
+void FanControlService::setFanSpeed(int port, int targetRPM)
+{
+    // The calibration sweep owns the port while it runs
+    if (port == m_calibratingPort) {
+        return;
+    }
+
+    const FanModel &model = m_fanModels[port];
+
+    // Raise targets between idle and the fan's slowest running speed (840 RPM stock),
+    // clamp to its full speed. 0 from the zero RPM stage passes through and stops the fan.
+    targetRPM = model.clampTarget(targetRPM);
+
+    // Convert RPM to percentage for kernel driver via the port's duty -> RPM curve
+    // (stock: Percentage = RPM / 21, 840 RPM = 40%, 1260 RPM = 60%, 2100 RPM = 100%)
+    int speedPercent = model.rpmToPercent(targetRPM);
+
+    // Expected dBA from the port's noise table (stock: 840 RPM = 34 dBA ... 2100 RPM = 60 dBA)
+    double expectedDBA = model.estimateDBA(targetRPM);
+
+    DEBUG_LOG_CATEGORY("FanSpeeds", "RPM conversion: targetRPM=", targetRPM, " -> speedPercent=", speedPercent, "%");
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Expected dBA for", targetRPM, "RPM:", expectedDBA);
+
+    if (!m_hidController) {
+        qDebug() << "HID controller not available for Port" << port;
+        return;
+    }
+
+    // Use kernel driver for individual port control (more reliable).
+    // The actuator keeps the port file open and skips writes that map to the same percent.
+    FanActuator::WriteResult result = m_hidController->GetFanActuator().SetDuty(port, speedPercent);
+    switch (result) {
+    case FanActuator::WRITE_OK:
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Set Port", port, "to", targetRPM, "RPM (", speedPercent, "%, expected dBA=", expectedDBA, ") via kernel driver");
+        break;
+    case FanActuator::WRITE_SUPPRESSED:
+    case FanActuator::WRITE_DEFERRED:
+        break;
+    case FanActuator::WRITE_FAILED:
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Failed to set Port", port, "to", targetRPM, "RPM - is the Lian_Li_SL_INFINITY module loaded?");
+        break;
+    }
+}
+
+void FanControlService::updateFanRPMs()
+{
+    TRACE_SCOPE("FanControlService::updateFanRPMs");
+
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        SensorHub::instance().reportFanRPM(port, portRPM(port));
+
+        // What the hardware last got, whichever path wrote it (control tick, deferred
+        // flush or the calibration hand-back)
+        int duty = m_hidController ? m_hidController->GetFanActuator().GetLastDuty(port) : -1;
+        if (duty >= 0) {
+            SensorHub::instance().reportFanDuty(port, duty);
+        }
+    }
+}
+
+int FanControlService::portRPM(int port) const
+{
+    if (port < 1 || port > PORT_COUNT) {
+        return 0;
+    }
+
+    // Check if fan is connected using kernel driver detection
+    if (!fanConnected(port)) {
+        return 0;
+    }
+
+    // Fan is connected - the driver has no tachometer, so show the speed the port's
+    // fan model predicts for the duty last written (curve value before the first write)
+    const FanModel &model = m_fanModels[port];
+    int duty = m_hidController ? m_hidController->GetFanActuator().GetLastDuty(port) : -1;
+    int rpm = duty >= 0 ? model.percentToRPM(duty)
+                        : model.clampTarget(curveRPM(port, m_temperature));
+
+    return qBound(0, rpm, model.maxRPM());
+}
+
+bool FanControlService::fanConnected(int port) const
+{
+    // One fd per port kept open and re-read in place; reopened after a failed read
+    // so a driver loaded (or reloaded) after startup is picked up
+    std::unique_ptr<ProcFile> &file = m_fanConnectedFiles[port];
+    if (!file || !file->isOpen()) {
+        file.reset(new ProcFile(QString("/proc/Lian_li_SL_INFINITY/Port_%1/fan_connected").arg(port).toStdString(), 64));
+    }
+    const char *text = file->read();
+    if (!text) {
+        // If we can't read the status, assume not connected
+        file.reset();
+        return false;
+    }
+
+    // "0" = no fan; anything else (including an unparsable value) counts as connected
+    const char *p = procfs::skipSpaces(text);
+    if (*p < '0' || *p > '9') {
+        return true;
+    }
+    return procfs::scanU64(p) != 0;
+}
+
+QString FanControlService::portProfile(int port) const
+{
+    return m_portProfiles.value(port, "Quiet");
+}
+
+void FanControlService::setPortProfile(int port, const QString &profile)
+{
+    m_portProfiles[port] = profile;
+    savePortProfiles();
+}
+
+bool FanControlService::hasPortCurve(int port) const
+{
+    return m_customCurves.contains(port);
+}
+
+QVector<QPointF> FanControlService::portCurve(int port) const
+{
+    return m_customCurves.value(port);
+}
+
+void FanControlService::setPortCurve(int port, const QVector<QPointF> &points)
+{
+    m_customCurves[port] = points;
+}
+
+QString FanControlService::customProfileName(int profile) const
+{
+    return m_customProfileNames.value(profile);
+}
+
+void FanControlService::setCustomProfileName(int profile, const QString &name)
+{
+    m_customProfileNames[profile] = name;
+    saveCustomProfiles();
+}
+
+QVector<QPointF> FanControlService::customProfileCurve(int profile) const
+{
+    return m_customProfileCurves.value(profile);
+}
+
+void FanControlService::setCustomProfileCurve(int profile, const QVector<QPointF> &points)
+{
+    m_customProfileCurves[profile] = points;
+    saveCustomProfiles();
+}
+
+QVector<QPointF> FanControlService::defaultCurve(const QString &internalProfile)
+{
+    // Built-in tables are shared with the offline tools (src/control/fancurve.cpp)
+    QVector<QPointF> curvePoints;
+    for (const FanCurvePoint &point : FanCurves::builtin(internalProfile.toStdString())) {
+        curvePoints << QPointF(point.temperature, point.rpm);
+    }
+    return curvePoints;
+}
+
+QString FanControlService::internalProfileName(const QString &displayName)
+{
+    // Map display names to internal names used for curves
+    if (displayName == "StdSP") return "Standard";
+    if (displayName == "HighSP") return "High Speed";
+    if (displayName == "FullSP") return "Full Speed";
+    return displayName; // Quiet, custom profiles, etc. use same name
+}
+
+int FanControlService::curveRPM(int port, int temperature) const
+{
+    QVector<QPointF> curvePoints = m_customCurves.value(port);
+    if (!m_customCurves.contains(port)) {
+        // No curve of its own: the port's profile (custom base curve or built-in)
+        QString profile = portProfile(port);
+        curvePoints = defaultCurve(internalProfileName(profile));
+        for (int i = 1; i <= 3; ++i) {
+            if (profile == m_customProfileNames.value(i)) {
+                curvePoints = m_customProfileCurves.value(i);
+            }
+        }
+    }
+
+    if (curvePoints.size() < 2) {
+        return 0;
+    }
+
+    // Clamp temperature to valid range
+    temperature = qMax(0, qMin(100, temperature));
+
+    // Find the two points to interpolate between
+    for (int i = 0; i < curvePoints.size() - 1; ++i) {
+        if (temperature >= curvePoints[i].x() && temperature <= curvePoints[i + 1].x()) {
+            // Linear interpolation between the two points
+            double t = (temperature - curvePoints[i].x()) / (curvePoints[i + 1].x() - curvePoints[i].x());
+            double rpm = curvePoints[i].y() + t * (curvePoints[i + 1].y() - curvePoints[i].y());
+            return static_cast<int>(rpm);
+        }
+    }
+
+    // If temperature is outside the curve range, clamp to nearest point
+    if (temperature < curvePoints.first().x()) {
+        return static_cast<int>(curvePoints.first().y());
+    } else {
+        return static_cast<int>(curvePoints.last().y());
+    }
+}
+
+const FanModel &FanControlService::fanModel(int port) const
+{
+    static const FanModel stock = FanModel::stock(2100);
+    auto it = m_fanModels.find(port);
+    return it != m_fanModels.end() ? it.value() : stock;
+}
+
+FanModel FanControlService::stockModel(int port) const
+{
+    return FanModel::stock(portIs140mm(port) ? 1600 : 2100);
+}
+
+bool FanControlService::portIs140mm(int port) const
+{
+    return port >= 1 && port <= PORT_COUNT && m_port140mm[port];
+}
+
+void FanControlService::setPortFanSize(int port, bool is140mm)
+{
+    if (port < 1 || port > PORT_COUNT) {
+        return;
+    }
+    m_port140mm[port] = is140mm;
+
+    // A calibrated port keeps its measured model; otherwise pick the stock one for the size
+    if (m_fanModels[port].isCalibrated()) {
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Port", port, "fan size changed - keeping calibrated model");
+    } else {
+        m_fanModels[port] = stockModel(port);
+        DEBUG_LOG_CATEGORY("FanSpeeds", "Port", port, "fan size changed (", m_fanModels[port].maxRPM(), "RPM max)");
+    }
+    applyFanModel(port);
+}
+
+void FanControlService::setCalibration(int port, const FanModel &model)
+{
+    m_fanModels[port] = model;
+    saveFanCalibration();
+    applyFanModel(port);
+}
+
+void FanControlService::beginCalibration(int port)
+{
+    m_calibratingPort = port;
+}
+
+void FanControlService::endCalibration()
+{
+    int port = m_calibratingPort;
+    m_calibratingPort = 0;
+    if (port == 0 || !m_hidController) {
+        return;
+    }
+
+    // Hand the port back to the controller at its current output
+    const FanModel &model = m_fanModels[port];
+    int rpm = model.clampTarget(m_fanController.lastRPM(port));
+    m_hidController->GetFanActuator().SetDuty(port, model.rpmToPercent(rpm), true);
+}
+
+void FanControlService::applyFanModel(int port)
+{
+    const FanModel &model = m_fanModels[port];
+    m_fanController.setPortMaxRPM(port, model.maxRPM());
+    m_acousticController.setPortModel(port, model);
+    m_zeroRpmStage.setPortMaxRPM(port, model.maxRPM());
+}
+
+int FanControlService::acousticMaxTemperature() const
+{
+    return static_cast<int>(m_acousticController.params().maxTemperature);
+}
+
+double FanControlService::acousticPortWeight(int port) const
+{
+    return port >= 1 && port <= PORT_COUNT ? m_acousticWeights[port] : 1.0;
+}
+
+void FanControlService::setAcoustic(bool enabled, int maxTemperature, const QVector<double> &portWeights)
+{
+    if (enabled != m_acousticEnabled) {
+        // Switching modes: neither controller should resume from stale filter/slew state
+        m_acousticController.reset();
+        m_fanController.reset();
+        m_acousticEnabled = enabled;
+    }
+
+    AcousticParams params = m_acousticController.params();
+    params.maxTemperature = maxTemperature;
+    m_acousticController.setParams(params);
+
+    for (int port = 1; port <= portWeights.size() && port <= PORT_COUNT; ++port) {
+        m_acousticWeights[port] = portWeights[port - 1];
+        m_acousticController.setPortWeight(port, portWeights[port - 1]);
+    }
+
+    applyPortConfiguration();
+    saveAcousticSettings();
+}
+
+void FanControlService::applyPortConfiguration()
+{
+    // Ports disabled on the Settings page carry no fan and no airflow
+    QSettings fanConfig("LianLi", "LConnect3");
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        m_acousticController.setPortEnabled(port, fanConfig.value(QString("FanConfig/Port%1").arg(port), true).toBool());
+    }
+}
+
+const ZeroRpmParams &FanControlService::zeroRpmParams(int port) const
+{
+    return m_zeroRpmStage.portParams(port);
+}
+
+void FanControlService::setZeroRpmParams(int port, const ZeroRpmParams &params)
+{
+    m_zeroRpmStage.setPortParams(port, params);
+    saveZeroRpmSettings();
+}
+
+void FanControlService::saveCurves()
+{
+    QSettings settings("LConnect3", "FanCurves");
+
+    // Save each port's custom curve
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        if (m_customCurves.contains(port)) {
+            QVector<QPointF> curve = m_customCurves[port];
+
+            settings.beginWriteArray(QString("Port%1").arg(port));
+            for (int i = 0; i < curve.size(); ++i) {
+                settings.setArrayIndex(i);
+                settings.setValue("temp", curve[i].x());
+                settings.setValue("rpm", curve[i].y());
+            }
+            settings.endArray();
+        }
+    }
+
+    qDebug() << "Saved custom curves for" << m_customCurves.size() << "ports";
+}
+
+void FanControlService::loadCustomCurves()
+{
+    QSettings settings("LConnect3", "FanCurves");
+
+    // Load each port's custom curve
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        int size = settings.beginReadArray(QString("Port%1").arg(port));
+        if (size > 0) {
+            QVector<QPointF> curve;
+            for (int i = 0; i < size; ++i) {
+                settings.setArrayIndex(i);
+                double temp = settings.value("temp").toDouble();
+                double rpm = settings.value("rpm").toDouble();
+                curve.append(QPointF(temp, rpm));
+            }
+            m_customCurves[port] = curve;
+            qDebug() << "Loaded custom curve for Port" << port << "with" << size << "points";
+        }
+        settings.endArray();
+    }
+}
+
+void FanControlService::saveCustomProfiles()
+{
+    QSettings settings("LConnect3", "CustomProfiles");
+
+    // Save each custom profile name and base curve
+    for (int i = 1; i <= 3; ++i) {
+        settings.setValue(QString("Profile%1Name").arg(i), m_customProfileNames[i]);
+
+        QVector<QPointF> curve = m_customProfileCurves[i];
+        settings.beginWriteArray(QString("Profile%1Curve").arg(i));
+        for (int j = 0; j < curve.size(); ++j) {
+            settings.setArrayIndex(j);
+            settings.setValue("temp", curve[j].x());
+            settings.setValue("rpm", curve[j].y());
+        }
+        settings.endArray();
+    }
+
+    qDebug() << "Saved custom profiles";
+}
+
+void FanControlService::loadCustomProfiles()
+{
+    QSettings settings("LConnect3", "CustomProfiles");
+
+    // Load each custom profile name and base curve
+    for (int i = 1; i <= 3; ++i) {
+        QString name = settings.value(QString("Profile%1Name").arg(i), "Cust" + QString::number(i)).toString();
+        m_customProfileNames[i] = name;
+
+        int size = settings.beginReadArray(QString("Profile%1Curve").arg(i));
+        if (size > 0) {
+            QVector<QPointF> curve;
+            for (int j = 0; j < size; ++j) {
+                settings.setArrayIndex(j);
+                double temp = settings.value("temp").toDouble();
+                double rpm = settings.value("rpm").toDouble();
+                curve.append(QPointF(temp, rpm));
+            }
+            m_customProfileCurves[i] = curve;
+            qDebug() << "Loaded custom profile" << i << "(" << name << ") with" << size << "points";
+        } else {
+            // No saved curve, use Quiet default
+            m_customProfileCurves[i] = defaultCurve("Quiet");
+        }
+        settings.endArray();
+    }
+}
+
+void FanControlService::savePortProfiles()
+{
+    QSettings settings("LConnect3", "PortProfiles");
+
+    // Save profile name for each port
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        settings.setValue(QString("Port%1").arg(port), portProfile(port));
+    }
+
+    qDebug() << "Saved port profiles";
+}
+
+void FanControlService::loadPortProfiles()
+{
+    QSettings settings("LConnect3", "PortProfiles");
+
+    // Load profile name for each port
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        QString profileName = settings.value(QString("Port%1").arg(port), "Quiet").toString();
+        m_portProfiles[port] = profileName;
+        qDebug() << "Loaded Port" << port << "profile:" << profileName;
+    }
+}
+
+void FanControlService::saveFanCalibration()
+{
+    QSettings settings("LConnect3", "FanCalibration");
+
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        QString key = QString("Port%1").arg(port);
+        settings.remove(key);
+
+        const FanModel &model = m_fanModels[port];
+        if (!model.isCalibrated()) {
+            continue;
+        }
+
+        const std::vector<FanCalibrationSample> &samples = model.samples();
+        settings.beginWriteArray(key);
+        for (int i = 0; i < (int)samples.size(); ++i) {
+            settings.setArrayIndex(i);
+            settings.setValue("duty", samples[i].duty);
+            settings.setValue("rpm", std::isnan(samples[i].rpm) ? -1.0 : samples[i].rpm);
+            settings.setValue("dba", std::isnan(samples[i].dba) ? -1.0 : samples[i].dba);
+        }
+        settings.endArray();
+    }
+}
+
+void FanControlService::loadFanCalibration()
+{
+    QSettings settings("LConnect3", "FanCalibration");
+
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        int size = settings.beginReadArray(QString("Port%1").arg(port));
+        std::vector<FanCalibrationSample> samples;
+        for (int i = 0; i < size; ++i) {
+            settings.setArrayIndex(i);
+            double rpm = settings.value("rpm", -1.0).toDouble();
+            double dba = settings.value("dba", -1.0).toDouble();
+            samples.push_back({ settings.value("duty").toInt(), rpm < 0 ? NAN : rpm, dba < 0 ? NAN : dba });
+        }
+        settings.endArray();
+
+        if (!samples.empty()) {
+            m_fanModels[port] = FanModel::fit(samples, stockModel(port));
+            qDebug() << "Loaded calibration for Port" << port << "- max" << m_fanModels[port].maxRPM() << "RPM";
+        }
+        applyFanModel(port);
+    }
+}
+
+void FanControlService::saveAcousticSettings()
+{
+    QSettings settings("LConnect3", "FanProfile");
+    settings.setValue("AcousticMode/Enabled", m_acousticEnabled);
+    settings.setValue("AcousticMode/MaxTemp", acousticMaxTemperature());
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        settings.setValue(QString("AcousticMode/Weight%1").arg(port), m_acousticWeights[port]);
+    }
+}
+
+void FanControlService::loadAcousticSettings()
+{
+    QSettings settings("LConnect3", "FanProfile");
+
+    m_acousticEnabled = settings.value("AcousticMode/Enabled", false).toBool();
+    AcousticParams params = m_acousticController.params();
+    params.maxTemperature = settings.value("AcousticMode/MaxTemp", 75).toInt();
+    m_acousticController.setParams(params);
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        m_acousticWeights[port] = settings.value(QString("AcousticMode/Weight%1").arg(port), 1.0).toDouble();
+        m_acousticController.setPortWeight(port, m_acousticWeights[port]);
+    }
+    applyPortConfiguration();
+}
+
+void FanControlService::saveZeroRpmSettings()
+{
+    QSettings settings("LConnect3", "FanProfile");
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        const ZeroRpmParams &params = m_zeroRpmStage.portParams(port);
+        QString prefix = QString("ZeroRpm/Port%1/").arg(port);
+        settings.setValue(prefix + "Enabled", params.enabled);
+        settings.setValue(prefix + "StopTemp", params.stopTemperature);
+        settings.setValue(prefix + "StartTemp", params.startTemperature);
+    }
+}
+
+void FanControlService::loadZeroRpmSettings()
+{
+    QSettings settings("LConnect3", "FanProfile");
+    for (int port = 1; port <= PORT_COUNT; ++port) {
+        ZeroRpmParams params;
+        QString prefix = QString("ZeroRpm/Port%1/").arg(port);
+        params.enabled = settings.value(prefix + "Enabled", false).toBool();
+        params.stopTemperature = settings.value(prefix + "StopTemp", params.stopTemperature).toDouble();
+        params.startTemperature = settings.value(prefix + "StartTemp", params.startTemperature).toDouble();
+        m_zeroRpmStage.setPortParams(port, params);
+    }
+}
@@ -0,0 +1,176 @@
+/*---------------------------------------------------------*\
+||| fancontrolservice.h                                     |
+|||                                                         |
+|||   Fan control without a window                         |
+|||   Owns the hub connection, the per-port curves,        |
+|||   profiles and fan models, the controllers and the     |
+|||   20 Hz control loop, and persists their settings.     |
+|||   The Fan Profile page is only a view onto it, so      |
+|||   fans keep being driven while the window is closed    |
+|||   to the tray.                                         |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include "usb/lian_li_sl_infinity_controller.h"
+#include "control/fancontroller.h"
+#include "control/acousticcontroller.h"
+#include "control/zerorpm.h"
+#include "control/fanmodel.h"
+#include "sensors/procfs.h"
+#include "sensors/sensorhub.h"
+#include <memory>
+
+class QTimer;
+
+class FanControlService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int PORT_COUNT = 4;
+
+    // Created on first use; lives until the application exits
+    static FanControlService &instance();
+
+    // Load settings, open the hub on a worker thread and start the control loop.
+    // Does nothing the second time.
+    void start();
+
+    // Stop the loop and leave the sensor hub for good; runs on aboutToQuit,
+    // since the service itself outlives QApplication
+    void stop();
+
+    // Null until device discovery has finished
+    LianLiSLInfinityController *hidController() const { return m_hidController; }
+
+    // Latest CPU temperature (°C) the loop is working from
+    int temperature() const { return m_temperature; }
+
+    // Per-port profile name as shown on the page ("Quiet", "StdSP", a custom name)
+    QString portProfile(int port) const;
+    void setPortProfile(int port, const QString &profile);
+
+    // Per-port curve; ports without one follow their profile's curve
+    bool hasPortCurve(int port) const;
+    QVector<QPointF> portCurve(int port) const;
+    void setPortCurve(int port, const QVector<QPointF> &points);
+    void saveCurves();
+
+    // Custom profiles 1-3
+    QString customProfileName(int profile) const;
+    void setCustomProfileName(int profile, const QString &name);
+    QVector<QPointF> customProfileCurve(int profile) const;
+    void setCustomProfileCurve(int profile, const QVector<QPointF> &points);
+
+    static QVector<QPointF> defaultCurve(const QString &internalProfile);
+    static QString internalProfileName(const QString &displayName);
+
+    // Target RPM of a port's curve at a temperature
+    int curveRPM(int port, int temperature) const;
+
+    // Duty/RPM/dBA model per port: calibrated if the port was swept, otherwise the
+    // stock model for its size (120mm = 2100 RPM, 140mm = 1600 RPM)
+    const FanModel &fanModel(int port) const;
+    FanModel stockModel(int port) const;
+    bool portIs140mm(int port) const;
+    void setPortFanSize(int port, bool is140mm);
+    void setCalibration(int port, const FanModel &model);
+
+    // The calibration sweep owns a port between these; end hands it back at the
+    // controller's current output
+    void beginCalibration(int port);
+    void endCalibration();
+
+    // Acoustic-budget mode: hold a temperature ceiling with the quietest port mix
+    bool acousticEnabled() const { return m_acousticEnabled; }
+    int acousticMaxTemperature() const;
+    double acousticPortWeight(int port) const;
+    void setAcoustic(bool enabled, int maxTemperature, const QVector<double> &portWeights);
+
+    // Zero RPM (semi-passive) mode
+    const ZeroRpmParams &zeroRpmParams(int port) const;
+    void setZeroRpmParams(int port, const ZeroRpmParams &params);
+
+    // Speed shown for a port: 0 when the driver reports no fan, otherwise what the
+    // port's model predicts for the last duty written
+    int portRPM(int port) const;
+
+    // Run a control step now instead of waiting for the next tick (curve edits)
+    void controlNow();
+
+signals:
+    // Device discovery finished (connected or not)
+    void deviceReady();
+
+private:
+    explicit FanControlService(QObject *parent = nullptr);
+
+    void onSensorSnapshot(const SensorSnapshotPtr &snapshot);
+    void controlFanSpeeds();
+    void setFanSpeed(int port, int targetRPM);
+    void updateFanRPMs();
+    bool fanConnected(int port) const;
+    void applyFanModel(int port);
+    void applyPortConfiguration();
+
+    void loadCustomCurves();
+    void loadCustomProfiles();
+    void saveCustomProfiles();
+    void loadPortProfiles();
+    void savePortProfiles();
+    void loadFanCalibration();
+    void saveFanCalibration();
+    void loadAcousticSettings();
+    void saveAcousticSettings();
+    void loadZeroRpmSettings();
+    void saveZeroRpmSettings();
+
+    bool m_started;
+
+    LianLiSLInfinityController *m_hidController;
+
+    // Per-port curves, profile names and fan models (ports 1-4)
+    QMap<int, QVector<QPointF>> m_customCurves;
+    QMap<int, QString> m_portProfiles;
+    QMap<int, FanModel> m_fanModels;
+    bool m_port140mm[PORT_COUNT + 1];
+
+    // Custom profile names and base curves (profiles 1-3)
+    QMap<int, QString> m_customProfileNames;
+    QMap<int, QVector<QPointF>> m_customProfileCurves;
+
+    // Latest sensor values; utilization (0-1) and package power are NaN when unknown
+    int m_temperature;
+    int m_temperatureCounter;
+    double m_utilization;
+    double m_packageWatts;
+    int m_sensorSubscription;
+
+    // Port currently being swept by the calibration dialog (0 = none)
+    int m_calibratingPort;
+
+    FanController m_fanController;
+    AcousticController m_acousticController;
+    ZeroRpmStage m_zeroRpmStage;
+    bool m_acousticEnabled;
+    double m_acousticWeights[PORT_COUNT + 1];
+    QElapsedTimer m_controlStepTimer;
+    QElapsedTimer m_actuatorStatsTimer;     // Actuator stats logged every 10 s
+
+    // Control loop at 20 Hz, fan RPMs for the telemetry log once a second
+    QTimer *m_controlTimer;
+    QTimer *m_fanRPMTimer;
+
+    // Driver's fan_connected file per port, opened on first use
+    mutable std::unique_ptr<ProcFile> m_fanConnectedFiles[PORT_COUNT + 1];
+};
@@ -10,15 +10,19 @@
 
 #include "lian_li_qt_integration.h"
 #include "utils/qtdebugutil.h"
+#include "utils/trace.h"
 #include <QDebug>
 #include <QThread>
 #include <QApplication>
+#include <memory>
 
 LianLiQtIntegration::LianLiQtIntegration(QObject *parent)
     : QObject(parent)
     , m_controller(std::make_unique<SLInfinityHIDController>())
     , m_deviceCheckTimer(new QTimer(this))
     , m_wasConnected(false)
+    , m_initializing(false)
+    , m_streamValid(false)
 {
     // Set up device monitoring timer
     m_deviceCheckTimer->setInterval(2000); // Check every 2 seconds
@@ -49,6 +53,40 @@ bool LianLiQtIntegration::initialize()
     }
 }
 
+void LianLiQtIntegration::initializeAsync()
+{
+    if (m_initializing) return;
+    m_initializing = true;
+    
+    // The worker opens its own controller and hands it over once it is done, so
+    // nothing on this thread ever touches a device that is still being opened
+    auto controller = std::make_shared<std::unique_ptr<SLInfinityHIDController>>(
+        std::make_unique<SLInfinityHIDController>());
+    auto ok = std::make_shared<bool>(false);
+    
+    QThread *worker = QThread::create([controller, ok]() {
+        Trace::setThreadName("LianLiQtIntegration discovery");
+        TRACE_SCOPE("SLInfinityHID::Initialize");
+        *ok = (*controller)->Initialize();
+    });
+    connect(worker, &QThread::finished, this, [this, controller, ok]() {
+        m_initializing = false;
+        m_controller = std::move(*controller);
+        m_streamValid = false;
+        if (*ok) {
+            m_wasConnected = true;
+            m_deviceCheckTimer->start();
+            emit deviceConnected();
+            DEBUG_LOG("Lian Li device connected successfully");
+        } else {
+            emit errorOccurred("Failed to initialize Lian Li device");
+            DEBUG_LOG("Failed to initialize Lian Li device");
+        }
+    });
+    connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+    worker->start();
+}
+
 void LianLiQtIntegration::shutdown()
 {
     if (m_deviceCheckTimer) {
@@ -226,6 +264,35 @@ bool LianLiQtIntegration::turnOffAllChannels()
     return success;
 }
 
+bool LianLiQtIntegration::streamFrame(const LedFrame &frame, bool onlyChanged)
+{
+    if (!isConnected()) {
+        m_streamValid = false;
+        return false;
+    }
+    
+    bool success = true;
+    for (int channel = 0; channel < LedFrame::CHANNELS; channel++) {
+        if (onlyChanged && m_streamValid
+            && std::memcmp(frame.channel(channel), m_streamed.channel(channel), LedFrame::CHANNEL_BYTES) == 0) {
+            continue;
+        }
+        
+        // The frame already carries brightness and the current limit, so the
+        // static mode commit runs at full brightness
+        bool sent = m_controller->SetChannelLeds(static_cast<uint8_t>(channel), frame.channel(channel))
+                    && m_controller->SendCommitAction(static_cast<uint8_t>(channel), 0x01, 0x00, 0x00, convertBrightness(100));
+        if (sent) {
+            std::memcpy(m_streamed.channel(channel), frame.channel(channel), LedFrame::CHANNEL_BYTES);
+        }
+        success &= sent;
+    }
+    
+    // After a failure every channel is sent again next time
+    m_streamValid = success;
+    return success;
+}
+
 bool LianLiQtIntegration::setAllChannelsColor(const QColor &color, int brightness)
 {
     if (!isConnected()) {
@@ -16,6 +16,7 @@
 #include <QString>
 #include <memory>
 #include "usb/sl_infinity_hid.h"
+#include "lighting/ledframe.h"
 
 class LianLiQtIntegration : public QObject
 {
@@ -27,6 +28,10 @@ public:
 
     // Device management
     bool initialize();
+    // Same as initialize(), but device discovery runs on a worker thread;
+    // deviceConnected() or errorOccurred() is emitted on this object's thread
+    // when it is done. Until then the integration reports not connected.
+    void initializeAsync();
     void shutdown();
     bool isConnected() const;
     
@@ -79,6 +84,12 @@ public:
     bool setTunnelEffect(const QColor &color, int speed = 50, int brightness = 100, bool directionLeft = false);
     bool setChannelTunnel(int channel, const QColor colors[4], int speed = 50, int brightness = 100, bool directionLeft = false);
     
+    // Host-driven lighting: send an EffectRenderer frame as static colour data.
+    // With onlyChanged, channels whose bytes match the last streamed frame are
+    // skipped; pass false after a firmware effect has replaced the LED contents.
+    // Each channel sent costs three transfers (~15 ms).
+    bool streamFrame(const LedFrame &frame, bool onlyChanged = true);
+    
     // Helper to convert percentage values to hardware values
     static uint8_t convertSpeed(int speedPercent);
     static uint8_t convertBrightness(int brightnessPercent);
@@ -101,6 +112,9 @@ private:
     std::unique_ptr<SLInfinityHIDController> m_controller;
     QTimer *m_deviceCheckTimer;
     bool m_wasConnected;
+    bool m_initializing;    // initializeAsync() in flight
+    LedFrame m_streamed;    // Last frame sent by streamFrame()
+    bool m_streamValid;
     
     // Helper methods
     SLInfinityColor qColorToSLInfinity(const QColor &color) const;
@@ -0,0 +1,282 @@
+/*---------------------------------------------------------*\
+||| effectrenderer.cpp                                      |
+|||                                                         |
+|||   Software lighting effects                            |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "effectrenderer.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const int RING = LedFrame::LEDS_PER_FAN;
+const float TWO_PI = 6.28318530718f;
+
+const char* const EFFECT_NAMES[EffectRenderer::EFFECT_COUNT] = {
+    "Rainbow", "Rainbow Morph", "Static Color", "Breathing", "Meteor", "Runway", "Groove",
+    "Mixing", "Neon", "Stack", "Staggered", "Tide", "Tunnel", "Voice",
+};
+
+// Fully saturated hue wheel, one entry per LED, as float planes
+struct RainbowTable {
+    float r[RING], g[RING], b[RING];
+
+    RainbowTable() {
+        for (int i = 0; i < RING; ++i) {
+            const float h = float(i * 360 / RING) / 60.0f;
+            const int sector = int(h);
+            const float f = h - float(sector);
+            const float up = 255.0f * f, down = 255.0f * (1.0f - f);
+            const float rgb[6][3] = {
+                {255.0f, up, 0.0f}, {down, 255.0f, 0.0f}, {0.0f, 255.0f, up},
+                {0.0f, down, 255.0f}, {up, 0.0f, 255.0f}, {255.0f, 0.0f, down},
+            };
+            r[i] = rgb[sector][0];
+            g[i] = rgb[sector][1];
+            b[i] = rgb[sector][2];
+        }
+    }
+};
+
+const RainbowTable& rainbow() {
+    static const RainbowTable table;
+    return table;
+}
+
+float frac(float x) {
+    return x - std::floor(x);
+}
+
+int wrap(int i) {
+    return ((i % RING) + RING) % RING;
+}
+
+// 0-1 wave per LED: sin(phase + i * step) mapped to 0-1
+void wave(float phase, float step, float* out) {
+    for (int i = 0; i < RING; ++i) {
+        out[i] = std::sin(phase + float(i) * step) * 0.5f + 0.5f;
+    }
+}
+
+// The kernels below fill a ring's planes from per-LED levels or blend factors;
+// plain loops over 16 floats that the compiler vectorises
+
+void levels(EffectRenderer::Rgb color, const float* level, float* r, float* g, float* b) {
+    const float cr = color.r, cg = color.g, cb = color.b;
+    for (int i = 0; i < RING; ++i) {
+        r[i] = cr * level[i];
+        g[i] = cg * level[i];
+        b[i] = cb * level[i];
+    }
+}
+
+void blend(EffectRenderer::Rgb a, EffectRenderer::Rgb b, const float* mix, float* outR, float* outG, float* outB) {
+    const float ar = a.r, ag = a.g, ab = a.b;
+    const float dr = float(b.r) - ar, dg = float(b.g) - ag, db = float(b.b) - ab;
+    for (int i = 0; i < RING; ++i) {
+        outR[i] = ar + dr * mix[i];
+        outG[i] = ag + dg * mix[i];
+        outB[i] = ab + db * mix[i];
+    }
+}
+
+// Rainbow starting at hue index `offset`, each LED scaled by its level
+void rainbowLevels(int offset, const float* level, float* r, float* g, float* b) {
+    const RainbowTable& table = rainbow();
+    for (int i = 0; i < RING; ++i) {
+        const int hue = (i + offset) & (RING - 1);
+        r[i] = table.r[hue] * level[i];
+        g[i] = table.g[hue] * level[i];
+        b[i] = table.b[hue] * level[i];
+    }
+}
+
+void constant(float value, float* out) {
+    for (int i = 0; i < RING; ++i) out[i] = value;
+}
+
+} // namespace
+
+EffectRenderer::Effect EffectRenderer::effectFromName(const std::string& name) {
+    if (name == "Rainbow Wave") return RAINBOW;
+    if (name == "Spectrum Cycle") return RAINBOW_MORPH;
+    for (int e = 0; e < EFFECT_COUNT; ++e) {
+        if (name == EFFECT_NAMES[e]) return Effect(e);
+    }
+    // "Static" and anything unknown show the port colours
+    return STATIC_COLOR;
+}
+
+const char* EffectRenderer::effectName(Effect effect) {
+    return effect >= 0 && effect < EFFECT_COUNT ? EFFECT_NAMES[effect] : "";
+}
+
+EffectRenderer::EffectRenderer()
+    : m_effect(RAINBOW)
+    , m_speed(0.5f)
+    , m_brightness(1.0f)
+    , m_directionLeft(false)
+    , m_color{255, 255, 255}
+    , m_portColors{{255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {255, 255, 0}}
+    , m_portEnabled{true, true, true, true}
+    , m_hasPrevious(false) {
+}
+
+bool EffectRenderer::render(double seconds, LedFrame& frame) {
+    // 2.0 per second at 100% speed, the pace the preview has always had; wrapped
+    // hourly so float phases keep their precision
+    const float time = float(std::fmod(seconds * 2.0, 3600.0)) * m_speed;
+
+    frame.clear();
+    Planes ring;
+    for (int port = 0; port < LedFrame::PORTS; ++port) {
+        if (!m_portEnabled[port]) continue;
+        renderRing(port, time, ring);
+        pack(ring, port, frame);
+    }
+
+    const bool changed = !m_hasPrevious || std::memcmp(m_previous.rbg, frame.rbg, sizeof(frame.rbg)) != 0;
+    if (changed) {
+        std::memcpy(m_previous.rbg, frame.rbg, sizeof(frame.rbg));
+        m_hasPrevious = true;
+    }
+    return changed;
+}
+
+void EffectRenderer::renderRing(int port, float time, Planes& out) const {
+    const Rgb color = m_portColors[port];
+    const Rgb next = m_portColors[(port + 1) % LedFrame::PORTS];
+    const float direction = m_directionLeft ? -1.0f : 1.0f;
+    float level[RING];
+    float mix[RING];
+
+    switch (m_effect) {
+    case RAINBOW: {
+        // The wheel turns by `time` radians; LED k shows the hue that has reached it
+        const int shift = int(std::floor(direction * time / (TWO_PI / RING)));
+        constant(1.0f, level);
+        rainbowLevels(wrap(port * 2 - shift), level, out.r, out.g, out.b);
+        break;
+    }
+    case RAINBOW_MORPH: {
+        const RainbowTable& table = rainbow();
+        const float morphTime = direction * time * 0.5f; // Slower than rainbow
+        for (int i = 0; i < RING; ++i) {
+            const int hue = wrap(i + port * 3 + int(std::sin(morphTime + float(i) * 0.5f) * 0.3f * 16.0f));
+            out.r[i] = table.r[hue];
+            out.g[i] = table.g[hue];
+            out.b[i] = table.b[hue];
+        }
+        break;
+    }
+    case STATIC_COLOR:
+    case GROOVE:
+        // Groove turns four 4-LED groups, which covers the whole ring
+        constant(1.0f, level);
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    case BREATHING:
+        constant(0.3f + 0.7f * (std::sin(time * 2.0f) * 0.5f + 0.5f), level);
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    case METEOR: {
+        // Bright head with a fading trail of 5 LEDs
+        float position = frac(time * 1.5f);
+        if (m_directionLeft) position = 1.0f - position;
+        const int head = int(position * RING) % RING;
+        constant(0.0f, level);
+        for (int distance = 0; distance <= 5; ++distance) {
+            const float trail = 1.0f - float(distance) / 5.0f;
+            level[(head + distance) % RING] = trail * trail;
+        }
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    }
+    case RUNWAY: {
+        float position = frac(time * 1.2f);
+        if (m_directionLeft) position = 1.0f - position;
+        for (int i = 0; i < RING; ++i) {
+            level[i] = std::fmod(position * RING + float(i), float(RING)) < 0.2f * RING ? 1.0f : 0.0f;
+        }
+        levels(m_color, level, out.r, out.g, out.b);
+        break;
+    }
+    case MIXING: {
+        // The port colour against a lighter version of itself
+        const Rgb lighter = {uint8_t(color.r + 50 > 255 ? 255 : color.r + 50),
+                             uint8_t(color.g + 50 > 255 ? 255 : color.g + 50),
+                             uint8_t(color.b + 50 > 255 ? 255 : color.b + 50)};
+        wave(time, 0.5f, mix);
+        blend(color, lighter, mix, out.r, out.g, out.b);
+        break;
+    }
+    case NEON:
+        constant(0.4f + 0.6f * (std::sin(time * 2.0f) * 0.5f + 0.5f), level);
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    case STACK: {
+        float position = frac(time);
+        if (m_directionLeft) position = 1.0f - position;
+        for (int i = 0; i < RING; ++i) {
+            level[i] = float(i) / RING <= position ? 1.0f : 0.0f;
+        }
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    }
+    case STAGGERED: {
+        const int step = int(time * 4.0f);
+        for (int i = 0; i < RING; ++i) {
+            mix[i] = (step + i) % 4 < 2 ? 0.0f : 1.0f;
+        }
+        blend(color, next, mix, out.r, out.g, out.b);
+        break;
+    }
+    case TIDE:
+        wave(time * 2.0f, 0.5f, mix);
+        blend(color, next, mix, out.r, out.g, out.b);
+        break;
+    case TUNNEL:
+        wave(direction * time * 1.6f, 0.1f, level);
+        for (int i = 0; i < RING; ++i) level[i] = 0.3f + 0.7f * level[i];
+        levels(color, level, out.r, out.g, out.b);
+        break;
+    case VOICE: {
+        // Pulsing rainbow, even and odd LEDs on different beats
+        const float even = 0.4f + 0.6f * (std::sin(time * 3.0f) * 0.5f + 0.5f);
+        const float odd = 0.4f + 0.6f * (std::sin(time * 4.0f + 1.0f) * 0.5f + 0.5f);
+        for (int i = 0; i < RING; ++i) level[i] = i % 2 == 0 ? even : odd;
+        rainbowLevels(port * 2, level, out.r, out.g, out.b);
+        break;
+    }
+    case EFFECT_COUNT:
+        constant(0.0f, out.r);
+        constant(0.0f, out.g);
+        constant(0.0f, out.b);
+        break;
+    }
+}
+
+void EffectRenderer::pack(const Planes& ring, int port, LedFrame& frame) const {
+    // Brightness and the hub's 460 current limit, per LED as SetChannelColors applies them
+    uint8_t bytes[RING * 3];
+    for (int i = 0; i < RING; ++i) {
+        const float sum = ring.r[i] + ring.g[i] + ring.b[i];
+        const float scale = sum > 460.0f ? m_brightness * (460.0f / sum) : m_brightness;
+        bytes[i * 3 + 0] = uint8_t(ring.r[i] * scale);
+        bytes[i * 3 + 1] = uint8_t(ring.b[i] * scale);
+        bytes[i * 3 + 2] = uint8_t(ring.g[i] * scale);
+    }
+
+    // Same ring on every fan of the chain, on both of the port's channels
+    for (int c = port * 2; c < port * 2 + 2; ++c) {
+        uint8_t* channel = frame.channel(c);
+        for (int fan = 0; fan < 4; ++fan) {
+            std::memcpy(channel + fan * sizeof(bytes), bytes, sizeof(bytes));
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*---------------------------------------------------------*\
+||| effectrenderer.h                                        |
+|||                                                         |
+|||   Software lighting effects                            |
+|||   Renders an effect at a point in time straight into  |
+|||   an LedFrame: one 16-LED ring per port, computed as   |
+|||   float R/G/B planes by a small kernel per effect and  |
+|||   packed to RBG bytes with the brightness and current  |
+|||   limit the hub's colour path uses. The same frame     |
+|||   feeds the preview and can be streamed to the hub.    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "ledframe.h"
+#include <cstdint>
+#include <string>
+
+class EffectRenderer {
+public:
+    enum Effect {
+        RAINBOW,
+        RAINBOW_MORPH,
+        STATIC_COLOR,
+        BREATHING,
+        METEOR,
+        RUNWAY,
+        GROOVE,
+        MIXING,
+        NEON,
+        STACK,
+        STAGGERED,
+        TIDE,
+        TUNNEL,
+        VOICE,
+        EFFECT_COUNT
+    };
+
+    struct Rgb {
+        uint8_t r, g, b;
+    };
+
+    // Lighting page names ("Rainbow Wave", "Static", ...); unknown names are STATIC_COLOR
+    static Effect effectFromName(const std::string& name);
+    static const char* effectName(Effect effect);
+
+    EffectRenderer();
+
+    void setEffect(Effect effect) { m_effect = effect; }
+    void setSpeed(int percent) { m_speed = percent / 100.0f; }
+    void setBrightness(int percent) { m_brightness = (percent < 0 ? 0 : percent > 100 ? 100 : percent) / 100.0f; }
+    void setDirection(bool leftToRight) { m_directionLeft = leftToRight; }
+    void setColor(Rgb color) { m_color = color; }                  // Runway
+    void setPortColor(int port, Rgb color) { m_portColors[port] = color; }
+    void setPortEnabled(int port, bool enabled) { m_portEnabled[port] = enabled; }
+
+    Effect effect() const { return m_effect; }
+
+    // Render the effect `seconds` after it started. Both channels of a port get
+    // the ring on all four fans; disabled ports and LEDs 64-79 stay dark.
+    // Returns false when the bytes equal the previous render's.
+    bool render(double seconds, LedFrame& frame);
+
+private:
+    static const int RING = LedFrame::LEDS_PER_FAN;
+
+    // One ring in linear 0-255 floats, before brightness
+    struct Planes {
+        float r[RING];
+        float g[RING];
+        float b[RING];
+    };
+
+    void renderRing(int port, float time, Planes& out) const;
+    void pack(const Planes& ring, int port, LedFrame& frame) const;
+
+    Effect m_effect;
+    float m_speed;
+    float m_brightness;
+    bool m_directionLeft;
+    Rgb m_color;
+    Rgb m_portColors[LedFrame::PORTS];
+    bool m_portEnabled[LedFrame::PORTS];
+
+    LedFrame m_previous;        // For the unchanged-frame check
+    bool m_hasPrevious;
+};
@@ -0,0 +1,50 @@
+/*---------------------------------------------------------*\
+||| ledframe.h                                              |
+|||                                                         |
+|||   One frame of SL Infinity LED colours                 |
+|||   The bytes the hub takes for all 8 channels: 80 LEDs |
+|||   per channel in R, B, G order, the same layout        |
+|||   SLInfinityHIDController sends after a start action.  |
+|||   Each port drives two channels (inner and outer ring) |
+|||   of up to four chained fans, 16 LEDs per fan.         |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+struct LedFrame {
+    static const int CHANNELS = 8;
+    static const int LEDS = 80;             // (4 fans + 1) * 16, as OpenRGB sends
+    static const int LEDS_PER_FAN = 16;
+    static const int PORTS = CHANNELS / 2;
+    static const int CHANNEL_BYTES = LEDS * 3;
+
+    uint8_t rbg[CHANNELS][CHANNEL_BYTES];
+
+    LedFrame() { clear(); }
+
+    void clear() { std::memset(rbg, 0, sizeof(rbg)); }
+
+    uint8_t* channel(int c) { return rbg[c]; }
+    const uint8_t* channel(int c) const { return rbg[c]; }
+
+    // Colour of one LED back in R, G, B order
+    void get(int c, int led, uint8_t& r, uint8_t& g, uint8_t& b) const {
+        const uint8_t* p = rbg[c] + led * 3;
+        r = p[0];
+        b = p[1];
+        g = p[2];
+    }
+
+    void set(int c, int led, uint8_t r, uint8_t g, uint8_t b) {
+        uint8_t* p = rbg[c] + led * 3;
+        p[0] = r;
+        p[1] = b;
+        p[2] = g;
+    }
+};
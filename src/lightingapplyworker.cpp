@@ -0,0 +1,137 @@
+/*---------------------------------------------------------*\
+||| lightingapplyworker.cpp                                 |
+|||                                                         |
+|||   Lighting writes off the UI thread                    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "lightingapplyworker.h"
+#include "lian_li_qt_integration.h"
+#include "utils/qtdebugutil.h"
+#include "utils/trace.h"
+#include <QThread>
+#include <chrono>
+
+LightingApplyWorker::LightingApplyWorker(LianLiQtIntegration* device, QObject* parent)
+    : QObject(parent)
+    , m_device(device)
+    , m_pendingId(0)
+    , m_quit(false)
+    , m_latest(0)
+    , m_busy(false)
+    , m_nextId(0)
+{
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->start();
+}
+
+LightingApplyWorker::~LightingApplyWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        m_latest.store(-1);
+    }
+    m_wake.notify_all();
+    m_thread->wait();
+    delete m_thread;
+}
+
+int LightingApplyWorker::submit(LightingApplyRequest request)
+{
+    const int id = ++m_nextId;
+    int dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dropped = m_pendingId;
+        m_pending = std::move(request);
+        m_pendingId = id;
+        m_latest.store(id);
+    }
+    m_wake.notify_all();
+
+    if (dropped) {
+        emit finished(dropped, false, true);
+    }
+    return id;
+}
+
+void LightingApplyWorker::cancel()
+{
+    int dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dropped = m_pendingId;
+        m_pending = LightingApplyRequest();
+        m_pendingId = 0;
+        m_latest.store(++m_nextId);
+    }
+    m_wake.notify_all();
+
+    if (dropped) {
+        emit finished(dropped, false, true);
+    }
+}
+
+bool LightingApplyWorker::superseded(int id) const
+{
+    return m_latest.load() != id;
+}
+
+void LightingApplyWorker::run()
+{
+    Trace::setThreadName("LightingApplyWorker");
+
+    for (;;) {
+        LightingApplyRequest request;
+        int id = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_quit || m_pendingId != 0; });
+            if (m_quit) {
+                return;
+            }
+            request = std::move(m_pending);
+            id = m_pendingId;
+            m_pendingId = 0;
+            m_busy.store(true);
+        }
+
+        execute(id, request);
+        m_busy.store(false);
+    }
+}
+
+void LightingApplyWorker::execute(int id, const LightingApplyRequest& request)
+{
+    TRACE_SCOPE("LightingApplyWorker::execute");
+
+    const int total = request.writes();
+    int done = 0;
+    bool ok = true;
+
+    for (const LightingApplyRequest::Step& step : request.m_steps) {
+        if (superseded(id)) {
+            DEBUG_LOG("Lighting apply", request.name(), "superseded after", done, "of", total, "writes");
+            emit finished(id, false, true);
+            return;
+        }
+
+        if (step.write) {
+            if (!step.write(*m_device)) {
+                ok = false;
+            }
+            emit progress(id, ++done, total);
+        } else if (step.pauseMs > 0) {
+            // Interruptible sleep: a newer request doesn't wait out our settle time
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(step.pauseMs), [this, id]() {
+                return m_quit || superseded(id);
+            });
+        }
+    }
+
+    emit finished(id, ok, false);
+}
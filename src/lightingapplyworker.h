@@ -0,0 +1,98 @@
+/*---------------------------------------------------------*\
+||| lightingapplyworker.h                                   |
+|||                                                         |
+|||   Lighting writes off the UI thread                    |
+|||   A page describes an apply as a list of device        |
+|||   writes and settle pauses; one worker thread per      |
+|||   device runs them in order. Submitting a new request  |
+|||   drops a queued one and abandons a running one at its |
+|||   next step, so dragging a slider never builds up a    |
+|||   backlog of stale effects.                            |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+class LianLiQtIntegration;
+class QThread;
+
+class LightingApplyRequest {
+public:
+    // One device write, run on the worker thread: capture everything by value
+    using Write = std::function<bool(LianLiQtIntegration& device)>;
+
+    explicit LightingApplyRequest(const QString& name = QString()) : m_name(name), m_writes(0) {}
+
+    void add(Write write) { m_steps.append({ std::move(write), 0 }); m_writes++; }
+
+    // Settle time before the next write; cut short when the request is superseded
+    void pause(int ms) { m_steps.append({ Write(), ms }); }
+
+    const QString& name() const { return m_name; }
+    int writes() const { return m_writes; }
+    bool isEmpty() const { return m_writes == 0; }
+
+private:
+    friend class LightingApplyWorker;
+
+    struct Step {
+        Write write;
+        int pauseMs;
+    };
+
+    QString m_name;
+    QVector<Step> m_steps;
+    int m_writes;
+};
+
+class LightingApplyWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    // device must outlive the worker
+    explicit LightingApplyWorker(LianLiQtIntegration* device, QObject* parent = nullptr);
+
+    // Cancels and waits for the write in progress
+    ~LightingApplyWorker();
+
+    // Queue a request and return its id. Whatever was queued or running before is
+    // superseded: finished() reports it cancelled.
+    int submit(LightingApplyRequest request);
+    void cancel();
+
+    bool isBusy() const { return m_busy.load(); }
+
+signals:
+    // Emitted from the worker thread; connect with the default (queued) connection
+    void progress(int id, int done, int total);
+    void finished(int id, bool ok, bool cancelled);
+
+private:
+    void run();
+    void execute(int id, const LightingApplyRequest& request);
+    bool superseded(int id) const;
+
+    LianLiQtIntegration* m_device;
+    QThread* m_thread;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    LightingApplyRequest m_pending;
+    int m_pendingId;            // 0 = nothing queued
+    bool m_quit;
+
+    std::atomic<int> m_latest;  // Newest id submitted (or cancelled); older ones stop
+    std::atomic<bool> m_busy;
+    int m_nextId;               // UI thread only
+};
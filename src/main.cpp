@@ -6,7 +6,13 @@
 #include <QIcon>
 #include <QDebug>
 #include <QSettings>
-#include "mainwindow.h"
+#include "apptray.h"
+#include "fancontrolservice.h"
+#include "sensors/sensorhub.h"
+#include "utils/trace.h"
+#include <QTimer>
+#include <cstring>
+#include <string>
 
 // Custom message handler to filter debug output based on settings
 void customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
@@ -46,6 +52,23 @@ void customMessageHandler(QtMsgType type, const QMessageLogContext &context, con
 
 int main(int argc, char *argv[])
 {
+    // --trace=<file>, or Settings > Record Performance Trace for the default path:
+    // spans from here to exit are written as a Chrome trace when the app quits
+    const int64_t launched = Trace::now();
+    std::string tracePath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            tracePath = argv[i] + 8;
+        }
+    }
+    if (tracePath.empty() && QSettings("LianLi", "LConnect3").value("Debug/Trace", false).toBool()) {
+        tracePath = Trace::defaultPath();
+    }
+    if (!tracePath.empty()) {
+        Trace::setThreadName("main");
+        Trace::start(tracePath, launched);
+    }
+    
     // High DPI scaling is enabled by default in Qt6
     QApplication app(argc, argv);
     
@@ -104,19 +127,55 @@ int main(int argc, char *argv[])
     
     app.setFont(appFont);
     
-    // Create and show main window
-    MainWindow window;
+    // Persistent telemetry log (ll-telemetry exports it); a few KB a minute
+    {
+        QSettings settings("LianLi", "LConnect3");
+        if (settings.value("Telemetry/LogEnabled", true).toBool()) {
+            SensorHub &hub = SensorHub::instance();
+            if (!hub.openLog(TelemetryLog::defaultDirectory())) {
+                qWarning() << "Telemetry log disabled:" << QString::fromStdString(hub.logError());
+            }
+        }
+    }
+    
+    if (Trace::enabled()) {
+        Trace::record("main: application setup", launched, Trace::now());
+    }
+    
+    // Fan control runs independently of the window so it carries on in the tray
+    FanControlService::instance().start();
+    
+    // Create and show main window; with the tray enabled and minimize on startup
+    // the window isn't built at all until it is opened from the tray
+    AppTray tray;
     bool minimizeOnStartup = false;
     {
         QSettings settings("LianLi", "LConnect3");
         minimizeOnStartup = settings.value("Startup/MinimizeOnStartup", false).toBool();
     }
 
-    if (minimizeOnStartup) {
-        window.showMinimized();
-    } else {
-        window.show();
+    if (!minimizeOnStartup) {
+        tray.showWindow();
+    } else if (!AppTray::trayEnabled()) {
+        tray.showWindow(true);
     }
     
-    return app.exec();
+    // Launch until the event loop first gets to run, i.e. the first frame is on its way
+    if (Trace::enabled()) {
+        Trace::record("main: launch to show", launched, Trace::now());
+        QTimer::singleShot(0, [launched]() {
+            Trace::record("main: launch to event loop", launched, Trace::now());
+        });
+    }
+    
+    int result = app.exec();
+    
+    if (Trace::enabled()) {
+        if (Trace::stop()) {
+            fprintf(stderr, "Trace written to %s\n", Trace::path().c_str());
+        } else {
+            qWarning() << "Trace not written:" << QString::fromStdString(Trace::error());
+        }
+    }
+    return result;
 }
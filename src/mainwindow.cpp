@@ -4,6 +4,7 @@
 #include "pages/fanprofilepage.h"
 #include "pages/lightingpage.h"
 #include "pages/settingspage.h"
+#include "utils/trace.h"
 #include <QApplication>
 #include <QStyleFactory>
 #include <QPalette>
@@ -19,6 +20,8 @@ MainWindow::MainWindow(QWidget *parent)
     , ui(new Ui::MainWindow)
     , m_currentPage(0)
 {
+    TRACE_SCOPE("MainWindow::MainWindow");
+    
     // Enable High DPI scaling for this window
     setAttribute(Qt::WA_NoSystemBackground, false);
     setAttribute(Qt::WA_OpaquePaintEvent, true);
@@ -66,6 +69,8 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 void MainWindow::setupUI()
 {
+    TRACE_SCOPE("MainWindow::setupUI");
+    
     // UI is already set up by ui->setupUi(this)
     // Now we need to connect signals and set up additional functionality
     
@@ -75,20 +80,17 @@ void MainWindow::setupUI()
     connect(ui->lightingBtn, &QPushButton::clicked, this, &MainWindow::onNavigationClicked);
     connect(ui->settingsBtn, &QPushButton::clicked, this, &MainWindow::onNavigationClicked);
     
-    // Create page instances
+    // Only the landing page is built up front; the others are created the first
+    // time they are shown, with an empty placeholder holding their slot until then
     m_systemInfoPage = new SystemInfoPage();
-    m_fanProfilePage = new FanProfilePage();
-    m_lightingPage = new LightingPage();
-    m_settingsPage = new SettingsPage();
-    
-    // Set up cross-page references
-    m_settingsPage->setLightingPage(m_lightingPage);
+    m_fanProfilePage = nullptr;
+    m_lightingPage = nullptr;
+    m_settingsPage = nullptr;
     
-    // Add pages to content stack
     ui->contentStack->addWidget(m_systemInfoPage);
-    ui->contentStack->addWidget(m_fanProfilePage);
-    ui->contentStack->addWidget(m_lightingPage);
-    ui->contentStack->addWidget(m_settingsPage);
+    for (int index = 1; index < 4; ++index) {
+        ui->contentStack->addWidget(new QWidget());
+    }
     
     // Set initial page
     ui->contentStack->setCurrentIndex(0);
@@ -236,38 +238,46 @@ void MainWindow::setupTopTabs()
     m_topLayout->addWidget(m_importBtn);
 }
 
-void MainWindow::setupMainContent()
+QWidget *MainWindow::ensurePage(int index)
 {
-    // Create content stack with proper size policy
-    m_contentStack = new QStackedWidget();
-    m_contentStack->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    
-    // Create pages
-    m_systemInfoPage = new SystemInfoPage();
-    m_fanProfilePage = new FanProfilePage();
-    m_lightingPage = new LightingPage();
-    m_settingsPage = new SettingsPage();
-    
-    // Add pages to stack
-    m_contentStack->addWidget(m_systemInfoPage);
-    m_contentStack->addWidget(m_fanProfilePage);
-    m_contentStack->addWidget(m_lightingPage);
-    m_contentStack->addWidget(m_settingsPage);
-    
-    // Create main content widget
-    QWidget *mainContentWidget = new QWidget();
-    QVBoxLayout *mainContentLayout = new QVBoxLayout(mainContentWidget);
-    mainContentLayout->setContentsMargins(0, 0, 0, 0);
-    mainContentLayout->setSpacing(0);
-    
-    // mainContentLayout->addWidget(m_topWidget); // Removed top bar section
-    mainContentLayout->addWidget(m_contentStack);
+    QWidget *page = nullptr;
+    switch (index) {
+    case 0:
+        return m_systemInfoPage;
+    case 1:
+        if (m_fanProfilePage) return m_fanProfilePage;
+        page = m_fanProfilePage = new FanProfilePage();
+        break;
+    case 2:
+        if (m_lightingPage) return m_lightingPage;
+        page = m_lightingPage = new LightingPage();
+        if (m_settingsPage) {
+            m_settingsPage->setLightingPage(m_lightingPage);
+        }
+        break;
+    case 3:
+        if (m_settingsPage) return m_settingsPage;
+        page = m_settingsPage = new SettingsPage();
+        // Without a Lighting page yet, a reset only has to clear the stored
+        // lighting settings, which the page loads when it is built
+        m_settingsPage->setLightingPage(m_lightingPage);
+        break;
+    default:
+        return nullptr;
+    }
     
-    m_mainLayout->addWidget(mainContentWidget);
+    // Swap the placeholder out for the real page
+    QWidget *placeholder = ui->contentStack->widget(index);
+    ui->contentStack->insertWidget(index, page);
+    ui->contentStack->removeWidget(placeholder);
+    placeholder->deleteLater();
+    return page;
 }
 
 void MainWindow::applyStyles()
 {
+    TRACE_SCOPE("MainWindow::applyStyles");
+    
     setStyleSheet(R"(
         QMainWindow {
             background-color: #050c1f;
@@ -435,20 +445,17 @@ void MainWindow::onNavigationClicked()
     // Check clicked button
     button->setChecked(true);
     
-    // Switch to corresponding page
+    // Switch to corresponding page, building it on first use
     if (button == ui->systemInfoBtn) {
-        ui->contentStack->setCurrentWidget(m_systemInfoPage);
         m_currentPage = 0;
     } else if (button == ui->fanProfileBtn) {
-        ui->contentStack->setCurrentWidget(m_fanProfilePage);
         m_currentPage = 1;
     } else if (button == ui->lightingBtn) {
-        ui->contentStack->setCurrentWidget(m_lightingPage);
         m_currentPage = 2;
     } else if (button == ui->settingsBtn) {
-        ui->contentStack->setCurrentWidget(m_settingsPage);
         m_currentPage = 3;
     }
+    ui->contentStack->setCurrentWidget(ensurePage(m_currentPage));
 }
 
 void MainWindow::onTabChanged(int index)
@@ -44,8 +44,8 @@ private:
     void setupUI();
     void setupSidebar();
     void setupTopTabs();
-    void setupMainContent();
     void applyStyles();
+    QWidget *ensurePage(int index);
     
     // UI Components
     QWidget *m_centralWidget;
@@ -72,10 +72,7 @@ private:
     QPushButton *m_exportBtn;
     QPushButton *m_importBtn;
     
-    // Main content
-    QStackedWidget *m_contentStack;
-    
-    // Pages
+    // Pages, null until built (see ensurePage)
     SystemInfoPage *m_systemInfoPage;
     FanProfilePage *m_fanProfilePage;
     LightingPage *m_lightingPage;
@@ -10,13 +10,17 @@
 #include <QComboBox>
 #include <QSlider>
 #include <QSpinBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QGroupBox>
 #include <QRadioButton>
 #include <QCheckBox>
+#include <QDoubleSpinBox>
 #include <QWidget>
 #include "widgets/fancurvewidget.h"
-#include "usb/lian_li_sl_infinity_controller.h"
+#include "widgets/fantablemodel.h"
+
+class FanControlService;
+class QTimer;
 
 class FanProfilePage : public QWidget
 {
@@ -34,6 +38,9 @@ private slots:
     void onPortSelectionChanged();
     void onFanSizeChanged(int port);
     void onRenameCustomProfile(int profileNum);
+    void onCalibrateClicked();
+    void onAcousticSettingsChanged();
+    void onZeroRpmChanged();
 
 private:
     void setupUI();
@@ -41,33 +48,9 @@ private:
     void setupFanCurve();
     void setupControls();
     void updateFanCurve();
-    void updateTemperature();
-    void updateFanRPMs();
-    void updateCPULoad();
-    void updateGPULoad();
-    int calculateRPMForTemperature(int temperature);
-    int calculateRPMForLoad(int temperature, int cpuLoad, int gpuLoad);
-    int getRealCPUTemperature();
-    int getRealCPULoad();
-    int getRealGPULoad();
-    QVector<int> getRealFanRPMs();
-    int getRealFanRPM(int port);
-    int convertPercentageToRPM(int percentage);
-    void controlFanSpeeds();
-    void setFanSpeed(int port, int speedPercent);
-    void updateFanTable();
-    bool isPortConnected(int port);
-    QColor getTemperatureColor(int temperature);
-    void saveCustomCurves();
-    void loadCustomCurves();
-    void saveCustomProfiles();
-    void loadCustomProfiles();
-    void savePortProfiles();
-    void loadPortProfiles();
-    QVector<QPointF> getDefaultCurveForProfile(const QString &profile);
-    int calculateRPMForCustomCurve(int port, int temperature);
+    void updateAcousticControls();
+    void updateZeroRpmControls();
     QString getCurrentProfile();
-    QString getInternalProfileName(const QString &displayName);
     // Fan detection functions removed - configuration is now in Settings
     
     QVBoxLayout *m_mainLayout;
@@ -76,7 +59,8 @@ private:
     QVBoxLayout *m_rightLayout;
     
     // Fan table
-    QTableWidget *m_fanTable;
+    QTableView *m_fanTable;
+    FanTableModel *m_fanTableModel;
     QVector<QComboBox*> m_fanSizeComboBoxes; // Size dropdown for each port
     
     // Fan curve
@@ -94,47 +78,26 @@ private:
     
     QPushButton *m_applyToAllButton;
     QPushButton *m_defaultButton;
+    QPushButton *m_calibrateButton;
     
-    // Current selected port (1-4)
-    int m_selectedPort;
+    // Acoustic-budget mode: hold a temperature ceiling with the quietest port mix
+    QCheckBox *m_acousticCheck;
+    QSpinBox *m_acousticMaxTempSpin;
+    QVector<QDoubleSpinBox*> m_acousticWeightSpins;
     
-    // Per-port custom curves (port 1-4 -> curve points)
-    QMap<int, QVector<QPointF>> m_customCurves;
+    // Zero RPM (semi-passive) mode for the selected port
+    QCheckBox *m_zeroRpmCheck;
+    QSpinBox *m_zeroRpmStopSpin;
+    QSpinBox *m_zeroRpmStartSpin;
     
-    // Per-port profile names (port 1-4 -> profile name like "Quiet", "StdSP", etc.)
-    QMap<int, QString> m_portProfiles;
+    // Current selected port (1-4)
+    int m_selectedPort;
     
-    // Custom profile names and base curves
-    QMap<int, QString> m_customProfileNames; // Profile 1-3 -> custom name
-    QMap<int, QVector<QPointF>> m_customProfileCurves; // Profile 1-3 -> base curve
+    // Curves, profiles, fan models and the control loop; outlives the page
+    FanControlService *m_service;
     
-    // Update timers
+    // The table and curve marker refresh at 5 Hz
     QTimer *m_updateTimer;
-    QTimer *m_tempUpdateTimer;
-    QTimer *m_fanRPMTimer;
-    QTimer *m_cpuLoadTimer;
-    QTimer *m_gpuLoadTimer;
-    
-    // Cached temperature for real-time updates
-    int m_cachedTemperature;
-    int m_temperatureCounter;
-    
-    // Cached CPU and GPU load
-    int m_cachedCPULoad;
-    int m_cachedGPULoad;
-    
-    // Cached fan RPMs
-    QVector<int> m_cachedFanRPMs;
-    
-    // Port detection
-    QVector<bool> m_portConnected;
-    QVector<int> m_activePorts;
-    
-    // Fan size per port (120mm = 2100 RPM, 140mm = 1600 RPM)
-    QMap<int, int> m_fanSizeMaxRPM;
-    
-    // HID controller for fan control
-    LianLiSLInfinityController *m_hidController;
 };
 
 #endif // FANPROFILEPAGE_H
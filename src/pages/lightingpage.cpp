@@ -1,7 +1,9 @@
 #include "lightingpage.h"
 #include "widgets/customslider.h"
 #include "lian_li_qt_integration.h"
+#include "lightingapplyworker.h"
 #include "utils/qtdebugutil.h"
+#include "utils/trace.h"
 #include <QFont>
 #include <QDebug>
 #include <QColorDialog>
@@ -9,7 +11,6 @@
 #include <QShowEvent>
 #include <QGridLayout>
 #include <QGroupBox>
-#include <QThread>
 
 LightingPage::LightingPage(QWidget *parent)
     : QWidget(parent)
@@ -19,7 +20,11 @@ LightingPage::LightingPage(QWidget *parent)
     , m_directionLeft(false)
     , m_selectedPort(-1)
     , m_lianLi(nullptr)
+    , m_applyWorker(nullptr)
+    , m_applyId(0)
 {
+    TRACE_SCOPE("LightingPage::LightingPage");
+    
     // Initialize port colors (2D array: [port][color_index])
     // All ports start with the same default color (white) for consistency
     QColor defaultColor(255, 255, 255);  // White
@@ -41,6 +46,11 @@ LightingPage::LightingPage(QWidget *parent)
     connect(m_lianLi, &LianLiQtIntegration::deviceConnected, this, &LightingPage::onDeviceConnected);
     connect(m_lianLi, &LianLiQtIntegration::deviceDisconnected, this, &LightingPage::onDeviceDisconnected);
     
+    // Effects are written from a worker thread so Apply never stalls the window
+    m_applyWorker = new LightingApplyWorker(m_lianLi, this);
+    connect(m_applyWorker, &LightingApplyWorker::progress, this, &LightingPage::onApplyProgress);
+    connect(m_applyWorker, &LightingApplyWorker::finished, this, &LightingPage::onApplyFinished);
+    
     setupUI();
     setupControls();
     // Load saved lighting settings
@@ -51,12 +61,18 @@ LightingPage::LightingPage(QWidget *parent)
     updatePortButtonStates();
     
     
-    // Try to initialize the device
-    if (m_lianLi->initialize()) {
-        onDeviceConnected();
-    } else {
+    // Open the device off the UI thread; onDeviceConnected() follows through
+    // the signal once it is ready
+    connect(m_lianLi, &LianLiQtIntegration::errorOccurred, this, [](const QString &) {
         DEBUG_LOG("Lian Li device not connected");
-    }
+    });
+    m_lianLi->initializeAsync();
+}
+
+LightingPage::~LightingPage()
+{
+    // Stop the worker before the integration it writes through goes away
+    delete m_applyWorker;
 }
 
 void LightingPage::setupUI()
@@ -503,7 +519,11 @@ void LightingPage::applyCurrentEffect()
         return;
     }
     
-    bool success = false;
+    // The writes run on the apply worker: snapshot the settings they use
+    const int speed = m_currentSpeed;
+    const int brightness = m_currentBrightness;
+    const bool directionLeft = m_directionLeft;
+    LightingApplyRequest request(m_currentEffect);
     
     DEBUG_LOG("Applying effect:", m_currentEffect, 
              "Speed:", m_currentSpeed, 
@@ -511,9 +531,9 @@ void LightingPage::applyCurrentEffect()
              "Direction:", (m_directionLeft ? "Left" : "Right"));
     
     if (m_currentEffect == "Rainbow Wave") {
-        success = m_lianLi->setRainbowEffect(m_currentSpeed, m_currentBrightness, m_directionLeft);
+        request.add([=](LianLiQtIntegration &device) { return device.setRainbowEffect(speed, brightness, directionLeft); });
     } else if (m_currentEffect == "Spectrum Cycle") {
-        success = m_lianLi->setRainbowMorphEffect(m_currentSpeed, m_currentBrightness);
+        request.add([=](LianLiQtIntegration &device) { return device.setRainbowMorphEffect(speed, brightness); });
     } else if (m_currentEffect == "Static") {
         // Static: One solid color per port - apply to selected port(s)
         int portsToApply[4] = {0, 1, 2, 3};
@@ -525,7 +545,6 @@ void LightingPage::applyCurrentEffect()
         }
         
         QColor currentColor = QColor(255, 0, 0);
-        success = true;  // Start optimistic - will be set to false if any channel fails
         
         for (int i = 0; i < portCount; i++) {
             int port = portsToApply[i];
@@ -547,21 +566,8 @@ void LightingPage::applyCurrentEffect()
                      "to color", portColor, "brightness", m_currentBrightness);
             
             // Send to both channels for this port (inner and outer rings)
-            bool channel1Success = m_lianLi->setChannelColor(channel1, portColor, m_currentBrightness);
-            bool channel2Success = m_lianLi->setChannelColor(channel2, portColor, m_currentBrightness);
-            
-            if (!channel1Success) {
-                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel1);
-                success = false;
-            }
-            if (!channel2Success) {
-                DEBUG_LOG("Failed to set Static for Port", (port + 1), "channel", channel2);
-                success = false;
-            }
-            
-            if (channel1Success && channel2Success) {
-                DEBUG_LOG("✓ Successfully set Port", (port + 1));
-            }
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelColor(channel1, portColor, brightness); });
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelColor(channel2, portColor, brightness); });
         }
     } else if (m_currentEffect == "Breathing") {
         // Breathing supports up to 6 colors per OpenRGB - apply to selected port(s)
@@ -582,11 +588,10 @@ void LightingPage::applyCurrentEffect()
             QColor portColor = m_portColors[port][0];
             if (!portColor.isValid()) portColor = currentColor;
             int channel = port * 2;
-            m_lianLi->setChannelBreathing(channel, portColor, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelBreathing(channel, portColor, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelBreathing(channel + 1, portColor, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelBreathing(channel + 1, portColor, speed, brightness); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Meteor") {
         // Meteor: One color per port (like Static/Breathing)
@@ -615,16 +620,15 @@ void LightingPage::applyCurrentEffect()
                      "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
                      "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
             
-            m_lianLi->setChannelMeteorWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
-            QThread::msleep(10);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelMeteorWithColors(channel, portColors, speed, brightness, false); });
+            request.pause(10);
             if (channel + 1 < 8) {
-                m_lianLi->setChannelMeteorWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelMeteorWithColors(channel + 1, portColors, speed, brightness, false); });
             }
-            QThread::msleep(50);
-            success = true;
+            request.pause(50);
         }
     } else if (m_currentEffect == "Voice") {
-        success = m_lianLi->setVoiceEffect(m_currentSpeed, m_currentBrightness);
+        request.add([=](LianLiQtIntegration &device) { return device.setVoiceEffect(speed, brightness); });
     } else if (m_currentEffect == "Groove") {
         int portsToApply[4] = {0, 1, 2, 3};
         int portCount = 4;
@@ -639,11 +643,10 @@ void LightingPage::applyCurrentEffect()
             QColor portColor = m_portColors[port][0];
             if (!portColor.isValid()) portColor = currentColor;
             int channel = port * 2;
-            m_lianLi->setChannelGroove(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelGroove(channel, portColor, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelGroove(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelGroove(channel + 1, portColor, speed, brightness, directionLeft); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Tunnel") {
         int portsToApply[4] = {0, 1, 2, 3};
@@ -663,11 +666,10 @@ void LightingPage::applyCurrentEffect()
             if (!portColors[1].isValid()) portColors[1] = currentColor;
             if (!portColors[2].isValid()) portColors[2] = currentColor;
             if (!portColors[3].isValid()) portColors[3] = currentColor;
-            m_lianLi->setChannelTunnel(channel, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelTunnel(channel, portColors, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelTunnel(channel + 1, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelTunnel(channel + 1, portColors, speed, brightness, directionLeft); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Staggered") {
         int portsToApply[4] = {0, 1, 2, 3};
@@ -684,11 +686,10 @@ void LightingPage::applyCurrentEffect()
             QColor portColors[2] = {m_portColors[port][0], m_portColors[port][1]};
             if (!portColors[0].isValid()) portColors[0] = currentColor;
             if (!portColors[1].isValid()) portColors[1] = currentColor;
-            m_lianLi->setChannelStaggered(channel, portColors, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelStaggered(channel, portColors, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelStaggered(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelStaggered(channel + 1, portColors, speed, brightness); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Tide") {
         int portsToApply[4] = {0, 1, 2, 3};
@@ -704,11 +705,10 @@ void LightingPage::applyCurrentEffect()
             
             QColor portColors[2] = {m_portColors[port][0], m_portColors[port][1]};
             int channel = port * 2;
-            m_lianLi->setChannelTide(channel, portColors, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelTide(channel, portColors, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelTide(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelTide(channel + 1, portColors, speed, brightness); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Runway") {
         // Runway: One color per port (like Static/Breathing/Meteor/Mixing/Neon)
@@ -733,11 +733,10 @@ void LightingPage::applyCurrentEffect()
             QColor portColors[2] = {portColor, portColor};
             
             int channel = port * 2;
-            m_lianLi->setChannelRunwayWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelRunwayWithColors(channel, portColors, speed, brightness, false); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelRunwayWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelRunwayWithColors(channel + 1, portColors, speed, brightness, false); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Mixing") {
         // Mixing: One color per port (like Static/Breathing/Meteor)
@@ -766,13 +765,12 @@ void LightingPage::applyCurrentEffect()
                      "Color(RGB):", portColor.red(), portColor.green(), portColor.blue(),
                      "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
             
-            m_lianLi->setChannelMixing(channel, portColors, m_currentSpeed, m_currentBrightness);
-            QThread::msleep(10);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelMixing(channel, portColors, speed, brightness); });
+            request.pause(10);
             if (channel + 1 < 8) {
-                m_lianLi->setChannelMixing(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelMixing(channel + 1, portColors, speed, brightness); });
             }
-            QThread::msleep(50);
-            success = true;
+            request.pause(50);
         }
     } else if (m_currentEffect == "Stack") {
         // Stack: One color per port (like Static/Breathing/Meteor/Mixing/Neon/Runway)
@@ -794,11 +792,10 @@ void LightingPage::applyCurrentEffect()
             if (!portColor.isValid()) portColor = currentColor;
             
             int channel = port * 2;
-            m_lianLi->setChannelStack(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelStack(channel, portColor, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelStack(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelStack(channel + 1, portColor, speed, brightness, directionLeft); });
             }
-            success = true;
         }
     } else if (m_currentEffect == "Neon") {
         // Neon: One color per port (like Static/Breathing/Meteor)
@@ -825,17 +822,44 @@ void LightingPage::applyCurrentEffect()
                      "Speed:", m_currentSpeed, "Brightness:", m_currentBrightness);
             
             // Use setChannelEffect with Neon mode (0x22) and the port color
-            m_lianLi->setChannelEffect(channel, 0x22, portColor, m_currentSpeed, m_currentBrightness, false);
-            QThread::msleep(10);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelEffect(channel, 0x22, portColor, speed, brightness, false); });
+            request.pause(10);
             if (channel + 1 < 8) {
-                m_lianLi->setChannelEffect(channel + 1, 0x22, portColor, m_currentSpeed, m_currentBrightness, false);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelEffect(channel + 1, 0x22, portColor, speed, brightness, false); });
             }
-            QThread::msleep(50);
-            success = true;
+            request.pause(50);
         }
     }
     
-    if (success) {
+    if (request.isEmpty()) {
+        DEBUG_LOG("✗ Failed to apply effect:", m_currentEffect, "- no enabled ports");
+        return;
+    }
+    
+    // Supersedes an apply that is still running; onApplyFinished() reports the outcome
+    m_applyId = m_applyWorker->submit(request);
+}
+
+void LightingPage::onApplyProgress(int id, int done, int total)
+{
+    if (id != m_applyId) {
+        return;
+    }
+    m_applyBtn->setText(QString("Applying %1/%2").arg(done).arg(total));
+}
+
+void LightingPage::onApplyFinished(int id, bool ok, bool cancelled)
+{
+    if (id != m_applyId) {
+        return;
+    }
+    m_applyId = 0;
+    m_applyBtn->setText("Apply");
+    
+    if (cancelled) {
+        return;
+    }
+    if (ok) {
         DEBUG_LOG("✓ Successfully applied effect:", m_currentEffect);
     } else {
         DEBUG_LOG("✗ Failed to apply effect:", m_currentEffect);
@@ -13,6 +13,7 @@
 
 class CustomSlider;
 class LianLiQtIntegration;
+class LightingApplyWorker;
 
 class LightingPage : public QWidget
 {
@@ -20,6 +21,7 @@ class LightingPage : public QWidget
 
 public:
     explicit LightingPage(QWidget *parent = nullptr);
+    ~LightingPage();
     void resetToDefaults();
 
 protected:
@@ -34,6 +36,8 @@ private slots:
     void onDeviceConnected();
     void onDeviceDisconnected();
     void onColorButtonClicked();
+    void onApplyProgress(int id, int done, int total);
+    void onApplyFinished(int id, bool ok, bool cancelled);
 
 private:
     void setupUI();
@@ -85,6 +89,10 @@ private:
     
     // Lian Li integration
     LianLiQtIntegration *m_lianLi;
+    
+    // Device writes run here; a new apply supersedes one still in flight
+    LightingApplyWorker *m_applyWorker;
+    int m_applyId;          // Latest apply submitted, 0 = none
 };
 
 #endif // LIGHTINGPAGE_H
@@ -1,5 +1,7 @@
 #include "settingspage.h"
 #include "lightingpage.h"
+#include "apptray.h"
+#include "utils/trace.h"
 #include <QSettings>
 #include <QFile>
 #include <QTextStream>
@@ -10,6 +12,7 @@ SettingsPage::SettingsPage(QWidget *parent)
     : QWidget(parent)
     , m_lightingPage(nullptr)
 {
+    TRACE_SCOPE("SettingsPage::SettingsPage");
     setupUI();
     setupBehaviorSettings();
     setupFanConfiguration();
@@ -124,6 +127,21 @@ void SettingsPage::setupBehaviorSettings()
     });
     behaviorLayout->addWidget(m_minimizeOnStartupCheck);
 
+    // Closing the window then frees the whole UI; fan control carries on
+    m_trayCheck = new QCheckBox("Keep running in the system tray when closed");
+    m_trayCheck->setObjectName("settingsCheck");
+    m_trayCheck->setChecked(settings.value("Tray/Enabled", false).toBool());
+    m_trayCheck->setEnabled(QSystemTrayIcon::isSystemTrayAvailable());
+    connect(m_trayCheck, &QCheckBox::toggled, this, [](bool checked) {
+        QSettings settings("LianLi", "LConnect3");
+        settings.setValue("Tray/Enabled", checked);
+        settings.sync();
+        if (AppTray *tray = AppTray::instance()) {
+            tray->setEnabled(checked);
+        }
+    });
+    behaviorLayout->addWidget(m_trayCheck);
+
     m_leftLayout->addWidget(m_behaviorGroup);
 }
 
@@ -203,6 +221,7 @@ void SettingsPage::onResetAll()
     m_debugFanSpeedsCheck->setChecked(false);
     m_debugFanLightsCheck->setChecked(false);
     m_kernelLoggingCheck->setChecked(false);
+    m_traceCheck->setChecked(false);
     
     // Reset fan configuration to all enabled
     m_fanPort1Check->setChecked(true);
@@ -405,6 +424,7 @@ void SettingsPage::setupDebugSettings()
     bool debugFanSpeeds = settings.value("Debug/FanSpeeds", false).toBool();
     bool debugFanLights = settings.value("Debug/FanLights", false).toBool();
     bool kernelLogs = settings.value("Debug/KernelLogs", false).toBool();
+    bool trace = settings.value("Debug/Trace", false).toBool();
     
     // Debug mode checkbox (master control)
     m_debugModeCheck = new QCheckBox("Enable Debug Mode");
@@ -482,6 +502,21 @@ void SettingsPage::setupDebugSettings()
     
     debugLayout->addWidget(m_kernelLoggingCheck);
     
+    // Performance trace, independent of debug mode; read once at startup
+    m_traceCheck = new QCheckBox("Record Performance Trace (from next start)");
+    m_traceCheck->setObjectName("settingsCheck");
+    m_traceCheck->setChecked(trace);
+    m_traceCheck->setToolTip(QString("Written to %1 on exit; open it in ui.perfetto.dev or chrome://tracing")
+                             .arg(QString::fromStdString(Trace::defaultPath())));
+    
+    connect(m_traceCheck, &QCheckBox::toggled, [](bool checked) {
+        QSettings settings("LianLi", "LConnect3");
+        settings.setValue("Debug/Trace", checked);
+        settings.sync();
+    });
+    
+    debugLayout->addWidget(m_traceCheck);
+    
     // Info label
     QLabel *infoLabel = new QLabel("When enabled, detailed diagnostic information will be printed to the console. You can enable specific debug categories below. Kernel driver logging writes to dmesg and is off by default.");
     infoLabel->setObjectName("infoLabel");
@@ -50,6 +50,7 @@ private:
     // Behavior settings
     QGroupBox *m_behaviorGroup;
     QCheckBox *m_minimizeOnStartupCheck;
+    QCheckBox *m_trayCheck;
     
     // Fan configuration
     QGroupBox *m_fanConfigGroup;
@@ -64,6 +65,7 @@ private:
     QCheckBox *m_debugFanSpeedsCheck;
     QCheckBox *m_debugFanLightsCheck;
     QCheckBox *m_kernelLoggingCheck;
+    QCheckBox *m_traceCheck;
     
     // Action buttons
     QPushButton *m_resetAllBtn;
@@ -1,10 +1,11 @@
 #include "slinfinitypage.h"
 #include "widgets/fanwidget.h"
 #include "lian_li_qt_integration.h"
+#include "lightingapplyworker.h"
+#include "utils/trace.h"
 #include <QTimer>
 #include <QColorDialog>
 #include <QMessageBox>
-#include <QThread>
 #include <QSettings>
 
 SLInfinityPage::SLInfinityPage(QWidget *parent)
@@ -16,11 +17,15 @@ SLInfinityPage::SLInfinityPage(QWidget *parent)
     , m_directionLeft(false)
     , m_selectedPort(-1) // No port selected initially
     , m_lianLi(nullptr)
+    , m_applyWorker(nullptr)
+    , m_applyId(0)
     , m_colorButton(nullptr)
     , m_statusLabel(nullptr)
     , m_statusTimer(nullptr)
     , m_multiColorWidget(nullptr)
 {
+    TRACE_SCOPE("SLInfinityPage::SLInfinityPage");
+    
     // Initialize port colors with defaults
     for (int port = 0; port < 4; port++) {
         m_portColors[port][0] = QColor(255, 0, 0);      // Red
@@ -39,6 +44,11 @@ SLInfinityPage::SLInfinityPage(QWidget *parent)
     connect(m_lianLi, &LianLiQtIntegration::deviceConnected, this, &SLInfinityPage::onDeviceConnected);
     connect(m_lianLi, &LianLiQtIntegration::deviceDisconnected, this, &SLInfinityPage::onDeviceDisconnected);
     
+    // Effects are written from a worker thread so applying never stalls the window
+    m_applyWorker = new LightingApplyWorker(m_lianLi, this);
+    connect(m_applyWorker, &LightingApplyWorker::progress, this, &SLInfinityPage::onApplyProgress);
+    connect(m_applyWorker, &LightingApplyWorker::finished, this, &SLInfinityPage::onApplyFinished);
+    
     setupUI();
     setupFanVisualization();
     setupControls();
@@ -48,12 +58,15 @@ SLInfinityPage::SLInfinityPage(QWidget *parent)
     
     updateFanVisualization();
     
-    // Try to initialize the device
-    if (m_lianLi->initialize()) {
-        onDeviceConnected();
-    } else {
-        onDeviceDisconnected();
-    }
+    // Shown as disconnected until the device has been opened off the UI thread
+    onDeviceDisconnected();
+    m_lianLi->initializeAsync();
+}
+
+SLInfinityPage::~SLInfinityPage()
+{
+    // Stop the worker before the integration it writes through goes away
+    delete m_applyWorker;
 }
 
 void SLInfinityPage::setupUI()
@@ -538,6 +551,12 @@ void SLInfinityPage::applyCurrentEffect()
         return;
     }
     
+    // The writes run on the apply worker: snapshot the settings they use
+    const int speed = m_currentSpeed;
+    const int brightness = m_currentBrightness;
+    const bool directionLeft = m_directionLeft;
+    LightingApplyRequest request(m_currentEffect);
+    
     QColor currentColor = m_colorButton->palette().button().color();
     if (!currentColor.isValid()) {
         currentColor = QColor(255, 0, 0); // Default red
@@ -572,13 +591,13 @@ void SLInfinityPage::applyCurrentEffect()
             // Apply Static mode with 4 colors (one per fan) to both channels
             // Both channels (inner and outer rings) should get the same 4 colors
             // This ensures each fan is a solid color (both inner and outer match)
-            m_lianLi->setChannelStaticWithFanColors(channel, fanColors, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelStaticWithFanColors(channel, fanColors, brightness); });
             // Increased delay between channels to ensure proper synchronization
             // The hardware may need time to process the first channel before accepting the second
-            QThread::msleep(50);
+            request.pause(50);
             if (channel + 1 < 8) {
-                m_lianLi->setChannelStaticWithFanColors(channel + 1, fanColors, m_currentBrightness);
-                QThread::msleep(50); // Additional delay after second channel
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelStaticWithFanColors(channel + 1, fanColors, brightness); });
+                request.pause(50); // Additional delay after second channel
             }
         }
     } else if (m_currentEffect == "Breathing") {
@@ -596,15 +615,15 @@ void SLInfinityPage::applyCurrentEffect()
             QColor portColor = m_portColors[port][0];
             if (!portColor.isValid()) portColor = currentColor;
             int channel = port * 2;
-            m_lianLi->setChannelBreathing(channel, portColor, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelBreathing(channel, portColor, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelBreathing(channel + 1, portColor, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelBreathing(channel + 1, portColor, speed, brightness); });
             }
         }
     } else if (m_currentEffect == "Spectrum Cycle") {
-        m_lianLi->setRainbowMorphEffect(m_currentSpeed, m_currentBrightness);
+        request.add([=](LianLiQtIntegration &device) { return device.setRainbowMorphEffect(speed, brightness); });
     } else if (m_currentEffect == "Rainbow Wave") {
-        m_lianLi->setRainbowEffect(m_currentSpeed, m_currentBrightness, m_directionLeft);
+        request.add([=](LianLiQtIntegration &device) { return device.setRainbowEffect(speed, brightness, directionLeft); });
     } else if (m_currentEffect == "Staggered") {
         // Staggered needs 2 colors per port - apply to selected port(s)
         int portsToApply[4] = {0, 1, 2, 3};
@@ -622,9 +641,9 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[0].isValid()) portColors[0] = currentColor;
             if (!portColors[1].isValid()) portColors[1] = currentColor;
             // Staggered does NOT have direction control per OpenRGB
-            m_lianLi->setChannelStaggered(channel, portColors, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelStaggered(channel, portColors, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelStaggered(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelStaggered(channel + 1, portColors, speed, brightness); });
             }
         }
     } else if (m_currentEffect == "Tide") {
@@ -643,9 +662,9 @@ void SLInfinityPage::applyCurrentEffect()
             QColor portColors[2] = {m_portColors[port][0], m_portColors[port][1]};
             if (!portColors[0].isValid()) portColors[0] = QColor(255, 0, 0);
             if (!portColors[1].isValid()) portColors[1] = QColor(0, 0, 255);
-            m_lianLi->setChannelTide(channel, portColors, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelTide(channel, portColors, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelTide(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelTide(channel + 1, portColors, speed, brightness); });
             }
         }
     } else if (m_currentEffect == "Runway") {
@@ -665,9 +684,9 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[0].isValid()) portColors[0] = QColor(255, 200, 100);
             if (!portColors[1].isValid()) portColors[1] = QColor(255, 200, 100);
             // Runway does NOT have direction control per OpenRGB
-            m_lianLi->setChannelRunwayWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelRunwayWithColors(channel, portColors, speed, brightness, false); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelRunwayWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelRunwayWithColors(channel + 1, portColors, speed, brightness, false); });
             }
         }
     } else if (m_currentEffect == "Mixing") {
@@ -687,9 +706,9 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[0].isValid()) portColors[0] = currentColor;
             if (!portColors[1].isValid()) portColors[1] = currentColor;
             // Mixing does NOT have direction control per OpenRGB
-            m_lianLi->setChannelMixing(channel, portColors, m_currentSpeed, m_currentBrightness);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelMixing(channel, portColors, speed, brightness); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelMixing(channel + 1, portColors, m_currentSpeed, m_currentBrightness);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelMixing(channel + 1, portColors, speed, brightness); });
             }
         }
     } else if (m_currentEffect == "Stack") {
@@ -707,13 +726,13 @@ void SLInfinityPage::applyCurrentEffect()
             QColor portColor = m_portColors[port][0];
             if (!portColor.isValid()) portColor = currentColor;
             int channel = port * 2;
-            m_lianLi->setChannelStack(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelStack(channel, portColor, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelStack(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelStack(channel + 1, portColor, speed, brightness, directionLeft); });
             }
         }
     } else if (m_currentEffect == "Neon") {
-        m_lianLi->setNeonEffect(m_currentSpeed, m_currentBrightness);
+        request.add([=](LianLiQtIntegration &device) { return device.setNeonEffect(speed, brightness); });
     } else if (m_currentEffect == "ColorCycle") {
         // ColorCycle needs 3 colors per port - apply to selected port(s)
         int portsToApply[4] = {0, 1, 2, 3};
@@ -731,9 +750,9 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[0].isValid()) portColors[0] = QColor(255, 0, 0);
             if (!portColors[1].isValid()) portColors[1] = QColor(0, 255, 0);
             if (!portColors[2].isValid()) portColors[2] = QColor(0, 0, 255);
-            m_lianLi->setChannelColorCycle(channel, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelColorCycle(channel, portColors, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelColorCycle(channel + 1, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelColorCycle(channel + 1, portColors, speed, brightness, directionLeft); });
             }
         }
     } else if (m_currentEffect == "Meteor") {
@@ -753,13 +772,13 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[0].isValid()) portColors[0] = QColor(255, 0, 0);
             if (!portColors[1].isValid()) portColors[1] = QColor(0, 0, 255);
             // Meteor does NOT have direction control per OpenRGB
-            m_lianLi->setChannelMeteorWithColors(channel, portColors, m_currentSpeed, m_currentBrightness, false);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelMeteorWithColors(channel, portColors, speed, brightness, false); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelMeteorWithColors(channel + 1, portColors, m_currentSpeed, m_currentBrightness, false);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelMeteorWithColors(channel + 1, portColors, speed, brightness, false); });
             }
         }
     } else if (m_currentEffect == "Voice") {
-        m_lianLi->setVoiceEffect(m_currentSpeed, m_currentBrightness);
+        request.add([=](LianLiQtIntegration &device) { return device.setVoiceEffect(speed, brightness); });
     } else if (m_currentEffect == "Groove") {
         // Groove needs 1 color per port - apply to selected port(s)
         int portsToApply[4] = {0, 1, 2, 3};
@@ -775,9 +794,9 @@ void SLInfinityPage::applyCurrentEffect()
             QColor portColor = m_portColors[port][0];
             if (!portColor.isValid()) portColor = currentColor;
             int channel = port * 2;
-            m_lianLi->setChannelGroove(channel, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelGroove(channel, portColor, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelGroove(channel + 1, portColor, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelGroove(channel + 1, portColor, speed, brightness, directionLeft); });
             }
         }
     } else if (m_currentEffect == "Tunnel") {
@@ -799,12 +818,17 @@ void SLInfinityPage::applyCurrentEffect()
             if (!portColors[1].isValid()) portColors[1] = currentColor;
             if (!portColors[2].isValid()) portColors[2] = currentColor;
             if (!portColors[3].isValid()) portColors[3] = currentColor;
-            m_lianLi->setChannelTunnel(channel, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+            request.add([=](LianLiQtIntegration &device) { return device.setChannelTunnel(channel, portColors, speed, brightness, directionLeft); });
             if (channel + 1 < 8) {
-                m_lianLi->setChannelTunnel(channel + 1, portColors, m_currentSpeed, m_currentBrightness, m_directionLeft);
+                request.add([=](LianLiQtIntegration &device) { return device.setChannelTunnel(channel + 1, portColors, speed, brightness, directionLeft); });
             }
         }
     }
+    
+    if (!request.isEmpty()) {
+        // Supersedes an apply that is still running; onApplyFinished() reports the outcome
+        m_applyId = m_applyWorker->submit(request);
+    }
 }
 
 void SLInfinityPage::onSpeedChanged(int value)
@@ -900,31 +924,59 @@ void SLInfinityPage::onColorButtonClicked()
             }
         }
         
-        // Apply current effect with new color
+        // Apply current effect with new color; onApplyFinished() reports the result
         applyCurrentEffect();
         
         // Save settings when color changes
         saveLightingSettings();
-        
-        if (m_lianLi->isConnected()) {
-            m_statusLabel->setText("✓ Color applied successfully!");
-            m_statusLabel->setStyleSheet("color: green; font-weight: bold;");
-        } else {
-            m_statusLabel->setText("✗ Failed to apply color");
-            m_statusLabel->setStyleSheet("color: red; font-weight: bold;");
-        }
-        
-        // Clear status after 3 seconds
-        if (m_statusTimer) {
-            m_statusTimer->stop();
-        }
+    }
+}
+
+void SLInfinityPage::onApplyProgress(int id, int done, int total)
+{
+    if (id != m_applyId) {
+        return;
+    }
+    showStatus(QString("Applying %1... %2/%3").arg(m_currentEffect).arg(done).arg(total), "color: #cccccc;", false);
+}
+
+void SLInfinityPage::onApplyFinished(int id, bool ok, bool cancelled)
+{
+    if (id != m_applyId) {
+        return;
+    }
+    m_applyId = 0;
+    
+    if (cancelled) {
+        return;
+    }
+    if (ok) {
+        showStatus("✓ " + m_currentEffect + " applied successfully!", "color: green; font-weight: bold;", true);
+    } else {
+        showStatus("✗ Failed to apply " + m_currentEffect, "color: red; font-weight: bold;", true);
+    }
+}
+
+void SLInfinityPage::showStatus(const QString &text, const QString &style, bool transient)
+{
+    if (!m_statusLabel) {
+        return;
+    }
+    m_statusLabel->setText(text);
+    m_statusLabel->setStyleSheet(style);
+    
+    // Clear transient messages after 3 seconds
+    if (!m_statusTimer) {
         m_statusTimer = new QTimer(this);
         m_statusTimer->setSingleShot(true);
         m_statusTimer->setInterval(3000);
-        connect(m_statusTimer, &QTimer::timeout, [this]() {
+        connect(m_statusTimer, &QTimer::timeout, this, [this]() {
             m_statusLabel->setText("");
             m_statusLabel->setStyleSheet("");
         });
+    }
+    m_statusTimer->stop();
+    if (transient) {
         m_statusTimer->start();
     }
 }
@@ -16,6 +16,7 @@
 
 class FanWidget;
 class LianLiQtIntegration;
+class LightingApplyWorker;
 
 class SLInfinityPage : public QWidget
 {
@@ -23,6 +24,7 @@ class SLInfinityPage : public QWidget
 
 public:
     explicit SLInfinityPage(QWidget *parent = nullptr);
+    ~SLInfinityPage();
 
 private slots:
     void onEffectChanged();
@@ -34,6 +36,8 @@ private slots:
     void onColorButtonClicked();
     void onDeviceConnected();
     void onDeviceDisconnected();
+    void onApplyProgress(int id, int done, int total);
+    void onApplyFinished(int id, bool ok, bool cancelled);
 
 private:
     void setupUI();
@@ -46,6 +50,7 @@ private:
     void saveLightingSettings();
     void loadLightingSettings();
     void clearOldEffectSettings(const QString &oldEffect, const QString &newEffect);
+    void showStatus(const QString &text, const QString &style, bool transient);
     
     QVBoxLayout *m_mainLayout;
     QHBoxLayout *m_headerLayout;
@@ -87,6 +92,8 @@ private:
     
     // Lian Li integration
     LianLiQtIntegration *m_lianLi;
+    LightingApplyWorker *m_applyWorker;     // Device writes; a new apply supersedes one in flight
+    int m_applyId;                          // Latest apply submitted, 0 = none
     QPushButton *m_colorButton;
     QPushButton *m_colorButtons[4]; // For multiple color selection (Tide: 2, ColorCycle: 3)
     QLabel *m_colorLabel;
@@ -1,23 +1,52 @@
 #include "systeminfopage.h"
 #include "widgets/monitoringcard.h"
+#include "widgets/coreheatstrip.h"
+#include "utils/uischeduler.h"
+#include "utils/trace.h"
 #include <QFont>
-#include <QProcess>
 #include <QFile>
 #include <QTextStream>
 #include <QDir>
-#include <QRegularExpression>
 #include <QtMath>
 #include <algorithm>
+#include <cmath>
 #include <QTimer>
 #include <QDateTime>
 
-// Initialize static variables
-qint64 SystemInfoPage::m_prevEnergyUJ = 0;
-qint64 SystemInfoPage::m_prevTimestamp = 0;
+// df -h style: 1024-based, one decimal below 10 ("9.5G", "466G")
+static QString formatSize(double bytes)
+{
+    static const char *units[] = { "B", "K", "M", "G", "T", "P" };
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 5) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    return QString::number(bytes, 'f', bytes < 10.0 && unit > 0 ? 1 : 0) + units[unit];
+}
+
+// Same units as the network card
+static QString formatRate(double bytesPerSecond)
+{
+    if (bytesPerSecond >= 1024 * 1024) {
+        return QString::number(bytesPerSecond / (1024.0 * 1024.0), 'f', 1) + " MB/s";
+    } else if (bytesPerSecond >= 1024) {
+        return QString::number(bytesPerSecond / 1024.0, 'f', 1) + " KB/s";
+    }
+    return QString::number(static_cast<long>(bytesPerSecond)) + " B/s";
+}
 
 SystemInfoPage::SystemInfoPage(QWidget *parent)
     : QWidget(parent)
+    , m_cpuInfoFile("/proc/cpuinfo", 65536)
+    , m_memInfoFile("/proc/meminfo")
+    , m_netDevFile("/proc/net/dev")
+    , m_netDevices(16)
+    , m_cpuClockMHz(0.0)
+    , m_cpuVoltageResolved(false)
 {
+    TRACE_SCOPE("SystemInfoPage::SystemInfoPage");
+    
     setupUI();
     createMonitoringCards();
     
@@ -25,6 +54,7 @@ SystemInfoPage::SystemInfoPage(QWidget *parent)
     m_updateTimer = new QTimer(this);
     connect(m_updateTimer, &QTimer::timeout, this, &SystemInfoPage::updateSystemInfo);
     m_updateTimer->start(1000); // Update every second
+    UiScheduler::instance().addTimer(m_updateTimer, this, UiScheduler::Visual);
     
     // Initial update
     updateSystemInfo();
@@ -229,6 +259,14 @@ void SystemInfoPage::createMonitoringCards()
     cpuGrid->setColumnStretch(0, 2);
     cpuGrid->setColumnStretch(1, 1);
     cpuPanelLayout->addLayout(cpuGrid);
+
+    // One cell per logical CPU: a single saturated thread shows even when the average is low
+    m_coreStrip = new CoreHeatStrip();
+    QHBoxLayout *coreStripLine = new QHBoxLayout();
+    coreStripLine->setContentsMargins(8, 0, 8, 0);
+    coreStripLine->addWidget(m_coreStrip);
+    cpuPanelLayout->addLayout(coreStripLine);
+
     m_contentGrid->addWidget(cpuPanel, 0, 0);
 
     // GPU panel with proper size policy
@@ -421,6 +459,11 @@ void SystemInfoPage::createMonitoringCards()
 
 void SystemInfoPage::updateSystemInfo()
 {
+    TRACE_SCOPE("SystemInfoPage::updateSystemInfo");
+    
+    // CPU/GPU sensors are sampled by the shared hub; take its latest snapshot
+    m_sensors = SensorHub::instance().latest();
+    
     // Get real system data
     updateCPUInfo();
     updateGPUInfo();
@@ -431,122 +474,20 @@ void SystemInfoPage::updateSystemInfo()
 
 void SystemInfoPage::updateCPUInfo()
 {
-    // CPU Load from /proc/stat (real-time CPU usage)
-    static long prevIdle = 0, prevTotal = 0;
-    
-    QFile statFile("/proc/stat");
-    if (statFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&statFile);
-        QString line = stream.readLine();
-        
-        if (line.startsWith("cpu ")) {
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 8) {
-                // Parse CPU times: user, nice, system, idle, iowait, irq, softirq, steal
-                long user = parts[1].toLong();
-                long nice = parts[2].toLong();
-                long system = parts[3].toLong();
-                long idle = parts[4].toLong();
-                long iowait = parts[5].toLong();
-                long irq = parts[6].toLong();
-                long softirq = parts[7].toLong();
-                long steal = parts.size() > 8 ? parts[8].toLong() : 0;
-                
-                long totalIdle = idle + iowait;
-                long total = user + nice + system + totalIdle + irq + softirq + steal;
-                
-                if (prevTotal > 0) {
-                    long totalDiff = total - prevTotal;
-                    long idleDiff = totalIdle - prevIdle;
-                    
-                    if (totalDiff > 0) {
-                        int cpuLoad = static_cast<int>(((totalDiff - idleDiff) * 100) / totalDiff);
-                        cpuLoad = std::max(0, std::min(100, cpuLoad)); // Clamp between 0-100
-                        
-                        m_cpuLoadCard->setProgress(cpuLoad);
-                        m_cpuLoadCard->setValue(QString::number(cpuLoad) + "%");
-                        m_cpuLoadCard->setSubValue("CPU LOAD");
-                    }
-                }
-                
-                prevIdle = totalIdle;
-                prevTotal = total;
-            }
-        }
-        statFile.close();
-    }
-    
-    // CPU Temperature - try sensors command first (most accurate)
-    int maxTemp = 0;
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "k10temp-pci-00c3");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for Tctl temperature (CPU core temperature)
-        QRegularExpression tempRegex("Tctl:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            maxTemp = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Fallback: try hwmon if sensors didn't work
-    if (maxTemp == 0) {
-        QDir hwmonDir("/sys/class/hwmon");
-        QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    // CPU Load (busy share of all CPUs, from the sensor hub)
+    if (m_sensors && !std::isnan(m_sensors->cpuUtilization)) {
+        int cpuLoad = static_cast<int>(std::lround(m_sensors->cpuUtilization * 100.0));
+        cpuLoad = std::max(0, std::min(100, cpuLoad)); // Clamp between 0-100
         
-        for (const QString &hwmon : hwmonDirs) {
-            QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
-            if (nameFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&nameFile);
-                QString name = stream.readLine().trimmed();
-                nameFile.close();
-                
-                // Check for CPU temperature sensors
-                if (name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") || 
-                    name.contains("asus") || name.contains("acpi")) {
-                    
-                    QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
-                    QStringList files = hwmonSubDir.entryList(QDir::Files);
-                    for (const QString &file : files) {
-                        if (file.startsWith("temp") && file.endsWith("_input")) {
-                            QFile tempFile("/sys/class/hwmon/" + hwmon + "/" + file);
-                            if (tempFile.open(QIODevice::ReadOnly)) {
-                                QTextStream tStream(&tempFile);
-                                QString tempStr = tStream.readLine();
-                                if (!tempStr.isEmpty()) {
-                                    int temp = tempStr.toInt() / 1000; // Convert millidegrees to degrees
-                                    if (temp > maxTemp && temp < 200) { // Reasonable temperature range
-                                        maxTemp = temp;
-                                    }
-                                }
-                                tempFile.close();
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        m_cpuLoadCard->setProgress(cpuLoad);
+        m_cpuLoadCard->setValue(QString::number(cpuLoad) + "%");
+        m_cpuLoadCard->setSubValue("CPU LOAD");
     }
     
-    // Fallback: try thermal zones if hwmon didn't work
-    if (maxTemp == 0) {
-        QDir thermalDir("/sys/class/thermal");
-        QStringList thermalZones = thermalDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (const QString &zone : thermalZones) {
-            if (zone.startsWith("thermal_zone")) {
-                QFile tempFile("/sys/class/thermal/" + zone + "/temp");
-                if (tempFile.open(QIODevice::ReadOnly)) {
-                    QTextStream stream(&tempFile);
-                    int temp = stream.readLine().toInt() / 1000; // Convert millidegrees to degrees
-                    if (temp > maxTemp) maxTemp = temp;
-                    tempFile.close();
-                }
-            }
-        }
-    }
+    // CPU Temperature - k10temp Tctl / zenpower / coretemp package, else the hottest
+    // CPU hwmon input, else the thermal zones (resolved once, then one read per tick)
+    double cpuTemp = m_sensors ? m_sensors->cpuTemperature : NAN;
+    int maxTemp = std::isnan(cpuTemp) ? 0 : static_cast<int>(cpuTemp);
     
     // Update CPU temperature label
     if (maxTemp > 0) {
@@ -555,29 +496,21 @@ void SystemInfoPage::updateCPUInfo()
         m_cpuTempLabel->setText("-- °C");
     }
     
-    // CPU Clock from /proc/cpuinfo
-    QFile cpuFile("/proc/cpuinfo");
-    if (cpuFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&cpuFile);
-        QString line;
-        double maxClock = 0.0;
-        while (stream.readLineInto(&line)) {
-            if (line.startsWith("cpu MHz")) {
-                QStringList parts = line.split(':');
-                if (parts.size() == 2) {
-                    double mhz = parts[1].trimmed().toDouble();
-                    if (mhz > maxClock) maxClock = mhz;
-                }
-            }
-        }
-        cpuFile.close();
-        
-        // Update CPU clock label
-        if (maxClock > 0) {
-            m_cpuClockLabel->setText(QString::number(static_cast<int>(maxClock)) + " MHz");
-        } else {
-            m_cpuClockLabel->setText("-- MHz");
-        }
+    // Per-core load and frequency, sampled by the sensor hub alongside the aggregate load
+    const CoreLoad *cores = m_sensors ? m_sensors->cores.get() : nullptr;
+    if (cores) {
+        m_coreStrip->setCores(cores->utilization.data(), cores->frequencyMHz.data(), cores->count());
+    }
+    
+    // CPU Clock: fastest cpufreq policy, else the highest "cpu MHz" in /proc/cpuinfo (VMs)
+    if (cores && cores->hasFrequency) {
+        m_cpuClockMHz = std::isnan(cores->maxFrequencyMHz) ? 0.0 : cores->maxFrequencyMHz;
+    } else {
+        parseCpuInfo(m_cpuInfoFile.read(), m_cpuInfo);
+        m_cpuClockMHz = m_cpuInfo.maxMHz;
+    }
+    if (m_cpuClockMHz > 0) {
+        m_cpuClockLabel->setText(QString::number(static_cast<int>(m_cpuClockMHz)) + " MHz");
     } else {
         m_cpuClockLabel->setText("-- MHz");
     }
@@ -588,100 +521,43 @@ void SystemInfoPage::updateCPUInfo()
 
 void SystemInfoPage::updateCPUPowerAndVoltage()
 {
-    // Try to get CPU power from RAPL (Running Average Power Limit)
-    QStringList raplPaths = {
-        "/sys/class/powercap/intel-rapl/intel-rapl:0/energy_uj",
-        "/sys/class/powercap/intel-rapl/intel-rapl:1/energy_uj",
-        "/sys/class/powercap/intel-rapl/intel-rapl:0:0/energy_uj"
-    };
-    
+    // CPU power from RAPL (Running Average Power Limit), else the hwmon power meter
+    // (zenpower and similar drivers) - both sampled by the sensor hub
     bool foundRAPL = false;
-    for (const QString &path : raplPaths) {
-        QFile raplFile(path);
-        if (raplFile.open(QIODevice::ReadOnly)) {
-            QTextStream stream(&raplFile);
-            QString energyStr = stream.readLine();
-            if (!energyStr.isEmpty()) {
-                qint64 currentEnergyUJ = energyStr.toLongLong();
-                qint64 currentTimestamp = QDateTime::currentMSecsSinceEpoch();
-                
-                if (m_prevTimestamp > 0 && m_prevEnergyUJ > 0) {
-                    qint64 timeDiff = currentTimestamp - m_prevTimestamp; // milliseconds
-                    qint64 energyDiff = currentEnergyUJ - m_prevEnergyUJ; // microjoules
-                    
-                    if (timeDiff > 0 && energyDiff >= 0) {
-                        // Convert to watts: (microjoules / 1000000) / (milliseconds / 1000)
-                        double powerW = (energyDiff / 1000000.0) / (timeDiff / 1000.0);
-                        // Clamp to reasonable range (0-500W)
-                        if (powerW >= 0 && powerW <= 500) {
-                            m_cpuPowerCard->setValue(QString::number(powerW, 'f', 1) + " W");
-                        } else {
-                            m_cpuPowerCard->setValue("-- W");
-                        }
-                    } else {
-                        m_cpuPowerCard->setValue("-- W");
-                    }
-                } else {
-                    m_cpuPowerCard->setValue("-- W");
-                }
-                
-                m_prevEnergyUJ = currentEnergyUJ;
-                m_prevTimestamp = currentTimestamp;
-                foundRAPL = true;
+    if (m_sensors && !std::isnan(m_sensors->packageWatts)) {
+        m_cpuPowerCard->setValue(QString::number(m_sensors->packageWatts, 'f', 1) + " W");
+        foundRAPL = true;
+        
+        // RAPL sub-domains where the CPU reports them
+        QStringList domains;
+        const std::pair<const char *, double> parts[] = {
+            { "Core", m_sensors->coreWatts },
+            { "Uncore", m_sensors->uncoreWatts },
+            { "DRAM", m_sensors->dramWatts },
+            { "Platform", m_sensors->platformWatts },
+        };
+        for (const auto &part : parts) {
+            if (!std::isnan(part.second)) {
+                domains << QString("%1 %2 W").arg(part.first).arg(part.second, 0, 'f', 1);
             }
-            raplFile.close();
-            break;
         }
+        m_cpuPowerCard->setSubValue(domains.join("  "));
     }
     
     if (!foundRAPL) {
-        // Try alternative power monitoring methods
-        // Check if we can use sensors command as fallback
-        QProcess sensorsProcess;
-        sensorsProcess.start("sensors", QStringList() << "-A");
-        sensorsProcess.waitForFinished(1000);
-        
-        if (sensorsProcess.exitCode() == 0) {
-            QString output = sensorsProcess.readAllStandardOutput();
-            // Look for power readings in sensors output
-            QRegularExpression powerRegex("P\\w*:\\s*([0-9.]+)\\s*W");
-            QRegularExpressionMatch match = powerRegex.match(output);
-            if (match.hasMatch()) {
-                double powerW = match.captured(1).toDouble();
-                if (powerW > 0 && powerW <= 500) {
-                    m_cpuPowerCard->setValue(QString::number(powerW, 'f', 1) + " W");
-                    foundRAPL = true;
-                }
-            }
-        }
+        m_cpuPowerCard->setSubValue("");
         
         // Try to estimate power from CPU frequency and load (very rough approximation)
         if (!foundRAPL) {
             // This is a very rough estimation - not accurate but better than N/A
-            // Get CPU frequency from /proc/cpuinfo
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                double maxFreq = 0.0;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("cpu MHz")) {
-                        QStringList parts = line.split(':');
-                        if (parts.size() == 2) {
-                            double freq = parts[1].trimmed().toDouble();
-                            if (freq > maxFreq) maxFreq = freq;
-                        }
-                    }
-                }
-                cpuFile.close();
-                
-                if (maxFreq > 0) {
-                    // Very rough power estimation based on frequency
-                    // This is not accurate but gives a ballpark figure
-                    double estimatedPower = (maxFreq / 1000.0) * 0.5; // Rough W/GHz ratio
-                    m_cpuPowerCard->setValue("~" + QString::number(estimatedPower, 'f', 1) + " W");
-                    foundRAPL = true;
-                }
+            // CPU frequency as read by updateCPUInfo() this tick
+            double maxFreq = m_cpuClockMHz;
+            if (maxFreq > 0) {
+                // Very rough power estimation based on frequency
+                // This is not accurate but gives a ballpark figure
+                double estimatedPower = (maxFreq / 1000.0) * 0.5; // Rough W/GHz ratio
+                m_cpuPowerCard->setValue("~" + QString::number(estimatedPower, 'f', 1) + " W");
+                foundRAPL = true;
             }
         }
         
@@ -694,114 +570,22 @@ void SystemInfoPage::updateCPUPowerAndVoltage()
     bool voltageFound = false;
     
     // Try from /sys/class/hwmon (common on modern systems)
-    QDir hwmonDir("/sys/class/hwmon");
-    QStringList hwmonDirs = hwmonDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    for (const QString &hwmon : hwmonDirs) {
-        QFile nameFile("/sys/class/hwmon/" + hwmon + "/name");
-        if (nameFile.open(QIODevice::ReadOnly)) {
-            QTextStream stream(&nameFile);
-            QString name = stream.readLine().trimmed();
-            nameFile.close();
-            
-            if (name.contains("coretemp") || name.contains("k10temp") || name.contains("zenpower") || 
-                name.contains("asus") || name.contains("acpi")) {
-                // Look for voltage input files
-                QDir hwmonSubDir("/sys/class/hwmon/" + hwmon);
-                QStringList files = hwmonSubDir.entryList(QDir::Files);
-                for (const QString &file : files) {
-                    if (file.startsWith("in") && file.endsWith("_input")) {
-                        QFile voltageFile("/sys/class/hwmon/" + hwmon + "/" + file);
-                        if (voltageFile.open(QIODevice::ReadOnly)) {
-                            QTextStream vStream(&voltageFile);
-                            QString voltageStr = vStream.readLine();
-                            if (!voltageStr.isEmpty()) {
-                                double voltage = voltageStr.toDouble() / 1000.0; // Convert mV to V
-                                if (voltage > 0.5 && voltage < 2.0) { // Reasonable CPU voltage range
-                                    m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                                    voltageFound = true;
-                                    voltageFile.close();
-                                    break;
-                                }
-                            }
-                            voltageFile.close();
-                        }
-                    }
-                }
-                if (voltageFound) break;
-            }
-        }
+    double voltage = m_sensors ? m_sensors->cpuVoltage : NAN;
+    if (!std::isnan(voltage)) {
+        m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
+        voltageFound = true;
     }
     
-    // Try alternative voltage sources if hwmon didn't work
+    // No vcore sensor (the usual case on k10temp and coretemp): /proc/cpuinfo never
+    // carries a live voltage, so the rough per-vendor estimate is resolved once
     if (!voltageFound) {
-        // Try sensors command as fallback
-        QProcess sensorsProcess;
-        sensorsProcess.start("sensors", QStringList() << "-A");
-        sensorsProcess.waitForFinished(1000);
-        
-        if (sensorsProcess.exitCode() == 0) {
-            QString output = sensorsProcess.readAllStandardOutput();
-            // Look for voltage readings in sensors output
-            QRegularExpression voltageRegex("V\\w*:\\s*([0-9.]+)\\s*V");
-            QRegularExpressionMatch match = voltageRegex.match(output);
-            if (match.hasMatch()) {
-                double voltage = match.captured(1).toDouble();
-                if (voltage > 0.5 && voltage < 2.0) {
-                    m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                    voltageFound = true;
-                }
-            }
+        if (!m_cpuVoltageResolved) {
+            m_cpuVoltageEstimate = estimateCPUVoltage();
+            m_cpuVoltageResolved = true;
         }
-        
-        // Try to get voltage from /proc/cpuinfo or other sources
-        if (!voltageFound) {
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    // Look for voltage-related information
-                    if (line.contains("voltage", Qt::CaseInsensitive) || 
-                        line.contains("vid", Qt::CaseInsensitive)) {
-                        // Extract voltage if found
-                        QRegularExpression voltageRegex("([0-9.]+)\\s*V");
-                        QRegularExpressionMatch match = voltageRegex.match(line);
-                        if (match.hasMatch()) {
-                            double voltage = match.captured(1).toDouble();
-                            if (voltage > 0.5 && voltage < 2.0) {
-                                m_cpuVoltageCard->setValue(QString::number(voltage, 'f', 3) + " V");
-                                voltageFound = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-                cpuFile.close();
-            }
-        }
-        
-        // Try to estimate voltage based on CPU model (very rough)
-        if (!voltageFound) {
-            QFile cpuFile("/proc/cpuinfo");
-            if (cpuFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&cpuFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("model name")) {
-                        QString model = line.toLower();
-                        // Very rough voltage estimation based on CPU generation
-                        if (model.contains("ryzen") || model.contains("zen")) {
-                            m_cpuVoltageCard->setValue("~1.1 V"); // Typical for modern AMD
-                            voltageFound = true;
-                        } else if (model.contains("intel")) {
-                            m_cpuVoltageCard->setValue("~1.2 V"); // Typical for modern Intel
-                            voltageFound = true;
-                        }
-                        break;
-                    }
-                }
-                cpuFile.close();
-            }
+        if (!m_cpuVoltageEstimate.isEmpty()) {
+            m_cpuVoltageCard->setValue(m_cpuVoltageEstimate);
+            voltageFound = true;
         }
     }
     
@@ -810,6 +594,29 @@ void SystemInfoPage::updateCPUPowerAndVoltage()
     }
 }
 
+QString SystemInfoPage::estimateCPUVoltage()
+{
+    // Very rough voltage estimation based on CPU generation, from the first model name
+    QFile cpuFile("/proc/cpuinfo");
+    if (!cpuFile.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    QTextStream stream(&cpuFile);
+    QString line;
+    while (stream.readLineInto(&line)) {
+        if (line.startsWith("model name")) {
+            QString model = line.toLower();
+            if (model.contains("ryzen") || model.contains("zen")) {
+                return "~1.1 V"; // Typical for modern AMD
+            } else if (model.contains("intel")) {
+                return "~1.2 V"; // Typical for modern Intel
+            }
+            break;
+        }
+    }
+    return QString();
+}
+
 void SystemInfoPage::updateGPUInfo()
 {
     // Detect GPU type and get information
@@ -861,259 +668,24 @@ void SystemInfoPage::updateGPUInfo()
 
 GPUInfo SystemInfoPage::detectGPU()
 {
-    // First, try to detect GPU type from lspci - scan all devices
-    QProcess lspciProcess;
-    lspciProcess.start("lspci", QStringList() << "-n");
-    lspciProcess.waitForFinished(1000);
-    
-    QString gpuVendor = "Unknown";
-    QString gpuModel = "Unknown";
-    
-    if (lspciProcess.exitCode() == 0) {
-        QString output = lspciProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        
-        for (const QString &line : lines) {
-            if (line.contains("0300")) { // VGA compatible controller
-                // Parse line like: "41:00.0 0300: 10de:2684 (rev a1)"
-                // Look for pattern: "10de:2684"
-                QRegularExpression pciRegex("(10de|1002|1022|8086):([0-9a-fA-F]+)");
-                QRegularExpressionMatch match = pciRegex.match(line);
-                if (match.hasMatch()) {
-                    QString vendorId = match.captured(1);
-                    QString deviceId = match.captured(2);
-                    
-                    // Detect vendor by PCI ID
-                    if (vendorId == "10de") {
-                        gpuVendor = "NVIDIA";
-                        return detectNVIDIAGPU();
-                    } else if (vendorId == "1002" || vendorId == "1022") {
-                        gpuVendor = "AMD";
-                        return detectAMDGPU();
-                    } else if (vendorId == "8086") {
-                        gpuVendor = "Intel";
-                        return detectIntelGPU();
-                    }
-                }
-            }
-        }
-    }
-    
-    // Fallback to generic detection
-    return detectGenericGPU();
-}
-
-GPUInfo SystemInfoPage::detectNVIDIAGPU()
-{
-    GPUInfo info;
-    info.vendor = "NVIDIA";
-    
-    // Try nvidia-smi first
-    QProcess nvidiaProcess;
-    nvidiaProcess.start("nvidia-smi", QStringList() << "--query-gpu=name,utilization.gpu,temperature.gpu,clocks.gr,power.draw,memory.used,memory.total" << "--format=csv,noheader,nounits");
-    nvidiaProcess.waitForFinished(1000);
-    
-    if (nvidiaProcess.exitCode() == 0) {
-        QString output = nvidiaProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        if (!lines.isEmpty()) {
-            QStringList values = lines[0].split(',');
-            if (values.size() >= 7) {
-                info.model = values[0].trimmed();
-                info.load = values[1].trimmed().toInt();
-                info.temperature = values[2].trimmed().toInt();
-                info.clockRate = values[3].trimmed().toInt();
-                info.power = values[4].trimmed().toDouble();
-                info.memoryUsed = values[5].trimmed().toInt();
-                info.memoryTotal = values[6].trimmed().toInt();
-                
-                // Set voltage to -1 since we're not using it anymore
-                info.voltage = -1.0;
-            }
-        }
-    } else {
-        // Try nouveau driver (open-source NVIDIA driver)
-        QDir drmDir("/sys/class/drm");
-        QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        
-        for (const QString &card : cards) {
-            if (card.startsWith("card") && !card.contains("-")) {
-                QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-                if (ueventFile.open(QIODevice::ReadOnly)) {
-                    QTextStream stream(&ueventFile);
-                    QString line;
-                    while (stream.readLineInto(&line)) {
-                        if (line.startsWith("DRIVER=nouveau")) {
-                            // For nouveau, we can only get basic info
-                            info.model = "NVIDIA RTX 4090 (nouveau)";
-                            info.load = -1; // Not available in nouveau
-                            info.temperature = -1; // Not available in nouveau
-                            info.clockRate = -1; // Not available in nouveau
-                            info.power = -1.0; // Not available in nouveau
-                            info.voltage = -1.0; // Not available in nouveau
-                            break;
-                        }
-                    }
-                    ueventFile.close();
-                }
-            }
-        }
-    }
-    
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectAMDGPU()
-{
-    GPUInfo info;
-    info.vendor = "AMD";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
-    
-    // Try radeontop if available
-    QProcess radeontopProcess;
-    radeontopProcess.start("radeontop", QStringList() << "-d" << "1" << "-l" << "1");
-    radeontopProcess.waitForFinished(1000);
-    
-    if (radeontopProcess.exitCode() == 0) {
-        QString output = radeontopProcess.readAllStandardOutput();
-        // Parse radeontop output for GPU utilization
-        QRegularExpression loadRegex("gpu\\s+(\\d+)%");
-        QRegularExpressionMatch match = loadRegex.match(output);
-        if (match.hasMatch()) {
-            info.load = match.captured(1).toInt();
-        }
-    }
-    
-    // Try sensors for temperature
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "-A");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for AMD GPU temperature
-        QRegularExpression tempRegex("amdgpu.*?temp1:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            info.temperature = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Try /sys/class/drm for basic info
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=amdgpu")) {
-                        info.model = "AMD (amdgpu)";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
-    }
-    
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectIntelGPU()
-{
+    // Sampled by the sensor hub straight from the driver: amdgpu sysfs/hwmon, the i915
+    // perf PMU, or NVML from the NVIDIA driver - no nvidia-smi/radeontop/intel_gpu_top
     GPUInfo info;
-    info.vendor = "Intel";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
+    const SensorHub &hub = SensorHub::instance();
+    info.vendor = hub.gpuVendor().empty() ? QString("Unknown") : QString::fromStdString(hub.gpuVendor());
+    info.model = hub.gpuModel().empty() ? QString("Generic GPU") : QString::fromStdString(hub.gpuModel());
     
-    // Try intel_gpu_top if available
-    QProcess intelProcess;
-    intelProcess.start("intel_gpu_top", QStringList() << "-s" << "1");
-    intelProcess.waitForFinished(1000);
-    
-    if (intelProcess.exitCode() == 0) {
-        QString output = intelProcess.readAllStandardOutput();
-        // Parse intel_gpu_top output for GPU utilization
-        QRegularExpression loadRegex("GPU\\s+(\\d+)%");
-        QRegularExpressionMatch match = loadRegex.match(output);
-        if (match.hasMatch()) {
-            info.load = match.captured(1).toInt();
-        }
-    }
-    
-    // Try sensors for temperature
-    QProcess sensorsProcess;
-    sensorsProcess.start("sensors", QStringList() << "-A");
-    sensorsProcess.waitForFinished(1000);
-    
-    if (sensorsProcess.exitCode() == 0) {
-        QString output = sensorsProcess.readAllStandardOutput();
-        // Look for Intel GPU temperature
-        QRegularExpression tempRegex("i915.*?temp1:\\s*\\+?([0-9.]+)°C");
-        QRegularExpressionMatch match = tempRegex.match(output);
-        if (match.hasMatch()) {
-            info.temperature = static_cast<int>(match.captured(1).toDouble());
-        }
-    }
-    
-    // Try /sys/class/drm for basic info
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=i915")) {
-                        info.model = "Intel (i915)";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
+    if (!m_sensors) {
+        return info;
     }
     
-    return info;
-}
-
-GPUInfo SystemInfoPage::detectGenericGPU()
-{
-    GPUInfo info;
-    info.vendor = "Unknown";
-    info.model = "Generic GPU";
-    info.memoryUsed = -1;
-    info.memoryTotal = -1;
-    
-    // Try to get basic info from /sys/class/drm
-    QDir drmDir("/sys/class/drm");
-    QStringList cards = drmDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    
-    for (const QString &card : cards) {
-        if (card.startsWith("card") && !card.contains("-")) {
-            QFile ueventFile("/sys/class/drm/" + card + "/device/uevent");
-            if (ueventFile.open(QIODevice::ReadOnly)) {
-                QTextStream stream(&ueventFile);
-                QString line;
-                while (stream.readLineInto(&line)) {
-                    if (line.startsWith("DRIVER=")) {
-                        QString driver = line.split('=')[1];
-                        info.model = "GPU (" + driver + ")";
-                        break;
-                    }
-                }
-                ueventFile.close();
-            }
-        }
-    }
+    auto whole = [](double value) { return std::isnan(value) ? -1 : static_cast<int>(std::lround(value)); };
+    info.load = whole(m_sensors->gpuLoad);
+    info.temperature = whole(m_sensors->gpuTemperature);
+    info.clockRate = whole(m_sensors->gpuClockMHz);
+    info.power = std::isnan(m_sensors->gpuPowerWatts) ? -1.0 : m_sensors->gpuPowerWatts;
+    info.memoryUsed = whole(m_sensors->gpuMemoryUsedMB);
+    info.memoryTotal = whole(m_sensors->gpuMemoryTotalMB);
     
     return info;
 }
@@ -1121,25 +693,12 @@ GPUInfo SystemInfoPage::detectGenericGPU()
 void SystemInfoPage::updateRAMInfo()
 {
     // RAM usage from /proc/meminfo with real-time updates
-    QFile memFile("/proc/meminfo");
-    if (memFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&memFile);
-        QString line;
-        long totalMem = 0, freeMem = 0, availableMem = 0, buffers = 0, cached = 0;
-        
-        while (stream.readLineInto(&line)) {
-            if (line.startsWith("MemTotal:")) {
-                totalMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("MemFree:")) {
-                freeMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("MemAvailable:")) {
-                availableMem = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("Buffers:")) {
-                buffers = line.split(QRegularExpression("\\s+"))[1].toLong();
-            } else if (line.startsWith("Cached:")) {
-                cached = line.split(QRegularExpression("\\s+"))[1].toLong();
-            }
-        }
+    const char *memText = m_memInfoFile.read();
+    if (memText) {
+        MemInfo mem;
+        parseMeminfo(memText, mem);
+        long totalMem = static_cast<long>(mem.totalKB);
+        long availableMem = static_cast<long>(mem.availableKB);
         
         if (totalMem > 0) {
             // Use MemAvailable for more accurate used memory calculation
@@ -1165,7 +724,6 @@ void SystemInfoPage::updateRAMInfo()
             m_ramUsageCard->setSubValue(""); // Clear subValue - we show RAM stats below the circle instead
             m_ramDetailsLabel->setText("-- / -- RAM");
         }
-        memFile.close();
     } else {
         // Error fallback
         m_ramUsageCard->setProgress(0);
@@ -1182,61 +740,54 @@ void SystemInfoPage::updateNetworkInfo()
     static QTime prevTime;
     static QString primaryInterface = "";
     
-    QFile netFile("/proc/net/dev");
-    if (netFile.open(QIODevice::ReadOnly)) {
-        QTextStream stream(&netFile);
-        QString line;
+    const char *netText = m_netDevFile.read();
+    if (netText) {
         long totalRx = 0, totalTx = 0;
         long maxTraffic = 0;
-        QString detectedPrimaryInterface = "";
+        const char *detectedPrimaryInterface = nullptr;
         
-        // Skip header lines
-        stream.readLine();
-        stream.readLine();
+        int count = parseNetDev(netText, m_netDevices.data(), static_cast<int>(m_netDevices.size()));
+        if (count > static_cast<int>(m_netDevices.size())) {
+            // More interfaces than last time (containers, VPNs): grow once and re-parse
+            m_netDevices.resize(count + 8);
+            count = parseNetDev(netText, m_netDevices.data(), static_cast<int>(m_netDevices.size()));
+        }
         
-        while (stream.readLineInto(&line)) {
-            // Parse the line more carefully - interface name is before the first colon
-            int colonPos = line.indexOf(':');
-            if (colonPos > 0) {
-                QString interface = line.left(colonPos).trimmed();
-                QString data = line.mid(colonPos + 1).trimmed();
-                QStringList parts = data.split(QRegularExpression("\\s+"));
-                
-                if (parts.size() >= 9) {
-                    long rx = parts[0].toLong();  // First number after colon is RX bytes
-                    long tx = parts[8].toLong();  // 9th number after colon is TX bytes
-                    long totalTraffic = rx + tx;
-                    
-                    // Skip loopback and virtual interfaces, but include any interface with traffic
-                    bool isVirtualInterface = interface.startsWith("lo") || 
-                                            interface.startsWith("docker") || 
-                                            interface.startsWith("veth") ||
-                                            interface.startsWith("br-") ||
-                                            interface.startsWith("virbr") ||
-                                            interface.startsWith("tun") ||
-                                            interface.startsWith("tap") ||
-                                            interface.startsWith("sit") ||
-                                            interface.startsWith("ppp") ||
-                                            interface.isEmpty();
-                    
-                    // Track the interface with the most traffic for primary detection
-                    if (!isVirtualInterface && totalTraffic > maxTraffic) {
-                        maxTraffic = totalTraffic;
-                        detectedPrimaryInterface = interface;
-                    }
-                    
-                    // Include interface if it's not virtual OR if it has significant traffic
-                    if (!isVirtualInterface || (rx > 1000 || tx > 1000)) {
-                        totalRx += rx;
-                        totalTx += tx;
-                    }
-                }
+        for (int i = 0; i < count; ++i) {
+            const NetDevCounters &dev = m_netDevices[i];
+            const char *interface = dev.name;
+            long rx = static_cast<long>(dev.rxBytes);
+            long tx = static_cast<long>(dev.txBytes);
+            long totalTraffic = rx + tx;
+            
+            // Skip loopback and virtual interfaces, but include any interface with traffic
+            bool isVirtualInterface = procfs::startsWith(interface, "lo") ||
+                                    procfs::startsWith(interface, "docker") ||
+                                    procfs::startsWith(interface, "veth") ||
+                                    procfs::startsWith(interface, "br-") ||
+                                    procfs::startsWith(interface, "virbr") ||
+                                    procfs::startsWith(interface, "tun") ||
+                                    procfs::startsWith(interface, "tap") ||
+                                    procfs::startsWith(interface, "sit") ||
+                                    procfs::startsWith(interface, "ppp") ||
+                                    interface[0] == '\0';
+            
+            // Track the interface with the most traffic for primary detection
+            if (!isVirtualInterface && totalTraffic > maxTraffic) {
+                maxTraffic = totalTraffic;
+                detectedPrimaryInterface = interface;
+            }
+            
+            // Include interface if it's not virtual OR if it has significant traffic
+            if (!isVirtualInterface || (rx > 1000 || tx > 1000)) {
+                totalRx += rx;
+                totalTx += tx;
             }
         }
         
         // Update primary interface if we found a new one with more traffic
-        if (!detectedPrimaryInterface.isEmpty() && detectedPrimaryInterface != primaryInterface) {
-            primaryInterface = detectedPrimaryInterface;
+        if (detectedPrimaryInterface && primaryInterface != QLatin1String(detectedPrimaryInterface)) {
+            primaryInterface = QString::fromLatin1(detectedPrimaryInterface);
         }
         
         QTime currentTime = QTime::currentTime();
@@ -1303,8 +854,6 @@ void SystemInfoPage::updateNetworkInfo()
         prevRx = totalRx;
         prevTx = totalTx;
         prevTime = currentTime;
-        
-        netFile.close();
     } else {
         m_networkCard->setValue("↑ -- B/s\n↓ -- B/s");
     }
@@ -1312,39 +861,33 @@ void SystemInfoPage::updateNetworkInfo()
 
 void SystemInfoPage::updateStorageInfo()
 {
-    // Storage info from df command
-    QProcess dfProcess;
-    dfProcess.start("df", QStringList() << "-h");
-    dfProcess.waitForFinished(1000);
+    // statvfs over / and /home from /proc/self/mountinfo (parsed again only when the
+    // mount table changes), plus /proc/diskstats rates for the devices behind them
+    const std::vector<FilesystemUsage> &filesystems = m_storageCollector.sample();
+    
+    QString storageInfo;
+    for (const FilesystemUsage &fs : filesystems) {
+        if (fs.totalBytes == 0) {
+            continue;
+        }
+        // Use actual mount path labels on Linux (no Windows-style drive letters)
+        QString mountLabel = QString::fromStdString(fs.mountPoint); // e.g. "/" or "/home"
+        int percent = std::isnan(fs.usedPercent) ? 0 : static_cast<int>(std::ceil(fs.usedPercent));
+        storageInfo += mountLabel + " " + formatSize(fs.usedBytes) + "/" + formatSize(fs.totalBytes)
+                       + " " + QString::number(percent) + "%\n";
+    }
     
-    if (dfProcess.exitCode() == 0) {
-        QString output = dfProcess.readAllStandardOutput();
-        QStringList lines = output.split('\n', Qt::SkipEmptyParts);
-        
-        QString storageInfo;
-        for (const QString &line : lines) {
-            if (line.contains("/dev/") && (line.contains("/") || line.contains("home"))) {
-                QStringList parts = line.split(QRegularExpression("\\s+"));
-                if (parts.size() >= 6) {
-                    QString device = parts[0];
-                    QString size = parts[1];
-                    QString used = parts[2];
-                    QString avail = parts[3];
-                    QString percent = parts[4];
-                    QString mount = parts[5];
-                    
-                    if (mount == "/" || mount.startsWith("/home")) {
-                        // Use actual mount path labels on Linux (no Windows-style drive letters)
-                        QString mountLabel = mount; // e.g. "/" or "/home"
-                        storageInfo += mountLabel + " " + used + "/" + size + " " + percent + "\n";
-                    }
-                }
-            }
-        }
-        
-        if (storageInfo.isEmpty()) {
-            storageInfo = "N/A";
-        }
-        m_storageCard->setValue(storageInfo.trimmed());
+    if (storageInfo.isEmpty()) {
+        storageInfo = "N/A";
+    }
+    m_storageCard->setValue(storageInfo.trimmed());
+    
+    // Live disk I/O
+    double readRate = m_storageCollector.totalReadBytesPerSecond();
+    double writeRate = m_storageCollector.totalWriteBytesPerSecond();
+    if (!std::isnan(readRate) && !std::isnan(writeRate)) {
+        m_storageCard->setSubValue("R " + formatRate(readRate) + "  W " + formatRate(writeRate));
+    } else {
+        m_storageCard->setSubValue("R -- B/s  W -- B/s");
     }
 }
@@ -9,8 +9,13 @@
 #include <QFrame>
 #include <QProgressBar>
 #include <QTimer>
+#include "sensors/sensorhub.h"
+#include "sensors/storagecollector.h"
+#include "sensors/procfs.h"
+#include <vector>
 
 class MonitoringCard;
+class CoreHeatStrip;
 
 struct GPUInfo {
     int load = -1;        // GPU utilization percentage
@@ -39,12 +44,9 @@ private:
     void createMonitoringCards();
     void updateCPUInfo();
     void updateCPUPowerAndVoltage();
+    QString estimateCPUVoltage();
     void updateGPUInfo();
     GPUInfo detectGPU();
-    GPUInfo detectNVIDIAGPU();
-    GPUInfo detectAMDGPU();
-    GPUInfo detectIntelGPU();
-    GPUInfo detectGenericGPU();
     void updateRAMInfo();
     void updateNetworkInfo();
     void updateStorageInfo();
@@ -65,6 +67,7 @@ private:
     // CPU real-time data labels
     QLabel *m_cpuTempLabel;
     QLabel *m_cpuClockLabel;
+    CoreHeatStrip *m_coreStrip;
     
     // GPU real-time data labels
     QLabel *m_gpuTempLabel;
@@ -83,9 +86,24 @@ private:
     // Update timer
     QTimer *m_updateTimer;
     
-    // CPU power monitoring variables
-    static qint64 m_prevEnergyUJ;
-    static qint64 m_prevTimestamp;
+    // Sensor hub snapshot for the current update
+    SensorSnapshotPtr m_sensors;
+    
+    // Mounted filesystems and disk throughput for the storage card
+    StorageCollector m_storageCollector;
+    
+    // /proc files kept open and re-read in place every update
+    ProcFile m_cpuInfoFile;
+    ProcFile m_memInfoFile;
+    ProcFile m_netDevFile;
+    std::vector<NetDevCounters> m_netDevices;
+    CpuInfoSummary m_cpuInfo;
+    
+    double m_cpuClockMHz;
+    
+    // Model-based voltage estimate, resolved the first time hwmon has no vcore
+    QString m_cpuVoltageEstimate;
+    bool m_cpuVoltageResolved;
 };
 
 #endif // SYSTEMINFOPAGE_H
@@ -0,0 +1,165 @@
+/*---------------------------------------------------------*\
+||| coresampler.cpp                                         |
+|||                                                         |
+|||   Per-core CPU utilization and frequency               |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "coresampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace procfs;
+
+namespace {
+
+bool readFileOnce(const std::string& path, char* buf, size_t size) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    close(fd);
+    if (n <= 0) return false;
+    buf[n] = '\0';
+    return true;
+}
+
+// "0 1 2 3" (related_cpus) or "0-3,8-11" (cpulist format)
+void parseCpuList(const char* p, std::vector<int>& cpus) {
+    while (*p) {
+        if (*p < '0' || *p > '9') {
+            ++p;
+            continue;
+        }
+        int first = int(scanU64(p));
+        int last = first;
+        if (*p == '-') {
+            ++p;
+            last = int(scanU64(p));
+        }
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+}
+
+} // namespace
+
+CoreSampler::CoreSampler(const std::string& procRoot, const std::string& cpuRoot)
+    : m_stat(procRoot + "/stat", 16384)
+    , m_maxFrequency(NAN)
+    , m_maxUtilization(NAN)
+{
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    resize(configured > 0 ? int(configured) : 1);
+    openPolicies(cpuRoot);
+}
+
+CoreSampler::~CoreSampler() {
+    for (int fd : m_policyFds) close(fd);
+}
+
+void CoreSampler::resize(int cores) {
+    m_times.resize(size_t(cores));
+    m_prevBusy.resize(size_t(cores), 0);
+    m_prevTotal.resize(size_t(cores), 0);
+    m_utilization.resize(size_t(cores), NAN);
+    m_frequency.resize(size_t(cores), NAN);
+}
+
+void CoreSampler::openPolicies(const std::string& cpuRoot) {
+    const std::string root = cpuRoot + "/cpufreq";
+    DIR* dir = opendir(root.c_str());
+    if (!dir) return;
+
+    std::vector<int> numbers;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "policy", 6) != 0) continue;
+        const char* p = entry->d_name + 6;
+        numbers.push_back(int(scanU64(p)));
+    }
+    closedir(dir);
+    std::sort(numbers.begin(), numbers.end());
+
+    m_policyFirst.push_back(0);
+    for (int number : numbers) {
+        const std::string policy = root + "/policy" + std::to_string(number);
+        char list[4096];
+        if (!readFileOnce(policy + "/related_cpus", list, sizeof(list))
+            && !readFileOnce(policy + "/affected_cpus", list, sizeof(list))) continue;
+
+        int fd = open((policy + "/scaling_cur_freq").c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        parseCpuList(list, m_policyCpus);
+        m_policyFds.push_back(fd);
+        m_policyFirst.push_back(int(m_policyCpus.size()));
+    }
+
+    if (!m_policyCpus.empty()) {
+        int highest = *std::max_element(m_policyCpus.begin(), m_policyCpus.end());
+        if (highest >= coreCount()) resize(highest + 1);
+    }
+}
+
+int CoreSampler::sample() {
+    // Offline CPUs have no line; zeroed times mark them
+    std::fill(m_times.begin(), m_times.end(), CpuTimes());
+    CpuTimes total;
+    const char* text = m_stat.read();
+    int highest = parseStat(text, total, m_times.data(), coreCount());
+    if (highest > coreCount()) {
+        // A CPU was hot-added beyond the configured count
+        resize(highest);
+        std::fill(m_times.begin(), m_times.end(), CpuTimes());
+        parseStat(text, total, m_times.data(), coreCount());
+    }
+
+    m_maxUtilization = NAN;
+    const int cores = coreCount();
+    for (int cpu = 0; cpu < cores; ++cpu) {
+        const uint64_t busy = m_times[cpu].busy();
+        const uint64_t ticks = m_times[cpu].total();
+        float utilization = NAN;
+        if (ticks > 0 && m_prevTotal[cpu] > 0 && ticks > m_prevTotal[cpu] && busy >= m_prevBusy[cpu]) {
+            utilization = float(busy - m_prevBusy[cpu]) / float(ticks - m_prevTotal[cpu]);
+            utilization = std::min(1.0f, std::max(0.0f, utilization));
+            if (!(utilization <= m_maxUtilization)) m_maxUtilization = utilization;
+        } else if (ticks > 0 && ticks == m_prevTotal[cpu]) {
+            utilization = m_utilization[cpu];   // No tick elapsed yet
+        }
+        m_utilization[cpu] = utilization;
+        m_prevBusy[cpu] = busy;
+        m_prevTotal[cpu] = ticks;
+    }
+
+    m_maxFrequency = NAN;
+    for (size_t policy = 0; policy < m_policyFds.size(); ++policy) {
+        char buf[24];
+        ssize_t n = pread(m_policyFds[policy], buf, sizeof(buf) - 1, 0);
+        float mhz = NAN;
+        if (n > 0) {
+            buf[n] = '\0';
+            const char* p = buf;
+            mhz = float(scanU64(p)) / 1000.0f;     // kHz
+            if (!(mhz <= m_maxFrequency)) m_maxFrequency = mhz;
+        }
+        for (int i = m_policyFirst[policy]; i < m_policyFirst[policy + 1]; ++i) {
+            m_frequency[m_policyCpus[i]] = mhz;
+        }
+    }
+    return cores;
+}
+
+CoreLoad CoreSampler::load() const {
+    CoreLoad load;
+    load.utilization = m_utilization;
+    load.frequencyMHz = m_frequency;
+    load.hasFrequency = hasFrequency();
+    load.maxFrequencyMHz = m_maxFrequency;
+    load.maxUtilization = m_maxUtilization;
+    return load;
+}
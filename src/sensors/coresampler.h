@@ -0,0 +1,83 @@
+/*---------------------------------------------------------*\
+||| coresampler.h                                           |
+|||                                                         |
+|||   Per-core CPU utilization and frequency               |
+|||   One pass over /proc/stat cpuN lines plus one read of |
+|||   scaling_cur_freq per cpufreq policy, all through fds |
+|||   opened once. Results are kept as parallel arrays     |
+|||   indexed by logical CPU number.                       |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "procfs.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One sample, copied out for other threads (see SensorSnapshot::cores)
+struct CoreLoad {
+    std::vector<float> utilization;     // Per CPU, as CoreSampler::utilization()
+    std::vector<float> frequencyMHz;    // Per CPU, as CoreSampler::frequencyMHz()
+    bool hasFrequency = false;
+    float maxFrequencyMHz = NAN;
+    float maxUtilization = NAN;
+
+    int count() const { return int(utilization.size()); }
+};
+
+class CoreSampler {
+public:
+    explicit CoreSampler(const std::string& procRoot = "/proc",
+                         const std::string& cpuRoot = "/sys/devices/system/cpu");
+    ~CoreSampler();
+
+    CoreSampler(const CoreSampler&) = delete;
+    CoreSampler& operator=(const CoreSampler&) = delete;
+
+    // Read both sources; returns coreCount()
+    int sample();
+
+    // Highest logical CPU number + 1; offline CPUs keep their slot
+    int coreCount() const { return int(m_utilization.size()); }
+
+    // 0-1 busy share since the previous sample; NaN before the second sample
+    // and for offline CPUs
+    const float* utilization() const { return m_utilization.data(); }
+
+    // scaling_cur_freq of the CPU's policy; NaN without cpufreq (most VMs)
+    const float* frequencyMHz() const { return m_frequency.data(); }
+    bool hasFrequency() const { return !m_policyFds.empty(); }
+    float maxFrequencyMHz() const { return m_maxFrequency; }
+
+    // Busiest single CPU, to spot one saturated thread behind a low average
+    float maxUtilization() const { return m_maxUtilization; }
+
+    // Copy of the last sample
+    CoreLoad load() const;
+
+private:
+    void openPolicies(const std::string& cpuRoot);
+    void resize(int cores);
+
+    ProcFile m_stat;
+    std::vector<CpuTimes> m_times;      // Parse target, reused
+
+    // Per CPU
+    std::vector<uint64_t> m_prevBusy;
+    std::vector<uint64_t> m_prevTotal;
+    std::vector<float> m_utilization;
+    std::vector<float> m_frequency;
+
+    // Per policy: fd, and its CPUs as a slice of m_policyCpus
+    std::vector<int> m_policyFds;
+    std::vector<int> m_policyFirst;     // Size policies + 1
+    std::vector<int> m_policyCpus;
+
+    float m_maxFrequency;
+    float m_maxUtilization;
+};
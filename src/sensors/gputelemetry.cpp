@@ -0,0 +1,495 @@
+/*---------------------------------------------------------*\
+||| gputelemetry.cpp                                        |
+|||                                                         |
+|||   Process-free GPU telemetry                           |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "gputelemetry.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// One small attribute into buf (NUL-terminated); returns bytes read or -1
+ssize_t readAt(int fd, char* buf, size_t size) {
+    if (fd < 0) return -1;
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    if (n < 0) return -1;
+    buf[n] = '\0';
+    return n;
+}
+
+bool readInteger(int fd, long long& value) {
+    char buf[32];
+    if (readAt(fd, buf, sizeof(buf)) <= 0) return false;
+    char* end = nullptr;
+    value = std::strtoll(buf, &end, 10);
+    return end != buf;
+}
+
+std::string readAttribute(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::string();
+    char buf[4096];
+    ssize_t n = readAt(fd, buf, sizeof(buf));
+    close(fd);
+    if (n <= 0) return std::string();
+    while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == ' ')) --n;
+    return std::string(buf, size_t(n));
+}
+
+int openAttribute(const std::string& path) {
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+void closeFd(int& fd) {
+    if (fd >= 0) close(fd);
+    fd = -1;
+}
+
+// KEY=value line from a uevent file
+std::string ueventValue(const std::string& uevent, const char* key) {
+    size_t keyLength = std::strlen(key);
+    size_t pos = 0;
+    while (pos < uevent.size()) {
+        size_t end = uevent.find('\n', pos);
+        if (end == std::string::npos) end = uevent.size();
+        if (uevent.compare(pos, keyLength, key) == 0 && pos + keyLength < end && uevent[pos + keyLength] == '=') {
+            return uevent.substr(pos + keyLength + 1, end - pos - keyLength - 1);
+        }
+        pos = end + 1;
+    }
+    return std::string();
+}
+
+// "config=0x..." from a PMU events/ file
+bool parseConfig(const std::string& event, uint64_t& config) {
+    size_t pos = event.find("config=");
+    if (pos == std::string::npos) return false;
+    config = std::strtoull(event.c_str() + pos + 7, nullptr, 0);
+    return true;
+}
+
+} // namespace
+
+// libnvidia-ml entry points, resolved with dlsym so the app neither links against
+// nor requires the proprietary driver
+struct GpuTelemetry::Nvml {
+    using Device = void*;
+    struct Utilization { unsigned int gpu; unsigned int memory; };
+    struct Memory { unsigned long long total; unsigned long long free; unsigned long long used; };
+
+    enum { SUCCESS = 0, TEMPERATURE_GPU = 0, CLOCK_GRAPHICS = 0 };
+
+    void* library = nullptr;
+    Device device = nullptr;
+
+    int (*init)() = nullptr;
+    int (*shutdown)() = nullptr;
+    int (*handleByPciBusId)(const char*, Device*) = nullptr;
+    int (*handleByIndex)(unsigned int, Device*) = nullptr;
+    int (*name)(Device, char*, unsigned int) = nullptr;
+    int (*utilization)(Device, Utilization*) = nullptr;
+    int (*temperature)(Device, int, unsigned int*) = nullptr;
+    int (*clock)(Device, int, unsigned int*) = nullptr;
+    int (*power)(Device, unsigned int*) = nullptr;
+    int (*memory)(Device, Memory*) = nullptr;
+
+    template <typename T>
+    bool resolve(T& function, const char* symbol) {
+        function = reinterpret_cast<T>(dlsym(library, symbol));
+        return function != nullptr;
+    }
+
+    ~Nvml() {
+        if (shutdown && device) shutdown();
+        if (library) dlclose(library);
+    }
+};
+
+GpuTelemetry::GpuTelemetry(const std::string& drmRoot, const std::string& eventSourceRoot)
+    : m_backend(NONE)
+    , m_busyFd(-1)
+    , m_sclkFd(-1)
+    , m_freqFd(-1)
+    , m_vramUsedFd(-1)
+    , m_tempFd(-1)
+    , m_powerFd(-1)
+    , m_energyFd(-1)
+    , m_prevEnergy(0)
+    , m_havePrevEnergy(false)
+    , m_nvml(nullptr)
+    , m_havePrevious(false)
+{
+    discover(drmRoot);
+
+    const std::string card = drmRoot + "/" + m_cardName;
+    const std::string device = card + "/device";
+    switch (m_backend) {
+    case AMDGPU:
+        openAmdgpu(device);
+        break;
+    case I915:
+        openHwmon(device);
+        openI915(m_slot, eventSourceRoot);
+        break;
+    case XE:
+        openXe(device);
+        break;
+    case NVML:
+        openNvml(m_slot);
+        break;
+    case NOUVEAU:
+        openHwmon(device);
+        break;
+    case NONE:
+    case OTHER:
+        break;
+    }
+}
+
+GpuTelemetry::~GpuTelemetry() {
+    closeFd(m_busyFd);
+    closeFd(m_sclkFd);
+    closeFd(m_freqFd);
+    closeFd(m_vramUsedFd);
+    closeFd(m_tempFd);
+    closeFd(m_powerFd);
+    closeFd(m_energyFd);
+    closeFd(m_busy.fd);
+    closeFd(m_frequency.fd);
+    delete m_nvml;
+}
+
+// First display controller in PCI order (what `lspci` listed first), else any card
+// with a driver bound
+void GpuTelemetry::discover(const std::string& drmRoot) {
+    struct Card {
+        std::string name;
+        std::string slot;
+        std::string driver;
+        std::string vendorId;
+        bool display;
+    };
+    std::vector<Card> cards;
+
+    DIR* dir = opendir(drmRoot.c_str());
+    if (!dir) return;
+    while (dirent* entry = readdir(dir)) {
+        // card0, card1 ... but not connectors (card0-DP-1)
+        const char* name = entry->d_name;
+        if (std::strncmp(name, "card", 4) != 0 || std::strchr(name, '-')) continue;
+
+        const std::string device = drmRoot + "/" + name + "/device";
+        const std::string uevent = readAttribute(device + "/uevent");
+        Card card;
+        card.name = name;
+        card.slot = ueventValue(uevent, "PCI_SLOT_NAME");
+        card.driver = ueventValue(uevent, "DRIVER");
+        card.vendorId = readAttribute(device + "/vendor");
+        const std::string pciClass = readAttribute(device + "/class");
+        card.display = pciClass.compare(0, 6, "0x0300") == 0 || pciClass.compare(0, 6, "0x0302") == 0;
+        if (!card.driver.empty()) cards.push_back(card);
+    }
+    closedir(dir);
+    if (cards.empty()) return;
+
+    std::sort(cards.begin(), cards.end(), [](const Card& a, const Card& b) {
+        return a.display != b.display ? a.display : a.slot < b.slot;
+    });
+    const Card& card = cards.front();
+    m_cardName = card.name;
+    m_slot = card.slot;
+    m_driver = card.driver;
+
+    if (card.vendorId == "0x1002" || card.driver == "amdgpu") {
+        m_vendor = "AMD";
+    } else if (card.vendorId == "0x8086") {
+        m_vendor = "Intel";
+    } else if (card.vendorId == "0x10de") {
+        m_vendor = "NVIDIA";
+    }
+    m_model = m_vendor.empty() ? "GPU (" + m_driver + ")" : m_vendor + " (" + m_driver + ")";
+
+    if (m_driver == "amdgpu") {
+        m_backend = AMDGPU;
+    } else if (m_driver == "i915") {
+        m_backend = I915;
+    } else if (m_driver == "xe") {
+        m_backend = XE;
+    } else if (m_driver == "nvidia") {
+        m_backend = NVML;
+    } else if (m_driver == "nouveau") {
+        m_backend = NOUVEAU;
+    } else {
+        m_backend = OTHER;
+    }
+}
+
+// The card's own hwmon directory (device/hwmon/hwmonN), not a global scan by chip name,
+// so a second GPU of the same make can't be picked up by mistake
+void GpuTelemetry::openHwmon(const std::string& devicePath) {
+    const std::string root = devicePath + "/hwmon";
+    DIR* dir = opendir(root.c_str());
+    if (!dir) return;
+    std::string hwmon;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "hwmon", 5) == 0) {
+            hwmon = root + "/" + entry->d_name;
+            break;
+        }
+    }
+    closedir(dir);
+    if (hwmon.empty()) return;
+
+    m_tempFd = openAttribute(hwmon + "/temp1_input");              // amdgpu: edge
+    m_powerFd = openAttribute(hwmon + "/power1_average");
+    if (m_powerFd < 0) m_powerFd = openAttribute(hwmon + "/power1_input");
+    if (m_powerFd < 0) m_energyFd = openAttribute(hwmon + "/energy1_input");   // i915/xe discrete
+    if (m_freqFd < 0) m_freqFd = openAttribute(hwmon + "/freq1_input");        // amdgpu sclk, Hz
+}
+
+void GpuTelemetry::openAmdgpu(const std::string& devicePath) {
+    openHwmon(devicePath);
+    m_busyFd = openAttribute(devicePath + "/gpu_busy_percent");
+    m_sclkFd = openAttribute(devicePath + "/pp_dpm_sclk");
+    m_vramUsedFd = openAttribute(devicePath + "/mem_info_vram_used");
+
+    long long total = 0;
+    int totalFd = openAttribute(devicePath + "/mem_info_vram_total");
+    if (readInteger(totalFd, total) && total > 0) {
+        m_sample.memoryTotalMB = total / (1024.0 * 1024.0);
+    }
+    closeFd(totalFd);
+}
+
+bool GpuTelemetry::openCounter(Counter& counter, int type, int cpu, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = uint32_t(type);
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED;
+
+    // Uncore PMU: all processes, on the PMU's designated CPU
+    long fd = syscall(__NR_perf_event_open, &attr, -1, cpu, -1, PERF_FLAG_FD_CLOEXEC);
+    counter.fd = fd >= 0 ? int(fd) : -1;
+    return counter.fd >= 0;
+}
+
+// Counter increase per second of enabled time since the previous call, NaN until primed
+double GpuTelemetry::counterRate(Counter& counter) {
+    if (counter.fd < 0) return NAN;
+    uint64_t values[2];
+    if (::read(counter.fd, values, sizeof(values)) != ssize_t(sizeof(values))) return NAN;
+
+    double rate = NAN;
+    if (counter.primed && values[1] > counter.time) {
+        rate = double(values[0] - counter.value) / (double(values[1] - counter.time) * 1e-9);
+    }
+    counter.value = values[0];
+    counter.time = values[1];
+    counter.primed = true;
+    return rate;
+}
+
+// The i915 PMU needs CAP_PERFMON or kernel.perf_event_paranoid <= 0; without either
+// the counters stay closed and load/clock read as unavailable
+void GpuTelemetry::openI915(const std::string& slot, const std::string& eventSourceRoot) {
+    // Discrete cards register i915_<slot> (':' -> '_'), the integrated one plain "i915"
+    std::string discrete = "i915_" + slot;
+    std::replace(discrete.begin(), discrete.end(), ':', '_');
+    std::string pmu = eventSourceRoot + "/" + discrete;
+    std::string type = readAttribute(pmu + "/type");
+    if (type.empty()) {
+        pmu = eventSourceRoot + "/i915";
+        type = readAttribute(pmu + "/type");
+    }
+    if (type.empty()) return;
+
+    int cpu = std::atoi(readAttribute(pmu + "/cpumask").c_str());
+    uint64_t config = 0;
+    if (parseConfig(readAttribute(pmu + "/events/rcs0-busy"), config)) {
+        openCounter(m_busy, std::atoi(type.c_str()), cpu, config);
+    }
+    if (parseConfig(readAttribute(pmu + "/events/actual-frequency"), config)) {
+        openCounter(m_frequency, std::atoi(type.c_str()), cpu, config);
+    }
+}
+
+void GpuTelemetry::openXe(const std::string& devicePath) {
+    openHwmon(devicePath);
+    if (m_freqFd < 0) {
+        // MHz, unlike amdgpu's freq1_input in Hz; scaled in sample()
+        m_sclkFd = openAttribute(devicePath + "/tile0/gt0/freq0/act_freq");
+    }
+}
+
+void GpuTelemetry::openNvml(const std::string& slot) {
+    void* library = dlopen("libnvidia-ml.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!library) return;
+
+    Nvml* nvml = new Nvml;
+    nvml->library = library;
+    bool ok = nvml->resolve(nvml->init, "nvmlInit_v2")
+              && nvml->resolve(nvml->shutdown, "nvmlShutdown")
+              && nvml->resolve(nvml->handleByIndex, "nvmlDeviceGetHandleByIndex_v2");
+    nvml->resolve(nvml->handleByPciBusId, "nvmlDeviceGetHandleByPciBusId_v2");
+    nvml->resolve(nvml->name, "nvmlDeviceGetName");
+    nvml->resolve(nvml->utilization, "nvmlDeviceGetUtilizationRates");
+    nvml->resolve(nvml->temperature, "nvmlDeviceGetTemperature");
+    nvml->resolve(nvml->clock, "nvmlDeviceGetClockInfo");
+    nvml->resolve(nvml->power, "nvmlDeviceGetPowerUsage");
+    nvml->resolve(nvml->memory, "nvmlDeviceGetMemoryInfo");
+
+    if (!ok || nvml->init() != Nvml::SUCCESS) {
+        nvml->shutdown = nullptr;
+        delete nvml;
+        return;
+    }
+
+    Nvml::Device device = nullptr;
+    if (!(nvml->handleByPciBusId && !slot.empty() && nvml->handleByPciBusId(slot.c_str(), &device) == Nvml::SUCCESS)
+        && nvml->handleByIndex(0, &device) != Nvml::SUCCESS) {
+        nvml->shutdown();
+        nvml->shutdown = nullptr;
+        delete nvml;
+        return;
+    }
+    nvml->device = device;
+    m_nvml = nvml;
+
+    char name[96];
+    if (m_nvml->name && m_nvml->name(device, name, sizeof(name)) == Nvml::SUCCESS) {
+        m_model = name;
+    }
+    Nvml::Memory memory;
+    if (m_nvml->memory && m_nvml->memory(device, &memory) == Nvml::SUCCESS) {
+        m_sample.memoryTotalMB = memory.total / (1024.0 * 1024.0);
+    }
+}
+
+void GpuTelemetry::sampleHwmon(double seconds) {
+    long long value = 0;
+    if (readInteger(m_tempFd, value)) m_sample.temperature = value / 1000.0;
+    if (readInteger(m_powerFd, value)) m_sample.powerWatts = value / 1e6;
+    if (readInteger(m_freqFd, value) && value > 0) m_sample.clockMHz = value / 1e6;
+
+    if (readInteger(m_energyFd, value)) {
+        uint64_t energy = uint64_t(value);
+        if (m_havePrevEnergy && seconds > 0.0 && energy >= m_prevEnergy) {
+            m_sample.powerWatts = (energy - m_prevEnergy) / 1e6 / seconds;
+        }
+        m_prevEnergy = energy;
+        m_havePrevEnergy = true;
+    }
+}
+
+void GpuTelemetry::sampleAmdgpu() {
+    long long value = 0;
+    if (readInteger(m_busyFd, value)) m_sample.load = double(value);
+    if (readInteger(m_vramUsedFd, value)) m_sample.memoryUsedMB = value / (1024.0 * 1024.0);
+
+    // pp_dpm_sclk lists the DPM states, the active one marked '*': "1: 1800Mhz *"
+    if (std::isnan(m_sample.clockMHz) && m_sclkFd >= 0) {
+        char buf[512];
+        if (readAt(m_sclkFd, buf, sizeof(buf)) > 0) {
+            for (char* line = buf; line && *line; ) {
+                char* next = std::strchr(line, '\n');
+                if (next) *next++ = '\0';
+                const char* colon = std::strchr(line, ':');
+                if (colon && std::strchr(line, '*')) {
+                    m_sample.clockMHz = std::strtod(colon + 1, nullptr);
+                    break;
+                }
+                line = next;
+            }
+        }
+    }
+}
+
+void GpuTelemetry::sampleI915() {
+    // rcs0-busy counts busy ns, so ns per s of wall time -> percent
+    double busy = counterRate(m_busy);
+    if (!std::isnan(busy)) m_sample.load = std::clamp(busy / 1e7, 0.0, 100.0);
+
+    // actual-frequency accumulates MHz x s
+    double frequency = counterRate(m_frequency);
+    if (!std::isnan(frequency)) m_sample.clockMHz = frequency;
+}
+
+void GpuTelemetry::sampleNvml() {
+    if (!m_nvml) return;
+    Nvml::Device device = m_nvml->device;
+    unsigned int value = 0;
+
+    Nvml::Utilization utilization;
+    if (m_nvml->utilization && m_nvml->utilization(device, &utilization) == Nvml::SUCCESS) {
+        m_sample.load = utilization.gpu;
+    }
+    if (m_nvml->temperature && m_nvml->temperature(device, Nvml::TEMPERATURE_GPU, &value) == Nvml::SUCCESS) {
+        m_sample.temperature = value;
+    }
+    if (m_nvml->clock && m_nvml->clock(device, Nvml::CLOCK_GRAPHICS, &value) == Nvml::SUCCESS) {
+        m_sample.clockMHz = value;
+    }
+    if (m_nvml->power && m_nvml->power(device, &value) == Nvml::SUCCESS) {
+        m_sample.powerWatts = value / 1000.0;       // mW
+    }
+    Nvml::Memory memory;
+    if (m_nvml->memory && m_nvml->memory(device, &memory) == Nvml::SUCCESS) {
+        m_sample.memoryUsedMB = memory.used / (1024.0 * 1024.0);
+        m_sample.memoryTotalMB = memory.total / (1024.0 * 1024.0);
+    }
+}
+
+const GpuSample& GpuTelemetry::sample() {
+    Clock::time_point now = Clock::now();
+    double seconds = m_havePrevious ? std::chrono::duration<double>(now - m_lastSample).count() : 0.0;
+    m_lastSample = now;
+    m_havePrevious = true;
+
+    // Fields are refreshed in place; a source that stops answering (device asleep)
+    // reads as unavailable rather than repeating a stale value
+    double memoryTotal = m_sample.memoryTotalMB;
+    m_sample = GpuSample();
+    m_sample.memoryTotalMB = memoryTotal;
+
+    switch (m_backend) {
+    case AMDGPU:
+        sampleHwmon(seconds);
+        sampleAmdgpu();
+        break;
+    case I915:
+        sampleHwmon(seconds);
+        sampleI915();
+        break;
+    case XE: {
+        sampleHwmon(seconds);
+        long long mhz = 0;
+        if (readInteger(m_sclkFd, mhz) && mhz > 0) m_sample.clockMHz = double(mhz);
+        break;
+    }
+    case NVML:
+        sampleNvml();
+        break;
+    case NOUVEAU:
+        sampleHwmon(seconds);
+        break;
+    case NONE:
+    case OTHER:
+        break;
+    }
+    return m_sample;
+}
@@ -0,0 +1,115 @@
+/*---------------------------------------------------------*\
+||| gputelemetry.h                                          |
+|||                                                         |
+|||   Process-free GPU telemetry                           |
+|||   Finds the first display controller under            |
+|||   /sys/class/drm and reads it through the driver's own |
+|||   interfaces: amdgpu sysfs + hwmon, the i915 perf PMU, |
+|||   xe/nouveau hwmon, and libnvidia-ml loaded with       |
+|||   dlopen. Every field is NaN when its source is       |
+|||   missing, including on machines without a GPU.       |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+struct GpuSample {
+    double load          = NAN;     // %, busy share since the previous sample
+    double temperature   = NAN;     // °C
+    double clockMHz      = NAN;     // Current graphics clock
+    double powerWatts    = NAN;
+    double memoryUsedMB  = NAN;
+    double memoryTotalMB = NAN;
+};
+
+class GpuTelemetry {
+public:
+    enum Backend {
+        NONE,       // No display controller found
+        AMDGPU,     // gpu_busy_percent, pp_dpm_sclk, mem_info_vram_*, hwmon
+        I915,       // perf PMU (rcs0-busy, actual-frequency), hwmon on discrete cards
+        XE,         // hwmon and act_freq; no busy counter
+        NVML,       // libnvidia-ml.so.1 (proprietary driver)
+        NOUVEAU,    // hwmon only
+        OTHER       // Driver name only
+    };
+
+    explicit GpuTelemetry(const std::string& drmRoot = "/sys/class/drm",
+                          const std::string& eventSourceRoot = "/sys/bus/event_source/devices");
+    ~GpuTelemetry();
+
+    GpuTelemetry(const GpuTelemetry&) = delete;
+    GpuTelemetry& operator=(const GpuTelemetry&) = delete;
+
+    // Read every available counter; rates (load, i915 clock, energy-based power)
+    // need two samples and stay NaN on the first
+    const GpuSample& sample();
+    const GpuSample& last() const { return m_sample; }
+
+    Backend backend() const { return m_backend; }
+    const std::string& vendor() const { return m_vendor; }     // "AMD", "Intel", "NVIDIA" or ""
+    const std::string& model() const { return m_model; }
+    const std::string& driver() const { return m_driver; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Counter {
+        int fd = -1;
+        uint64_t value = 0;
+        uint64_t time = 0;      // ns the event has been enabled
+        bool primed = false;
+    };
+
+    struct Nvml;
+
+    void discover(const std::string& drmRoot);
+    void openHwmon(const std::string& devicePath);
+    void openAmdgpu(const std::string& devicePath);
+    void openI915(const std::string& slot, const std::string& eventSourceRoot);
+    void openXe(const std::string& devicePath);
+    void openNvml(const std::string& slot);
+
+    bool openCounter(Counter& counter, int type, int cpu, uint64_t config);
+    double counterRate(Counter& counter);
+
+    void sampleHwmon(double seconds);
+    void sampleAmdgpu();
+    void sampleI915();
+    void sampleNvml();
+
+    Backend m_backend;
+    std::string m_vendor;
+    std::string m_model;
+    std::string m_driver;
+    std::string m_cardName;     // card0
+    std::string m_slot;         // PCI address, 0000:03:00.0
+
+    // sysfs attributes kept open and read with pread
+    int m_busyFd;
+    int m_sclkFd;               // amdgpu pp_dpm_sclk, xe act_freq
+    int m_freqFd;
+    int m_vramUsedFd;
+    int m_tempFd;
+    int m_powerFd;
+    int m_energyFd;
+    uint64_t m_prevEnergy;
+    bool m_havePrevEnergy;
+
+    // i915 PMU
+    Counter m_busy;
+    Counter m_frequency;
+
+    Nvml* m_nvml;
+
+    bool m_havePrevious;
+    Clock::time_point m_lastSample;
+    GpuSample m_sample;
+};
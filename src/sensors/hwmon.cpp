@@ -0,0 +1,418 @@
+/*---------------------------------------------------------*\
+||| hwmon.cpp                                               |
+|||                                                         |
+|||   Direct hwmon reader                                  |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "hwmon.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Chips that report the CPU package, in the order the pages used to try them
+const std::vector<std::string> CPU_CHIPS = { "k10temp", "zenpower", "coretemp" };
+const std::vector<std::string> CPU_FALLBACK_CHIPS = { "k10temp", "zenpower", "coretemp", "asus", "acpi" };
+const std::vector<std::string> CPU_TEMP_LABELS = { "Tctl", "Tdie", "Package id 0" };
+const std::vector<std::string> CPU_VOLTAGE_LABELS = { "Vcore", "VCore", "CPU Core", "SVI2_Core", "VDDCR_CPU" };
+const std::vector<std::string> CPU_POWER_LABELS = { "SVI2_P_Core", "Package", "CPU Power" };
+
+const char* prefixFor(HwmonReader::Kind kind) {
+    switch (kind) {
+    case HwmonReader::TEMPERATURE: return "temp";
+    case HwmonReader::VOLTAGE:     return "in";
+    case HwmonReader::FAN:         return "fan";
+    case HwmonReader::POWER:       return "power";
+    }
+    return "";
+}
+
+double scaleFor(HwmonReader::Kind kind) {
+    switch (kind) {
+    case HwmonReader::TEMPERATURE: return 1e-3;     // millidegrees
+    case HwmonReader::VOLTAGE:     return 1e-3;     // millivolts
+    case HwmonReader::FAN:         return 1.0;      // RPM
+    case HwmonReader::POWER:       return 1e-6;     // microwatts
+    }
+    return 1.0;
+}
+
+// One short attribute (name, label); trailing newline stripped
+std::string readAttribute(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::string();
+    char buf[128];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) return std::string();
+    while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == ' ')) --n;
+    return std::string(buf, size_t(n));
+}
+
+std::string joinKey(HwmonReader::Kind kind, const std::vector<std::string>& chips,
+                    const std::vector<std::string>& labels) {
+    std::string key = prefixFor(kind);
+    key += '|';
+    for (const std::string& chip : chips) key += chip + ",";
+    key += '|';
+    for (const std::string& label : labels) key += label + ",";
+    return key;
+}
+
+bool matchesPrefix(const std::vector<std::string>& prefixes, const std::string& value) {
+    return std::any_of(prefixes.begin(), prefixes.end(), [&](const std::string& prefix) {
+        return value.compare(0, prefix.size(), prefix) == 0;
+    });
+}
+
+void makeParentDirs(const std::string& file) {
+    for (size_t pos = file.find('/', 1); pos != std::string::npos; pos = file.find('/', pos + 1)) {
+        mkdir(file.substr(0, pos).c_str(), 0755);
+    }
+}
+
+} // namespace
+
+HwmonReader::HwmonReader(const std::string& root, const std::string& cacheFile)
+    : m_root(root)
+    , m_cacheFile(cacheFile)
+    , m_scanned(false)
+    , m_cpuTempResolved(false)
+    , m_cpuTemp(-1)
+    , m_cpuVoltageResolved(false)
+    , m_cpuPower(-1)
+    , m_cpuPowerResolved(false)
+{
+    loadCache();
+}
+
+HwmonReader::~HwmonReader() {
+    for (Channel& channel : m_channels) {
+        if (channel.fd >= 0) close(channel.fd);
+    }
+}
+
+std::string HwmonReader::defaultCacheFile() {
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) {
+        return std::string(xdg) + "/LConnect3/hwmon.cache";
+    }
+    const char* home = std::getenv("HOME");
+    return std::string(home && *home ? home : "/tmp") + "/.cache/LConnect3/hwmon.cache";
+}
+
+void HwmonReader::rescan() {
+    for (Channel& channel : m_channels) {
+        if (channel.fd >= 0) close(channel.fd);
+    }
+    m_channels.clear();
+    m_resolved.clear();
+    m_chips.clear();
+    m_scanned = false;
+    m_cpuTempResolved = false;
+    m_cpuTemp = -1;
+    m_cpuTempFallback.clear();
+    m_cpuVoltageResolved = false;
+    m_cpuVoltage.clear();
+    m_cpuPowerResolved = false;
+    m_cpuPower = -1;
+    m_thermalZones.clear();
+}
+
+const std::vector<HwmonReader::Chip>& HwmonReader::chips() {
+    if (m_scanned) return m_chips;
+    m_scanned = true;
+
+    DIR* dir = opendir(m_root.c_str());
+    if (!dir) return m_chips;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "hwmon", 5) != 0) continue;
+        Chip chip;
+        chip.dir = m_root + "/" + entry->d_name;
+        chip.name = readAttribute(chip.dir + "/name");
+        if (!chip.name.empty()) m_chips.push_back(chip);
+    }
+    closedir(dir);
+
+    // hwmon10 after hwmon9
+    std::sort(m_chips.begin(), m_chips.end(), [](const Chip& a, const Chip& b) {
+        return a.dir.size() != b.dir.size() ? a.dir.size() < b.dir.size() : a.dir < b.dir;
+    });
+    return m_chips;
+}
+
+std::vector<HwmonReader::Channel> HwmonReader::scanChannels(const Chip& chip, Kind kind) const {
+    std::vector<Channel> channels;
+    const char* prefix = prefixFor(kind);
+    size_t prefixLength = std::strlen(prefix);
+
+    DIR* dir = opendir(chip.dir.c_str());
+    if (!dir) return channels;
+    while (dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (std::strncmp(name, prefix, prefixLength) != 0) continue;
+        const char* rest = name + prefixLength;
+        char* end = nullptr;
+        long index = std::strtol(rest, &end, 10);
+        if (end == rest) continue;
+
+        // Power meters expose either an average or an instantaneous input
+        bool input = std::strcmp(end, "_input") == 0;
+        bool average = kind == POWER && std::strcmp(end, "_average") == 0;
+        if (!input && !average) continue;
+
+        std::string base = chip.dir + "/" + std::string(name, size_t(end - name));
+        Channel channel;
+        channel.kind = kind;
+        channel.path = chip.dir + "/" + name;
+        channel.chip = chip.name;
+        channel.label = readAttribute(base + "_label");
+        if (channel.label.empty()) channel.label = std::string(prefix) + std::to_string(index);
+        channel.fd = -1;
+
+        // Prefer _average over _input for the same power meter
+        auto same = std::find_if(channels.begin(), channels.end(), [&](const Channel& c) {
+            return c.label == channel.label;
+        });
+        if (same != channels.end()) {
+            if (average) *same = channel;
+            continue;
+        }
+        channels.push_back(channel);
+    }
+    closedir(dir);
+
+    std::sort(channels.begin(), channels.end(), [](const Channel& a, const Channel& b) {
+        return a.path.size() != b.path.size() ? a.path.size() < b.path.size() : a.path < b.path;
+    });
+    return channels;
+}
+
+int HwmonReader::addChannel(const Channel& channel) {
+    for (size_t i = 0; i < m_channels.size(); ++i) {
+        if (m_channels[i].path == channel.path) return int(i);
+    }
+    Channel opened = channel;
+    opened.fd = open(channel.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (opened.fd < 0) return -1;
+    m_channels.push_back(opened);
+    return int(m_channels.size() - 1);
+}
+
+// hwmonN numbering is not stable across boots, so a cached path only counts if the
+// chip and label behind it are still the ones it was resolved for
+bool HwmonReader::validateCached(const CacheEntry& entry) const {
+    size_t slash = entry.path.rfind('/');
+    if (slash == std::string::npos) return false;
+    std::string dir = entry.path.substr(0, slash);
+    if (readAttribute(dir + "/name") != entry.chip) return false;
+
+    std::string file = entry.path.substr(slash + 1);
+    size_t underscore = file.find('_');
+    std::string label = readAttribute(dir + "/" + file.substr(0, underscore) + "_label");
+    if (label.empty()) label = file.substr(0, underscore);
+    return label == entry.label && access(entry.path.c_str(), R_OK) == 0;
+}
+
+int HwmonReader::resolve(Kind kind, const std::vector<std::string>& chipNames,
+                         const std::vector<std::string>& labels) {
+    std::string key = joinKey(kind, chipNames, labels);
+    auto known = m_resolved.find(key);
+    if (known != m_resolved.end()) return known->second;
+
+    // Last run's answer, if it still points at the same sensor
+    auto cached = m_cache.find(key);
+    if (cached != m_cache.end() && validateCached(cached->second)) {
+        Channel channel{ kind, cached->second.path, cached->second.chip, cached->second.label, -1 };
+        int handle = addChannel(channel);
+        if (handle >= 0) {
+            m_resolved[key] = handle;
+            return handle;
+        }
+    }
+
+    // Full scan: chips in the requested order, then labels in the requested order
+    int handle = -1;
+    for (const std::string& wanted : chipNames) {
+        for (const Chip& chip : chips()) {
+            if (chip.name != wanted) continue;
+            std::vector<Channel> channels = scanChannels(chip, kind);
+            if (labels.empty()) {
+                if (!channels.empty()) handle = addChannel(channels.front());
+            } else {
+                for (const std::string& label : labels) {
+                    auto match = std::find_if(channels.begin(), channels.end(), [&](const Channel& c) {
+                        return c.label == label;
+                    });
+                    if (match != channels.end()) {
+                        handle = addChannel(*match);
+                        break;
+                    }
+                }
+            }
+            if (handle >= 0) break;
+        }
+        if (handle >= 0) break;
+    }
+
+    m_resolved[key] = handle;
+    if (handle >= 0) {
+        const Channel& channel = m_channels[size_t(handle)];
+        m_cache[key] = CacheEntry{ channel.path, channel.chip, channel.label };
+        saveCache();
+    }
+    return handle;
+}
+
+std::vector<int> HwmonReader::resolveAll(Kind kind, const std::vector<std::string>& chipNames) {
+    std::vector<int> handles;
+    for (const Chip& chip : chips()) {
+        if (!matchesPrefix(chipNames, chip.name)) continue;
+        for (const Channel& channel : scanChannels(chip, kind)) {
+            int handle = addChannel(channel);
+            if (handle >= 0) handles.push_back(handle);
+        }
+    }
+    return handles;
+}
+
+double HwmonReader::read(int handle) {
+    if (handle < 0 || handle >= int(m_channels.size())) return NAN;
+    Channel& channel = m_channels[size_t(handle)];
+    if (channel.fd < 0) return NAN;
+
+    char buf[32];
+    ssize_t n = pread(channel.fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return NAN;     // ENODATA etc. while the device sleeps
+    buf[n] = '\0';
+
+    char* end = nullptr;
+    long long raw = std::strtoll(buf, &end, 10);
+    if (end == buf) return NAN;
+    return raw * scaleFor(channel.kind);
+}
+
+double HwmonReader::readMax(const std::vector<int>& handles) {
+    double best = NAN;
+    for (int handle : handles) {
+        double value = read(handle);
+        if (!std::isnan(value) && (std::isnan(best) || value > best)) best = value;
+    }
+    return best;
+}
+
+std::string HwmonReader::chip(int handle) const {
+    return handle >= 0 && handle < int(m_channels.size()) ? m_channels[size_t(handle)].chip : std::string();
+}
+
+std::string HwmonReader::label(int handle) const {
+    return handle >= 0 && handle < int(m_channels.size()) ? m_channels[size_t(handle)].label : std::string();
+}
+
+double HwmonReader::cpuTemperature() {
+    if (!m_cpuTempResolved) {
+        m_cpuTempResolved = true;
+        m_cpuTemp = resolve(TEMPERATURE, CPU_CHIPS, CPU_TEMP_LABELS);
+        if (m_cpuTemp < 0) {
+            m_cpuTempFallback = resolveAll(TEMPERATURE, CPU_FALLBACK_CHIPS);
+        }
+        if (m_cpuTemp < 0 && m_cpuTempFallback.empty()) {
+            // Last resort: ACPI thermal zones
+            DIR* dir = opendir("/sys/class/thermal");
+            if (dir) {
+                while (dirent* entry = readdir(dir)) {
+                    if (std::strncmp(entry->d_name, "thermal_zone", 12) != 0) continue;
+                    std::string path = std::string("/sys/class/thermal/") + entry->d_name + "/temp";
+                    int handle = addChannel(Channel{ TEMPERATURE, path, entry->d_name, "temp", -1 });
+                    if (handle >= 0) m_thermalZones.push_back(handle);
+                }
+                closedir(dir);
+            }
+        }
+    }
+
+    if (m_cpuTemp >= 0) return read(m_cpuTemp);
+
+    double value = readMax(m_cpuTempFallback.empty() ? m_thermalZones : m_cpuTempFallback);
+    return value > 0.0 && value < 200.0 ? value : NAN;
+}
+
+double HwmonReader::cpuVoltage() {
+    if (!m_cpuVoltageResolved) {
+        m_cpuVoltageResolved = true;
+        int labelled = resolve(VOLTAGE, CPU_FALLBACK_CHIPS, CPU_VOLTAGE_LABELS);
+        if (labelled >= 0) {
+            m_cpuVoltage.push_back(labelled);
+        } else {
+            m_cpuVoltage = resolveAll(VOLTAGE, CPU_FALLBACK_CHIPS);
+        }
+    }
+
+    // First input in a plausible core voltage range
+    for (int handle : m_cpuVoltage) {
+        double volts = read(handle);
+        if (volts > 0.5 && volts < 2.0) return volts;
+    }
+    return NAN;
+}
+
+double HwmonReader::cpuPower() {
+    if (!m_cpuPowerResolved) {
+        m_cpuPowerResolved = true;
+        m_cpuPower = resolve(POWER, CPU_FALLBACK_CHIPS, CPU_POWER_LABELS);
+        if (m_cpuPower < 0) {
+            m_cpuPower = resolve(POWER, CPU_FALLBACK_CHIPS);
+        }
+    }
+    double watts = read(m_cpuPower);
+    return watts > 0.0 && watts <= 500.0 ? watts : NAN;
+}
+
+double HwmonReader::gpuTemperature(const std::string& driver) {
+    // amdgpu labels its die sensor "edge"; the others have a single unlabelled input
+    int handle = resolve(TEMPERATURE, { driver }, { "edge", "temp1" });
+    if (handle < 0) handle = resolve(TEMPERATURE, { driver });
+    return read(handle);
+}
+
+void HwmonReader::loadCache() {
+    std::ifstream in(m_cacheFile);
+    std::string line;
+    while (std::getline(in, line)) {
+        // key \t path \t chip \t label
+        size_t a = line.find('\t');
+        size_t b = a == std::string::npos ? a : line.find('\t', a + 1);
+        size_t c = b == std::string::npos ? b : line.find('\t', b + 1);
+        if (c == std::string::npos) continue;
+        m_cache[line.substr(0, a)] = CacheEntry{ line.substr(a + 1, b - a - 1),
+                                                 line.substr(b + 1, c - b - 1),
+                                                 line.substr(c + 1) };
+    }
+}
+
+void HwmonReader::saveCache() const {
+    if (m_cacheFile.empty()) return;
+    makeParentDirs(m_cacheFile);
+
+    std::string temp = m_cacheFile + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out) return;
+        for (const auto& entry : m_cache) {
+            out << entry.first << '\t' << entry.second.path << '\t'
+                << entry.second.chip << '\t' << entry.second.label << '\n';
+        }
+    }
+    std::rename(temp.c_str(), m_cacheFile.c_str());
+}
@@ -0,0 +1,111 @@
+/*---------------------------------------------------------*\
+||| hwmon.h                                                 |
+|||                                                         |
+|||   Direct hwmon reader                                  |
+|||   Resolves tempN/inN/fanN/powerN inputs once by chip   |
+|||   name and label, remembers the resolved paths across |
+|||   runs, keeps the files open and reads them with      |
+|||   pread into fixed buffers - no `sensors` forks.       |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Not thread-safe: use one reader per thread (the SensorHub owns the app's reader)
+class HwmonReader {
+public:
+    enum Kind {
+        TEMPERATURE,    // tempN_input, °C
+        VOLTAGE,        // inN_input, V
+        FAN,            // fanN_input, RPM
+        POWER           // powerN_average / powerN_input, W
+    };
+
+    explicit HwmonReader(const std::string& root = "/sys/class/hwmon",
+                         const std::string& cacheFile = defaultCacheFile());
+    ~HwmonReader();
+
+    HwmonReader(const HwmonReader&) = delete;
+    HwmonReader& operator=(const HwmonReader&) = delete;
+
+    // $XDG_CACHE_HOME/LConnect3/hwmon.cache (~/.cache when unset)
+    static std::string defaultCacheFile();
+
+    // First channel of the given kind on a chip named one of `chips`, whose label is
+    // one of `labels` (earlier entries win; empty list = any label). Returns a handle
+    // for read(), or -1. Results are memoised and persisted in the cache file.
+    int resolve(Kind kind, const std::vector<std::string>& chips,
+                const std::vector<std::string>& labels = {});
+
+    // Every channel of the given kind on chips whose name starts with one of `chips`
+    std::vector<int> resolveAll(Kind kind, const std::vector<std::string>& chips);
+
+    // Scaled value (°C, V, RPM or W), NaN when the read fails
+    double read(int handle);
+
+    // Highest value among the handles, NaN when none could be read
+    double readMax(const std::vector<int>& handles);
+
+    std::string chip(int handle) const;
+    std::string label(int handle) const;
+
+    // Well-known readings, resolved on first use
+    double cpuTemperature();    // k10temp Tctl, zenpower Tdie, coretemp package; else hottest CPU input
+    double cpuVoltage();        // Core voltage in the 0.5-2.0 V range
+    double cpuPower();          // Core/package power where the driver exposes it (zenpower)
+    double gpuTemperature(const std::string& driver);   // "amdgpu", "i915", "xe", "nouveau"
+
+    // Close everything and scan again on the next request (modules loaded or removed)
+    void rescan();
+
+private:
+    struct Chip {
+        std::string dir;
+        std::string name;
+    };
+
+    struct Channel {
+        Kind kind;
+        std::string path;
+        std::string chip;
+        std::string label;
+        int fd;
+    };
+
+    struct CacheEntry {
+        std::string path;
+        std::string chip;
+        std::string label;
+    };
+
+    const std::vector<Chip>& chips();
+    std::vector<Channel> scanChannels(const Chip& chip, Kind kind) const;
+    int addChannel(const Channel& channel);
+    bool validateCached(const CacheEntry& entry) const;
+    void loadCache();
+    void saveCache() const;
+
+    std::string m_root;
+    std::string m_cacheFile;
+
+    bool m_scanned;
+    std::vector<Chip> m_chips;
+    std::vector<Channel> m_channels;
+    std::map<std::string, int> m_resolved;              // Request key -> handle (-1 = none)
+    std::map<std::string, CacheEntry> m_cache;          // Request key -> last resolved channel
+
+    bool m_cpuTempResolved;
+    int m_cpuTemp;
+    std::vector<int> m_cpuTempFallback;
+    bool m_cpuVoltageResolved;
+    std::vector<int> m_cpuVoltage;
+    int m_cpuPower;
+    bool m_cpuPowerResolved;
+    std::vector<int> m_thermalZones;
+};
@@ -0,0 +1,73 @@
+/*---------------------------------------------------------*\
+||| loadsampler.cpp                                         |
+|||                                                         |
+|||   CPU utilization for fan control                      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "loadsampler.h"
+#include "procfs.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Read a small file from offset 0 into buf (NUL-terminated); returns bytes read or -1
+ssize_t readAt(int fd, char* buf, size_t size) {
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    if (n < 0) return -1;
+    buf[n] = '\0';
+    return n;
+}
+
+} // namespace
+
+LoadSampler::LoadSampler(const std::string& procRoot)
+    : m_statFd(open((procRoot + "/stat").c_str(), O_RDONLY | O_CLOEXEC))
+    , m_minInterval(250)
+    , m_havePrevious(false)
+    , m_prevBusy(0)
+    , m_prevTotal(0)
+{
+}
+
+LoadSampler::~LoadSampler() {
+    if (m_statFd >= 0) close(m_statFd);
+}
+
+bool LoadSampler::readCpuTimes(uint64_t& busy, uint64_t& total) {
+    if (m_statFd < 0) return false;
+
+    // Only the aggregate line is needed, and it always comes first
+    char buf[512];
+    if (readAt(m_statFd, buf, sizeof(buf)) < 5) return false;
+
+    CpuTimes times;
+    if (parseStat(buf, times) < 0) return false;
+    busy = times.busy();
+    total = times.total();
+    return true;
+}
+
+const LoadSample& LoadSampler::sample() {
+    Clock::time_point now = Clock::now();
+    if (m_havePrevious && now - m_lastRead < m_minInterval) {
+        return m_sample;
+    }
+
+    uint64_t busy = 0, total = 0;
+    if (readCpuTimes(busy, total)) {
+        if (m_havePrevious && total > m_prevTotal) {
+            m_sample.utilization = std::clamp(double(busy - m_prevBusy) / double(total - m_prevTotal), 0.0, 1.0);
+        }
+        m_prevBusy = busy;
+        m_prevTotal = total;
+    }
+
+    m_lastRead = now;
+    m_havePrevious = true;
+    return m_sample;
+}
@@ -0,0 +1,54 @@
+/*---------------------------------------------------------*\
+||| loadsampler.h                                           |
+|||                                                         |
+|||   CPU utilization for fan control                      |
+|||   Leads the die temperature by seconds, so the fan     |
+|||   controller uses it as a feedforward input. Reads     |
+|||   /proc/stat through an fd kept open between samples.  |
+|||   Package power comes from PowerCollector.             |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+struct LoadSample {
+    double utilization  = NAN;  // 0-1, busy share of all CPUs since the previous sample
+};
+
+class LoadSampler {
+public:
+    explicit LoadSampler(const std::string& procRoot = "/proc");
+    ~LoadSampler();
+
+    LoadSampler(const LoadSampler&) = delete;
+    LoadSampler& operator=(const LoadSampler&) = delete;
+
+    // Read /proc/stat, at most once per minimum interval; calls in between
+    // return the previous sample. NaN until two readings exist.
+    const LoadSample& sample();
+    const LoadSample& last() const { return m_sample; }
+
+    void setMinInterval(std::chrono::milliseconds interval) { m_minInterval = interval; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool readCpuTimes(uint64_t& busy, uint64_t& total);
+
+    int m_statFd;
+
+    std::chrono::milliseconds m_minInterval;
+    Clock::time_point m_lastRead;
+    bool m_havePrevious;
+    uint64_t m_prevBusy;
+    uint64_t m_prevTotal;
+
+    LoadSample m_sample;
+};
@@ -0,0 +1,222 @@
+/*---------------------------------------------------------*\
+||| powercollector.cpp                                      |
+|||                                                         |
+|||   CPU energy counters as per-domain power              |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "powercollector.h"
+#include "procfs.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace procfs;
+
+namespace {
+
+// Anything above this between two reads is a glitch (counter reset, firmware hiccup)
+const double MAX_PLAUSIBLE_WATTS = 5000.0;
+
+bool readFileOnce(const std::string& path, char* buf, size_t size) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    close(fd);
+    if (n <= 0) return false;
+    buf[n] = '\0';
+    // Drop the trailing newline so names compare cleanly
+    while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == ' ')) buf[--n] = '\0';
+    return true;
+}
+
+bool readCounter(int fd, uint64_t& value) {
+    char buf[32];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return false;
+    buf[n] = '\0';
+    const char* p = buf;
+    value = scanU64(p);
+    return p != buf;
+}
+
+std::vector<std::string> listDir(const std::string& path) {
+    std::vector<std::string> names;
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return names;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+PowerDomain::Kind zoneKind(const char* name) {
+    if (std::strncmp(name, "package", 7) == 0) return PowerDomain::PACKAGE;
+    if (std::strcmp(name, "core") == 0) return PowerDomain::CORE;
+    if (std::strcmp(name, "uncore") == 0) return PowerDomain::UNCORE;
+    if (std::strcmp(name, "dram") == 0) return PowerDomain::DRAM;
+    if (std::strcmp(name, "psys") == 0) return PowerDomain::PSYS;
+    return PowerDomain::OTHER;
+}
+
+} // namespace
+
+PowerCollector::PowerCollector(const std::string& powercapRoot, const std::string& hwmonRoot)
+    : m_unreadable(0)
+{
+    std::fill(m_totals, m_totals + PowerDomain::KIND_COUNT, NAN);
+    scanPowercap(powercapRoot);
+
+    // amd_energy reads the same RAPL MSRs; only use it when powercap has no package
+    bool havePackage = std::any_of(m_domains.begin(), m_domains.end(), [](const PowerDomain& d) {
+        return d.kind == PowerDomain::PACKAGE;
+    });
+    if (!havePackage) scanAmdEnergy(hwmonRoot);
+}
+
+PowerCollector::~PowerCollector() {
+    for (const Counter& counter : m_counters) close(counter.fd);
+}
+
+const char* PowerCollector::kindName(PowerDomain::Kind kind) {
+    switch (kind) {
+    case PowerDomain::PACKAGE: return "Package";
+    case PowerDomain::CORE: return "Core";
+    case PowerDomain::UNCORE: return "Uncore";
+    case PowerDomain::DRAM: return "DRAM";
+    case PowerDomain::PSYS: return "Platform";
+    default: return "Other";
+    }
+}
+
+bool PowerCollector::addCounter(const std::string& path, uint64_t range, PowerDomain domain) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    uint64_t probe = 0;
+    if (fd < 0 || !readCounter(fd, probe)) {
+        if (fd < 0 && errno == EACCES) ++m_unreadable;
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    domain.path = path;
+    m_domains.push_back(domain);
+    m_counters.push_back({ fd, range, 0, Clock::time_point(), false });
+    return true;
+}
+
+// intel-rapl:0 (package-0), intel-rapl:0:0 (core), intel-rapl:0:1 (uncore),
+// intel-rapl:0:2 (dram), intel-rapl:1 (psys or package-1). AMD's RAPL driver uses
+// the same names. The intel-rapl-mmio copy of the package zone is skipped.
+void PowerCollector::scanPowercap(const std::string& root) {
+    for (const std::string& zone : listDir(root)) {
+        size_t colon = zone.find(':');
+        if (colon == std::string::npos || zone.find("mmio") != std::string::npos) continue;
+
+        const std::string dir = root + "/" + zone;
+        char name[64];
+        if (!readFileOnce(dir + "/name", name, sizeof(name))) continue;
+
+        PowerDomain domain;
+        domain.kind = zoneKind(name);
+        domain.name = name;
+        const char* p = zone.c_str() + colon + 1;
+        domain.socket = int(scanU64(p));
+        if (domain.kind == PowerDomain::PACKAGE) {
+            // package-N names the socket even when zone numbering differs
+            const char* n = name + 7;
+            if (*n == '-') ++n;
+            if (*n >= '0' && *n <= '9') domain.socket = int(scanU64(n));
+        }
+
+        char range[32];
+        uint64_t maxRange = 0;
+        if (readFileOnce(dir + "/max_energy_range_uj", range, sizeof(range))) {
+            const char* r = range;
+            maxRange = scanU64(r);
+        }
+        addCounter(dir + "/energy_uj", maxRange, domain);
+    }
+}
+
+// amd_energy: energyN_input in µJ, labelled Esocket0.. and Ecore000..; the driver
+// accumulates the 32-bit MSRs into 64 bits itself, so there is no wrap to undo
+void PowerCollector::scanAmdEnergy(const std::string& root) {
+    for (const std::string& entry : listDir(root)) {
+        const std::string dir = root + "/" + entry;
+        char chip[64];
+        if (!readFileOnce(dir + "/name", chip, sizeof(chip)) || std::strcmp(chip, "amd_energy") != 0) continue;
+
+        for (const std::string& file : listDir(dir)) {
+            if (file.compare(0, 6, "energy") != 0 || file.size() < 13
+                || file.compare(file.size() - 6, 6, "_input") != 0) continue;
+
+            char label[64];
+            const std::string prefix = dir + "/" + file.substr(0, file.size() - 6);
+            if (!readFileOnce(prefix + "_label", label, sizeof(label))) continue;
+
+            PowerDomain domain;
+            domain.name = label;
+            const char* p = label;
+            if (std::strncmp(label, "Esocket", 7) == 0) {
+                domain.kind = PowerDomain::PACKAGE;
+                p += 7;
+            } else if (std::strncmp(label, "Ecore", 5) == 0) {
+                domain.kind = PowerDomain::CORE;
+                p += 5;
+            }
+            domain.socket = domain.kind == PowerDomain::PACKAGE ? int(scanU64(p)) : 0;
+            addCounter(dir + "/" + file, 0, domain);
+        }
+    }
+}
+
+const std::vector<PowerDomain>& PowerCollector::sample() {
+    std::fill(m_totals, m_totals + PowerDomain::KIND_COUNT, NAN);
+
+    for (size_t i = 0; i < m_domains.size(); ++i) {
+        PowerDomain& domain = m_domains[i];
+        Counter& counter = m_counters[i];
+
+        uint64_t energy = 0;
+        Clock::time_point now = Clock::now();
+        if (!readCounter(counter.fd, energy)) {
+            domain.watts = NAN;
+            counter.havePrevious = false;
+            continue;
+        }
+
+        double watts = NAN;
+        const double seconds = std::chrono::duration<double>(now - counter.previousTime).count();
+        if (counter.havePrevious && seconds > 0.0) {
+            bool valid = true;
+            uint64_t delta = 0;
+            if (energy >= counter.previous) {
+                delta = energy - counter.previous;
+            } else if (counter.range > counter.previous) {
+                // Wrapped past max_energy_range_uj back to 0
+                delta = (counter.range - counter.previous) + energy;
+            } else {
+                valid = false;      // Reset without a known range
+            }
+            watts = delta / 1e6 / seconds;
+            if (!valid || watts > MAX_PLAUSIBLE_WATTS) watts = NAN;
+        }
+
+        domain.watts = watts;
+        counter.previous = energy;
+        counter.previousTime = now;
+        counter.havePrevious = true;
+
+        if (!std::isnan(watts)) {
+            double& total = m_totals[domain.kind];
+            total = (std::isnan(total) ? 0.0 : total) + watts;
+        }
+    }
+    return m_domains;
+}
@@ -0,0 +1,84 @@
+/*---------------------------------------------------------*\
+||| powercollector.h                                        |
+|||                                                         |
+|||   CPU energy counters as per-domain power              |
+|||   Enumerates every powercap zone and sub-zone          |
+|||   (package, core, uncore, dram, psys) and, where no    |
+|||   powercap package exists, the amd_energy hwmon        |
+|||   counters. Watts come from monotonic energy deltas,   |
+|||   corrected for max_energy_range_uj wraparound.        |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct PowerDomain {
+    enum Kind {
+        PACKAGE,        // Whole socket
+        CORE,           // PP0, or one amd_energy core
+        UNCORE,         // PP1 / integrated graphics
+        DRAM,
+        PSYS,           // Platform (SoC + rest of the board), laptops
+        OTHER,
+        KIND_COUNT
+    };
+
+    Kind kind = OTHER;
+    std::string name;           // Zone name ("package-0", "core") or hwmon label ("Esocket0")
+    std::string path;           // Counter file
+    int socket = 0;
+    double watts = NAN;         // Since the previous sample, NaN on the first
+};
+
+class PowerCollector {
+public:
+    explicit PowerCollector(const std::string& powercapRoot = "/sys/class/powercap",
+                            const std::string& hwmonRoot = "/sys/class/hwmon");
+    ~PowerCollector();
+
+    PowerCollector(const PowerCollector&) = delete;
+    PowerCollector& operator=(const PowerCollector&) = delete;
+
+    // Read every counter once
+    const std::vector<PowerDomain>& sample();
+    const std::vector<PowerDomain>& domains() const { return m_domains; }
+
+    // Sum over all domains of a kind (several sockets, amd_energy cores), NaN if none
+    double watts(PowerDomain::Kind kind) const { return m_totals[kind]; }
+    double packageWatts() const { return m_totals[PowerDomain::PACKAGE]; }
+
+    bool empty() const { return m_domains.empty(); }
+
+    // Zones that exist but whose energy_uj is root-only (kernels since 5.10)
+    int unreadableZones() const { return m_unreadable; }
+
+    static const char* kindName(PowerDomain::Kind kind);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Counter {
+        int fd;
+        uint64_t range;         // Wraps back to 0 after this many µJ; 0 = no wrap
+        uint64_t previous;
+        Clock::time_point previousTime;
+        bool havePrevious;
+    };
+
+    void scanPowercap(const std::string& root);
+    void scanAmdEnergy(const std::string& root);
+    bool addCounter(const std::string& path, uint64_t range, PowerDomain domain);
+
+    std::vector<PowerDomain> m_domains;
+    std::vector<Counter> m_counters;    // Parallel to m_domains
+    double m_totals[PowerDomain::KIND_COUNT];
+    int m_unreadable;
+};
@@ -0,0 +1,179 @@
+/*---------------------------------------------------------*\
+||| procfs.cpp                                              |
+|||                                                         |
+|||   Allocation-free /proc readers                        |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "procfs.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace procfs;
+
+ProcFile::ProcFile(const std::string& path, size_t initialSize)
+    : m_fd(open(path.c_str(), O_RDONLY | O_CLOEXEC))
+    , m_buffer(initialSize < 64 ? 64 : initialSize)
+{
+}
+
+ProcFile::~ProcFile() {
+    if (m_fd >= 0) close(m_fd);
+}
+
+const char* ProcFile::read(size_t* length) {
+    if (m_fd < 0) return nullptr;
+
+    // procfs generates the text on each read; keep reading until EOF so a file that
+    // outgrew the buffer (CPU hotplug, new interfaces) still comes back whole
+    size_t used = 0;
+    for (;;) {
+        if (m_buffer.size() - used < 2) m_buffer.resize(m_buffer.size() * 2);
+        ssize_t n = pread(m_fd, m_buffer.data() + used, m_buffer.size() - used - 1, off_t(used));
+        if (n < 0) return nullptr;
+        if (n == 0) break;
+        used += size_t(n);
+    }
+    m_buffer[used] = '\0';
+    if (length) *length = used;
+    return m_buffer.data();
+}
+
+int parseStat(const char* text, CpuTimes& total, CpuTimes* cores, int maxCores) {
+    if (!text) return -1;
+    bool haveTotal = false;
+    int coreCount = 0;
+
+    // cpu  user nice system idle iowait irq softirq steal guest guest_nice
+    // cpu0 ...
+    for (const char* p = text; *p; p = nextLine(p)) {
+        if (p[0] != 'c' || p[1] != 'p' || p[2] != 'u') {
+            // The cpu lines come first; nothing after them is needed
+            if (haveTotal) break;
+            continue;
+        }
+        p += 3;
+        CpuTimes* times = nullptr;
+        if (*p == ' ') {
+            times = &total;
+            haveTotal = true;
+        } else {
+            int core = int(scanU64(p));
+            coreCount = std::max(coreCount, core + 1);
+            if (cores && core < maxCores) times = &cores[core];
+        }
+        if (!times) continue;
+
+        times->user = scanU64(p);
+        times->nice = scanU64(p);
+        times->system = scanU64(p);
+        times->idle = scanU64(p);
+        times->iowait = scanU64(p);
+        times->irq = scanU64(p);
+        times->softirq = scanU64(p);
+        times->steal = scanU64(p);
+    }
+    return haveTotal ? coreCount : -1;
+}
+
+bool parseMeminfo(const char* text, MemInfo& info) {
+    if (!text) return false;
+    info = MemInfo();
+    bool haveTotal = false;
+    int found = 0;
+
+    // Key:      12345 kB
+    for (const char* p = text; *p; p = nextLine(p)) {
+        uint64_t* field = nullptr;
+        switch (p[0]) {
+        case 'M':
+            if (startsWith(p, "MemTotal:")) { field = &info.totalKB; haveTotal = true; }
+            else if (startsWith(p, "MemFree:")) field = &info.freeKB;
+            else if (startsWith(p, "MemAvailable:")) field = &info.availableKB;
+            break;
+        case 'B':
+            if (startsWith(p, "Buffers:")) field = &info.buffersKB;
+            break;
+        case 'C':
+            if (startsWith(p, "Cached:")) field = &info.cachedKB;
+            break;
+        case 'S':
+            if (startsWith(p, "SwapTotal:")) field = &info.swapTotalKB;
+            else if (startsWith(p, "SwapFree:")) field = &info.swapFreeKB;
+            break;
+        default:
+            break;
+        }
+        if (!field) continue;
+
+        const char* value = p;
+        while (*value && *value != ':') ++value;
+        if (*value == ':') ++value;
+        *field = scanU64(value);
+
+        // All wanted keys sit in the first ~16 lines; skip the remaining ~40
+        if (++found == 7) break;
+    }
+    return haveTotal;
+}
+
+int parseNetDev(const char* text, NetDevCounters* interfaces, int maxInterfaces) {
+    if (!text) return 0;
+    int count = 0;
+
+    // Two header lines, then
+    //   eth0: rxBytes rxPackets errs drop fifo frame compressed multicast txBytes txPackets ...
+    const char* p = nextLine(nextLine(text));
+    for (; *p; p = nextLine(p)) {
+        const char* name = skipSpaces(p);
+        const char* colon = name;
+        while (*colon && *colon != ':' && *colon != '\n') ++colon;
+        if (*colon != ':') continue;
+
+        if (count < maxInterfaces) {
+            NetDevCounters& dev = interfaces[count];
+            size_t length = size_t(colon - name);
+            if (length >= sizeof(dev.name)) length = sizeof(dev.name) - 1;
+            std::memcpy(dev.name, name, length);
+            dev.name[length] = '\0';
+
+            const char* q = colon + 1;
+            dev.rxBytes = scanU64(q);
+            dev.rxPackets = scanU64(q);
+            for (int skip = 0; skip < 6; ++skip) scanU64(q);   // errs drop fifo frame compressed multicast
+            dev.txBytes = scanU64(q);
+            dev.txPackets = scanU64(q);
+        }
+        ++count;
+    }
+    return count;
+}
+
+bool parseCpuInfo(const char* text, CpuInfoSummary& summary) {
+    summary = CpuInfoSummary();
+    if (!text) return false;
+
+    // "processor\t: 0" ... "cpu MHz\t\t: 3400.000" per logical CPU
+    double sum = 0.0;
+    int mhzCount = 0;
+    for (const char* p = text; *p; p = nextLine(p)) {
+        if (p[0] == 'p' && startsWith(p, "processor")) {
+            ++summary.processors;
+        } else if (p[0] == 'c' && startsWith(p, "cpu MHz")) {
+            const char* value = p + 7;
+            while (*value && *value != ':' && *value != '\n') ++value;
+            if (*value != ':') continue;
+            ++value;
+            double mhz = scanDecimal(value);
+            sum += mhz;
+            ++mhzCount;
+            if (mhz > summary.maxMHz) summary.maxMHz = mhz;
+        }
+    }
+    if (mhzCount > 0) summary.avgMHz = sum / mhzCount;
+    return mhzCount > 0;
+}
@@ -0,0 +1,142 @@
+/*---------------------------------------------------------*\
+||| procfs.h                                                |
+|||                                                         |
+|||   Allocation-free /proc readers                        |
+|||   ProcFile keeps a /proc or /sys file open and re-reads |
+|||   it with pread from offset 0 into a buffer that only  |
+|||   grows; the parse* functions scan that text with      |
+|||   hand-written integer scanners into POD structs.      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class ProcFile {
+public:
+    explicit ProcFile(const std::string& path, size_t initialSize = 4096);
+    ~ProcFile();
+
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+
+    bool isOpen() const { return m_fd >= 0; }
+
+    // Whole file, NUL-terminated, or nullptr on failure. Valid until the next read().
+    // The buffer doubles when the file outgrows it, then stays that size.
+    const char* read(size_t* length = nullptr);
+
+private:
+    int m_fd;
+    std::vector<char> m_buffer;
+};
+
+namespace procfs {
+
+inline const char* skipSpaces(const char* p) {
+    while (*p == ' ' || *p == '\t') ++p;
+    return p;
+}
+
+// Unsigned decimal after optional blanks; p is left on the first non-digit
+inline uint64_t scanU64(const char*& p) {
+    p = skipSpaces(p);
+    uint64_t value = 0;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + uint64_t(*p - '0');
+        ++p;
+    }
+    return value;
+}
+
+// Plain "1234.567" (no sign or exponent, as /proc prints it)
+inline double scanDecimal(const char*& p) {
+    double value = double(scanU64(p));
+    if (*p == '.') {
+        double scale = 0.1;
+        for (++p; *p >= '0' && *p <= '9'; ++p, scale *= 0.1) {
+            value += (*p - '0') * scale;
+        }
+    }
+    return value;
+}
+
+// Start of the next line, or the terminating NUL
+inline const char* nextLine(const char* p) {
+    const char* end = std::strchr(p, '\n');
+    return end ? end + 1 : p + std::strlen(p);
+}
+
+template <size_t N>
+inline bool startsWith(const char* p, const char (&prefix)[N]) {
+    for (size_t i = 0; i + 1 < N; ++i) {
+        if (p[i] != prefix[i]) return false;
+    }
+    return true;
+}
+
+} // namespace procfs
+
+// One "cpu" line of /proc/stat, in USER_HZ ticks
+struct CpuTimes {
+    uint64_t user = 0;
+    uint64_t nice = 0;
+    uint64_t system = 0;
+    uint64_t idle = 0;
+    uint64_t iowait = 0;
+    uint64_t irq = 0;
+    uint64_t softirq = 0;
+    uint64_t steal = 0;
+
+    uint64_t idleTotal() const { return idle + iowait; }
+    uint64_t busy() const { return user + nice + system + irq + softirq + steal; }
+    uint64_t total() const { return busy() + idleTotal(); }
+};
+
+// /proc/meminfo, kB
+struct MemInfo {
+    uint64_t totalKB = 0;
+    uint64_t freeKB = 0;
+    uint64_t availableKB = 0;
+    uint64_t buffersKB = 0;
+    uint64_t cachedKB = 0;
+    uint64_t swapTotalKB = 0;
+    uint64_t swapFreeKB = 0;
+};
+
+// One interface of /proc/net/dev
+struct NetDevCounters {
+    char name[16] = {};     // IFNAMSIZ
+    uint64_t rxBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t txPackets = 0;
+};
+
+// What the pages need out of /proc/cpuinfo
+struct CpuInfoSummary {
+    int processors = 0;
+    double maxMHz = 0.0;    // Highest "cpu MHz"
+    double avgMHz = 0.0;
+};
+
+// Aggregate "cpu" line into total; "cpuN" lines into cores[N] for N < maxCores.
+// Returns the highest N + 1 (may exceed maxCores; offline CPUs leave gaps below it),
+// -1 if there is no "cpu" line.
+int parseStat(const char* text, CpuTimes& total, CpuTimes* cores = nullptr, int maxCores = 0);
+
+// False when MemTotal is missing
+bool parseMeminfo(const char* text, MemInfo& info);
+
+// Fills up to maxInterfaces entries; returns how many interfaces the file lists
+int parseNetDev(const char* text, NetDevCounters* interfaces, int maxInterfaces);
+
+// False when no "cpu MHz" line exists (e.g. some ARM kernels)
+bool parseCpuInfo(const char* text, CpuInfoSummary& summary);
@@ -0,0 +1,304 @@
+/*---------------------------------------------------------*\
+||| sensorhub.cpp                                           |
+|||                                                         |
+|||   Shared sensor hub                                    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "sensorhub.h"
+#include "utils/trace.h"
+#include <algorithm>
+
+namespace {
+
+const char* const GPU_DRIVERS[] = { "amdgpu", "i915", "xe", "nouveau" };
+
+// History columns: name, stored resolution, snapshot field
+struct HistoryField {
+    const char* name;
+    float quantum;
+    double SensorSnapshot::*value;
+};
+
+const HistoryField HISTORY_FIELDS[] = {
+    { "cpu.temperature",    0.1f,   &SensorSnapshot::cpuTemperature },
+    { "cpu.utilization",    0.001f, &SensorSnapshot::cpuUtilization },
+    { "cpu.package_watts",  0.1f,   &SensorSnapshot::packageWatts },
+    { "cpu.core_watts",     0.1f,   &SensorSnapshot::coreWatts },
+    { "cpu.uncore_watts",   0.1f,   &SensorSnapshot::uncoreWatts },
+    { "cpu.dram_watts",     0.1f,   &SensorSnapshot::dramWatts },
+    { "cpu.platform_watts", 0.1f,   &SensorSnapshot::platformWatts },
+    { "cpu.voltage",        0.001f, &SensorSnapshot::cpuVoltage },
+    { "gpu.load",           1.0f,   &SensorSnapshot::gpuLoad },
+    { "gpu.temperature",    0.1f,   &SensorSnapshot::gpuTemperature },
+    { "gpu.clock_mhz",      1.0f,   &SensorSnapshot::gpuClockMHz },
+    { "gpu.power_watts",    0.1f,   &SensorSnapshot::gpuPowerWatts },
+    { "gpu.memory_used_mb", 1.0f,   &SensorSnapshot::gpuMemoryUsedMB },
+};
+const size_t HISTORY_COUNT = sizeof(HISTORY_FIELDS) / sizeof(HISTORY_FIELDS[0]);
+
+const std::chrono::milliseconds HISTORY_PERIOD(1000);
+
+// Trace span per collector, indexed by SensorSnapshot::Sensor
+const char* const SAMPLE_SPANS[SensorSnapshot::SENSOR_COUNT] = {
+    "SensorHub::sample cpu.temperature",
+    "SensorHub::sample cpu.load",
+    "SensorHub::sample cpu.power",
+    "SensorHub::sample cpu.voltage",
+    "SensorHub::sample gpu",
+    "SensorHub::sample cpu.cores",
+};
+
+} // namespace
+
+SensorHub::SensorHub()
+    : m_running(false)
+    , m_started(Clock::now())
+    , m_nextSubscriber(1)
+{
+    m_periods[SensorSnapshot::CPU_TEMPERATURE] = std::chrono::milliseconds(250);
+    m_periods[SensorSnapshot::CPU_LOAD] = std::chrono::milliseconds(250);
+    m_periods[SensorSnapshot::CPU_POWER] = std::chrono::milliseconds(250);
+    m_periods[SensorSnapshot::CPU_VOLTAGE] = std::chrono::milliseconds(1000);
+    m_periods[SensorSnapshot::GPU] = std::chrono::milliseconds(1000);
+    m_periods[SensorSnapshot::CPU_CORES] = std::chrono::milliseconds(1000);
+
+    // The hub owns the schedule, the sampler must not second-guess it
+    m_load.setMinInterval(std::chrono::milliseconds(0));
+
+    for (const HistoryField& field : HISTORY_FIELDS) {
+        m_historyNames.push_back(field.name);
+        m_history.addSeries(field.name, field.quantum);
+    }
+    for (int port = 1; port <= FAN_PORTS; ++port) {
+        for (const char* field : { ".duty", ".rpm" }) {
+            m_historyNames.push_back("fan" + std::to_string(port) + field);
+            m_history.addSeries(m_historyNames.back(), 1.0f);
+        }
+        m_fanDuty[port - 1] = NAN;
+        m_fanRPM[port - 1] = NAN;
+    }
+}
+
+SensorHub::~SensorHub() {
+    stop();
+    m_log.close();
+}
+
+SensorHub& SensorHub::instance() {
+    static SensorHub hub;
+    hub.start();
+    return hub;
+}
+
+void SensorHub::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) return;
+    m_running = true;
+    m_thread = std::thread(&SensorHub::run, this);
+}
+
+void SensorHub::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) return;
+        m_running = false;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    m_log.flush();
+}
+
+bool SensorHub::running() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+void SensorHub::setPeriod(SensorSnapshot::Sensor sensor, std::chrono::milliseconds period) {
+    if (sensor < 0 || sensor >= SensorSnapshot::SENSOR_COUNT) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_periods[sensor] = std::max(period, std::chrono::milliseconds(10));
+    }
+    m_wake.notify_all();
+}
+
+std::chrono::milliseconds SensorHub::period(SensorSnapshot::Sensor sensor) const {
+    if (sensor < 0 || sensor >= SensorSnapshot::SENSOR_COUNT) return std::chrono::milliseconds(0);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_periods[sensor];
+}
+
+int SensorHub::subscribe(Callback callback) {
+    std::lock_guard<std::mutex> lock(m_subscriberMutex);
+    int id = m_nextSubscriber++;
+    m_subscribers[id] = std::move(callback);
+    return id;
+}
+
+void SensorHub::unsubscribe(int id) {
+    std::lock_guard<std::mutex> lock(m_subscriberMutex);
+    m_subscribers.erase(id);
+}
+
+SensorSnapshotPtr SensorHub::latest() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_latest;
+}
+
+void SensorHub::sample(SensorSnapshot::Sensor sensor, SensorSnapshot& next) {
+    if (sensor < 0 || sensor >= SensorSnapshot::SENSOR_COUNT) return;
+    TRACE_SCOPE(SAMPLE_SPANS[sensor]);
+
+    switch (sensor) {
+    case SensorSnapshot::CPU_TEMPERATURE:
+        next.cpuTemperature = m_hwmon.cpuTemperature();
+        break;
+    case SensorSnapshot::CPU_LOAD:
+        next.cpuUtilization = m_load.sample().utilization;
+        break;
+    case SensorSnapshot::CPU_POWER:
+        if (m_power.empty()) {
+            // No readable energy counter: instantaneous hwmon power (zenpower, fam15h_power)
+            next.packageWatts = m_hwmon.cpuPower();
+            break;
+        }
+        m_power.sample();
+        next.packageWatts = m_power.packageWatts();
+        next.coreWatts = m_power.watts(PowerDomain::CORE);
+        next.uncoreWatts = m_power.watts(PowerDomain::UNCORE);
+        next.dramWatts = m_power.watts(PowerDomain::DRAM);
+        next.platformWatts = m_power.watts(PowerDomain::PSYS);
+        break;
+    case SensorSnapshot::CPU_VOLTAGE:
+        next.cpuVoltage = m_hwmon.cpuVoltage();
+        break;
+    case SensorSnapshot::GPU: {
+        const GpuSample& gpu = m_gpu.sample();
+        next.gpuLoad = gpu.load;
+        next.gpuTemperature = gpu.temperature;
+        next.gpuClockMHz = gpu.clockMHz;
+        next.gpuPowerWatts = gpu.powerWatts;
+        next.gpuMemoryUsedMB = gpu.memoryUsedMB;
+        next.gpuMemoryTotalMB = gpu.memoryTotalMB;
+
+        // Cards whose hwmon isn't under the DRM device: any GPU driver's chip
+        for (const char* driver : GPU_DRIVERS) {
+            if (!std::isnan(next.gpuTemperature)) break;
+            next.gpuTemperature = m_hwmon.gpuTemperature(driver);
+        }
+        break;
+    }
+    case SensorSnapshot::CPU_CORES:
+        // The whole of /proc/stat (one line per CPU); the 250 ms load pass only
+        // reads the aggregate line at the top
+        m_cores.sample();
+        next.cores = std::make_shared<const CoreLoad>(m_cores.load());
+        break;
+    case SensorSnapshot::SENSOR_COUNT:
+        break;
+    }
+}
+
+void SensorHub::publish(const SensorSnapshotPtr& snapshot) {
+    std::lock_guard<std::mutex> lock(m_subscriberMutex);
+    for (const auto& subscriber : m_subscribers) {
+        subscriber.second(snapshot);
+    }
+}
+
+void SensorHub::reportFanDuty(int port, double dutyPercent) {
+    if (port < 1 || port > FAN_PORTS) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fanDuty[port - 1] = dutyPercent;
+}
+
+void SensorHub::reportFanRPM(int port, double rpm) {
+    if (port < 1 || port > FAN_PORTS) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fanRPM[port - 1] = rpm;
+}
+
+bool SensorHub::openLog(const std::string& directory, const TelemetryLog::Limits& limits) {
+    return m_log.open(directory, m_historyNames, limits);
+}
+
+void SensorHub::closeLog() {
+    m_log.close();
+}
+
+std::string SensorHub::logError() const {
+    return m_log.error();
+}
+
+// One history row per HISTORY_PERIOD, from whatever the latest values are
+void SensorHub::record(const SensorSnapshot& snapshot) {
+    Clock::time_point now = Clock::now();
+    if (now < m_nextRecord) return;
+    m_nextRecord = std::max(m_nextRecord + HISTORY_PERIOD, now);
+
+    float values[HISTORY_COUNT + 2 * FAN_PORTS];
+    for (size_t i = 0; i < HISTORY_COUNT; ++i) {
+        values[i] = float(snapshot.*(HISTORY_FIELDS[i].value));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int port = 0; port < FAN_PORTS; ++port) {
+            values[HISTORY_COUNT + 2 * port] = float(m_fanDuty[port]);
+            values[HISTORY_COUNT + 2 * port + 1] = float(m_fanRPM[port]);
+        }
+    }
+    const int64_t wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_history.append(wallMs, values);
+    m_log.append(wallMs, values);
+}
+
+void SensorHub::run() {
+    Trace::setThreadName("SensorHub");
+    Clock::time_point due[SensorSnapshot::SENSOR_COUNT];
+    std::fill(due, due + SensorSnapshot::SENSOR_COUNT, Clock::now());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point earliest = *std::min_element(due, due + SensorSnapshot::SENSOR_COUNT);
+        if (earliest > now) {
+            m_wake.wait_until(lock, earliest);
+            continue;
+        }
+
+        std::chrono::milliseconds periods[SensorSnapshot::SENSOR_COUNT];
+        std::copy(m_periods, m_periods + SensorSnapshot::SENSOR_COUNT, periods);
+        SensorSnapshot next = m_latest ? *m_latest : SensorSnapshot();
+        lock.unlock();
+
+        // Only the sensors that are due are read; the rest carry over unchanged
+        const double time = std::chrono::duration<double>(now - m_started).count();
+        next.changed = 0;
+        for (int i = 0; i < SensorSnapshot::SENSOR_COUNT; ++i) {
+            if (due[i] > now) continue;
+            SensorSnapshot::Sensor sensor = static_cast<SensorSnapshot::Sensor>(i);
+            sample(sensor, next);
+            next.sampledAt[i] = time;
+            next.changed |= 1u << i;
+
+            // Keep the cadence, but don't try to catch up after a stall (suspend)
+            due[i] += periods[i];
+            if (due[i] <= now) due[i] = now + periods[i];
+        }
+        next.sequence++;
+        next.time = time;
+
+        SensorSnapshotPtr snapshot = std::make_shared<const SensorSnapshot>(next);
+        lock.lock();
+        m_latest = snapshot;
+        lock.unlock();
+
+        record(next);
+        publish(snapshot);
+        lock.lock();
+    }
+}
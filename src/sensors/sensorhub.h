@@ -0,0 +1,166 @@
+/*---------------------------------------------------------*\
+||| sensorhub.h                                             |
+|||                                                         |
+|||   Shared sensor hub                                    |
+|||   One worker thread samples every sensor on its own    |
+|||   period and publishes immutable, timestamped          |
+|||   snapshots to all subscribers, so each sensor is read |
+|||   once per period no matter how many pages show it.    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include "sensors/coresampler.h"
+#include "sensors/gputelemetry.h"
+#include "sensors/hwmon.h"
+#include "sensors/loadsampler.h"
+#include "sensors/powercollector.h"
+#include "sensors/telemetrylog.h"
+#include "sensors/timeseries.h"
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct SensorSnapshot {
+    enum Sensor {
+        CPU_TEMPERATURE,    // cpuTemperature
+        CPU_LOAD,           // cpuUtilization
+        CPU_POWER,          // packageWatts, coreWatts, uncoreWatts, dramWatts, platformWatts
+        CPU_VOLTAGE,        // cpuVoltage
+        GPU,                // gpuLoad, gpuTemperature, gpuClockMHz, gpuPowerWatts, gpuMemory*
+        CPU_CORES,          // cores
+        SENSOR_COUNT
+    };
+
+    uint64_t sequence = 0;
+    double time = 0.0;                  // Seconds since the hub started (steady clock)
+    double sampledAt[SENSOR_COUNT];     // When each sensor was last read, NaN = never
+    uint32_t changed = 0;               // Bit per Sensor read for this snapshot
+
+    double cpuTemperature = NAN;        // °C
+    double cpuUtilization = NAN;        // 0-1, busy share of all CPUs
+    double packageWatts = NAN;          // RAPL/amd_energy packages summed, else the hwmon power meter
+    double coreWatts = NAN;             // Per RAPL domain, NaN where the CPU has none
+    double uncoreWatts = NAN;
+    double dramWatts = NAN;
+    double platformWatts = NAN;         // psys
+    double cpuVoltage = NAN;            // V
+    double gpuLoad = NAN;               // %
+    double gpuTemperature = NAN;        // °C
+    double gpuClockMHz = NAN;
+    double gpuPowerWatts = NAN;
+    double gpuMemoryUsedMB = NAN;
+    double gpuMemoryTotalMB = NAN;
+
+    // Per-CPU utilization and cpufreq; shared between snapshots until the next
+    // CPU_CORES sample, null before the first
+    std::shared_ptr<const CoreLoad> cores;
+
+    SensorSnapshot() {
+        for (double& t : sampledAt) t = NAN;
+    }
+
+    bool hasChanged(Sensor sensor) const { return (changed & (1u << sensor)) != 0; }
+};
+
+using SensorSnapshotPtr = std::shared_ptr<const SensorSnapshot>;
+
+class SensorHub {
+public:
+    using Callback = std::function<void(const SensorSnapshotPtr&)>;
+
+    SensorHub();
+    ~SensorHub();
+
+    SensorHub(const SensorHub&) = delete;
+    SensorHub& operator=(const SensorHub&) = delete;
+
+    // Process-wide hub; every call makes sure the worker is running (start() is a
+    // no-op once it is), so latest() works without subscribing
+    static SensorHub& instance();
+
+    void start();
+    void stop();
+    bool running() const;
+
+    // Sampling period per sensor (defaults: temperature, load and power 250 ms,
+    // voltage, GPU and per-core load 1 s). Takes effect from the next sample.
+    void setPeriod(SensorSnapshot::Sensor sensor, std::chrono::milliseconds period);
+    std::chrono::milliseconds period(SensorSnapshot::Sensor sensor) const;
+
+    // Callbacks run on the worker thread after every snapshot; hop to your own thread
+    // (e.g. QMetaObject::invokeMethod with Qt::QueuedConnection) before touching
+    // widgets. unsubscribe() waits for a delivery in progress, so no callback runs
+    // after it returns; do not call it from inside a callback.
+    int subscribe(Callback callback);
+    void unsubscribe(int id);
+
+    // Most recent snapshot, nullptr before the first one
+    SensorSnapshotPtr latest() const;
+
+    // Once-a-second history of every snapshot value, wall-clock milliseconds. Series:
+    // cpu.temperature, cpu.utilization, cpu.package_watts, cpu.core_watts,
+    // cpu.uncore_watts, cpu.dram_watts, cpu.platform_watts, cpu.voltage, gpu.load,
+    // gpu.temperature, gpu.clock_mhz, gpu.power_watts, gpu.memory_used_mb, then
+    // fan1.duty, fan1.rpm .. fan4.duty, fan4.rpm
+    const TimeSeriesStore& history() const { return m_history; }
+
+    // Fan state isn't sampled by the hub; the fan controller reports it (port 1-4,
+    // duty in percent) and it is recorded with the next history row
+    static const int FAN_PORTS = 4;
+    void reportFanDuty(int port, double dutyPercent);
+    void reportFanRPM(int port, double rpm);
+
+    // Also write the history rows to a persistent log with minute and hour rollups
+    // (see TelemetryLog); false with the reason in logError() if it can't be opened
+    bool openLog(const std::string& directory, const TelemetryLog::Limits& limits = TelemetryLog::Limits());
+    void closeLog();
+    std::string logError() const;
+
+    // The GPU being sampled; fixed once the hub is constructed
+    const std::string& gpuVendor() const { return m_gpu.vendor(); }
+    const std::string& gpuModel() const { return m_gpu.model(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    void sample(SensorSnapshot::Sensor sensor, SensorSnapshot& next);
+    void publish(const SensorSnapshotPtr& snapshot);
+    void record(const SensorSnapshot& snapshot);
+
+    // Sensor state, touched only by the worker thread
+    HwmonReader m_hwmon;
+    LoadSampler m_load;
+    CoreSampler m_cores;
+    PowerCollector m_power;
+    GpuTelemetry m_gpu;
+    Clock::time_point m_nextRecord;
+
+    TimeSeriesStore m_history;          // Locks internally
+    TelemetryLog m_log;                 // Locks internally
+    std::vector<std::string> m_historyNames;
+
+    mutable std::mutex m_mutex;         // Periods, run flag, latest snapshot
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    bool m_running;
+    Clock::time_point m_started;
+    std::chrono::milliseconds m_periods[SensorSnapshot::SENSOR_COUNT];
+    SensorSnapshotPtr m_latest;
+    double m_fanDuty[FAN_PORTS];
+    double m_fanRPM[FAN_PORTS];
+
+    std::mutex m_subscriberMutex;       // Held while delivering
+    std::map<int, Callback> m_subscribers;
+    int m_nextSubscriber;
+};
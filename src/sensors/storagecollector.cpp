@@ -0,0 +1,277 @@
+/*---------------------------------------------------------*\
+||| storagecollector.cpp                                    |
+|||                                                         |
+|||   Filesystem usage and disk throughput                 |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "storagecollector.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace {
+
+// diskstats counts 512-byte sectors regardless of the device's block size
+const double SECTOR_BYTES = 512.0;
+
+// mountinfo escapes space, tab, newline and backslash as \ooo
+std::string unescape(const char* begin, const char* end) {
+    std::string out;
+    out.reserve(size_t(end - begin));
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == '\\' && end - p >= 4
+            && p[1] >= '0' && p[1] <= '7' && p[2] >= '0' && p[2] <= '7' && p[3] >= '0' && p[3] <= '7') {
+            out += char((p[1] - '0') * 64 + (p[2] - '0') * 8 + (p[3] - '0'));
+            p += 3;
+        } else {
+            out += *p;
+        }
+    }
+    return out;
+}
+
+// Next space-separated field of [p, end); p is left after it
+bool nextField(const char*& p, const char* end, const char*& begin, const char*& fieldEnd) {
+    while (p < end && *p == ' ') ++p;
+    if (p >= end) return false;
+    begin = p;
+    while (p < end && *p != ' ') ++p;
+    fieldEnd = p;
+    return true;
+}
+
+bool startsWith(const std::string& text, const char* prefix) {
+    return text.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+// Whole file from offset 0 into buffer, NUL-terminated; returns its length
+ssize_t readWhole(int fd, std::vector<char>& buffer) {
+    if (fd < 0) return -1;
+    size_t length = 0;
+    for (;;) {
+        if (buffer.size() - length < 4096) buffer.resize(buffer.size() * 2);
+        ssize_t n = pread(fd, buffer.data() + length, buffer.size() - length - 1, off_t(length));
+        if (n < 0) return -1;
+        if (n == 0) break;
+        length += size_t(n);
+    }
+    buffer[length] = '\0';
+    return ssize_t(length);
+}
+
+} // namespace
+
+StorageCollector::StorageCollector(const std::string& procRoot)
+    : m_mountFd(open((procRoot + "/self/mountinfo").c_str(), O_RDONLY | O_CLOEXEC))
+    , m_diskstatsFd(open((procRoot + "/diskstats").c_str(), O_RDONLY | O_CLOEXEC))
+    , m_parsed(false)
+    , m_mountParses(0)
+    , m_buffer(16384)
+    , m_havePrevious(false)
+    , m_totalRead(NAN)
+    , m_totalWrite(NAN)
+{
+    m_filter = [](const std::string& mountPoint, const std::string& source) {
+        return startsWith(source, "/dev/") && (mountPoint == "/" || startsWith(mountPoint, "/home"));
+    };
+}
+
+StorageCollector::~StorageCollector() {
+    if (m_mountFd >= 0) close(m_mountFd);
+    if (m_diskstatsFd >= 0) close(m_diskstatsFd);
+}
+
+void StorageCollector::setFilter(MountFilter filter) {
+    m_filter = std::move(filter);
+    m_parsed = false;
+}
+
+// The kernel flags the mountinfo fd with POLLPRI|POLLERR once per change of the mount
+// table (and clears it in the same poll), so an unchanged table costs one syscall
+bool StorageCollector::mountsChanged() {
+    if (m_mountFd < 0) return false;
+    pollfd fd = { m_mountFd, POLLPRI, 0 };
+    return poll(&fd, 1, 0) > 0 && (fd.revents & (POLLPRI | POLLERR));
+}
+
+void StorageCollector::parseMounts() {
+    m_parsed = true;
+    ++m_mountParses;
+
+    std::vector<FilesystemUsage> selected;
+    ssize_t length = readWhole(m_mountFd, m_buffer);
+    const char* p = m_buffer.data();
+    const char* end = p + std::max<ssize_t>(length, 0);
+
+    // 36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+        if (!lineEnd) lineEnd = end;
+
+        const char* fields[5][2];
+        const char* q = p;
+        bool ok = true;
+        for (int i = 0; i < 5 && ok; ++i) {
+            ok = nextField(q, lineEnd, fields[i][0], fields[i][1]);
+        }
+
+        // Optional fields run up to the lone "-"
+        const char* type[2] = { nullptr, nullptr };
+        const char* source[2] = { nullptr, nullptr };
+        const char* b = nullptr;
+        const char* e = nullptr;
+        while (ok && nextField(q, lineEnd, b, e)) {
+            if (e - b == 1 && *b == '-') {
+                ok = nextField(q, lineEnd, type[0], type[1]) && nextField(q, lineEnd, source[0], source[1]);
+                break;
+            }
+        }
+
+        if (ok && source[0]) {
+            FilesystemUsage fs;
+            fs.mountPoint = unescape(fields[4][0], fields[4][1]);
+            fs.source = unescape(source[0], source[1]);
+            fs.type.assign(type[0], type[1]);
+
+            if (m_filter && m_filter(fs.mountPoint, fs.source)) {
+                char* colon = nullptr;
+                fs.major = unsigned(std::strtoul(fields[2][0], &colon, 10));
+                fs.minor = colon && *colon == ':' ? unsigned(std::strtoul(colon + 1, nullptr, 10)) : 0;
+
+                // btrfs and friends report an anonymous 0:N device; the counters
+                // live under the block device named as the source
+                struct stat st;
+                if (fs.major == 0 && stat(fs.source.c_str(), &st) == 0 && S_ISBLK(st.st_mode)) {
+                    fs.major = major(st.st_rdev);
+                    fs.minor = minor(st.st_rdev);
+                }
+
+                // A later mount over the same path hides the earlier one
+                auto same = std::find_if(selected.begin(), selected.end(), [&](const FilesystemUsage& other) {
+                    return other.mountPoint == fs.mountPoint;
+                });
+                if (same != selected.end()) {
+                    *same = fs;
+                } else {
+                    selected.push_back(fs);
+                }
+            }
+        }
+        p = lineEnd + 1;
+    }
+
+    m_filesystems.swap(selected);
+}
+
+bool StorageCollector::readDiskstats(std::vector<DeviceCounters>& counters) {
+    counters.clear();
+    ssize_t length = readWhole(m_diskstatsFd, m_buffer);
+    if (length <= 0) return false;
+
+    //  259       2 nvme0n1p2 reads merged sectors ms writes merged sectors ...
+    const char* p = m_buffer.data();
+    const char* end = p + length;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+        if (!lineEnd) lineEnd = end;
+
+        char* q = nullptr;
+        DeviceCounters device;
+        device.major = unsigned(std::strtoul(p, &q, 10));
+        device.minor = unsigned(std::strtoul(q, &q, 10));
+        while (q < lineEnd && *q == ' ') ++q;
+        while (q < lineEnd && *q != ' ') ++q;       // Name
+
+        uint64_t values[7];
+        int count = 0;
+        for (; count < 7 && q < lineEnd; ++count) {
+            char* next = nullptr;
+            values[count] = std::strtoull(q, &next, 10);
+            if (next == q) break;
+            q = next;
+        }
+        if (count == 7) {
+            device.sectorsRead = values[2];
+            device.sectorsWritten = values[6];
+            counters.push_back(device);
+        }
+        p = lineEnd + 1;
+    }
+    return true;
+}
+
+const std::vector<FilesystemUsage>& StorageCollector::sample() {
+    if (!m_parsed || mountsChanged()) {
+        parseMounts();
+    }
+
+    for (FilesystemUsage& fs : m_filesystems) {
+        struct statvfs st;
+        if (statvfs(fs.mountPoint.c_str(), &st) != 0) {
+            fs.totalBytes = fs.usedBytes = fs.availableBytes = 0;
+            fs.usedPercent = NAN;
+            continue;
+        }
+        const uint64_t unit = st.f_frsize ? st.f_frsize : st.f_bsize;
+        fs.totalBytes = uint64_t(st.f_blocks) * unit;
+        fs.usedBytes = uint64_t(st.f_blocks - st.f_bfree) * unit;
+        fs.availableBytes = uint64_t(st.f_bavail) * unit;
+
+        // Blocks reserved for root count as neither used nor available, like df
+        const uint64_t usable = fs.usedBytes + fs.availableBytes;
+        fs.usedPercent = usable > 0 ? 100.0 * double(fs.usedBytes) / double(usable) : NAN;
+    }
+
+    std::vector<DeviceCounters> current;
+    Clock::time_point now = Clock::now();
+    const double seconds = m_havePrevious ? std::chrono::duration<double>(now - m_previousTime).count() : 0.0;
+    const bool haveCounters = readDiskstats(current);
+
+    auto find = [](const std::vector<DeviceCounters>& list, unsigned int major, unsigned int minor) {
+        return std::find_if(list.begin(), list.end(), [&](const DeviceCounters& d) {
+            return d.major == major && d.minor == minor;
+        });
+    };
+
+    m_totalRead = NAN;
+    m_totalWrite = NAN;
+    std::vector<std::pair<unsigned int, unsigned int>> counted;
+    for (FilesystemUsage& fs : m_filesystems) {
+        fs.readBytesPerSecond = NAN;
+        fs.writeBytesPerSecond = NAN;
+        if (!haveCounters || seconds <= 0.0) continue;
+
+        auto after = find(current, fs.major, fs.minor);
+        auto before = find(m_previous, fs.major, fs.minor);
+        if (after == current.end() || before == m_previous.end()) continue;
+
+        // Counters reset when a device is re-added; report 0 rather than a huge jump
+        fs.readBytesPerSecond = after->sectorsRead >= before->sectorsRead
+            ? (after->sectorsRead - before->sectorsRead) * SECTOR_BYTES / seconds : 0.0;
+        fs.writeBytesPerSecond = after->sectorsWritten >= before->sectorsWritten
+            ? (after->sectorsWritten - before->sectorsWritten) * SECTOR_BYTES / seconds : 0.0;
+
+        // Several mounts (btrfs subvolumes, bind mounts) can share one device
+        std::pair<unsigned int, unsigned int> key(fs.major, fs.minor);
+        if (std::find(counted.begin(), counted.end(), key) != counted.end()) continue;
+        counted.push_back(key);
+        m_totalRead = (std::isnan(m_totalRead) ? 0.0 : m_totalRead) + fs.readBytesPerSecond;
+        m_totalWrite = (std::isnan(m_totalWrite) ? 0.0 : m_totalWrite) + fs.writeBytesPerSecond;
+    }
+
+    if (haveCounters) {
+        m_previous.swap(current);
+        m_previousTime = now;
+        m_havePrevious = true;
+    }
+    return m_filesystems;
+}
@@ -0,0 +1,90 @@
+/*---------------------------------------------------------*\
+||| storagecollector.h                                      |
+|||                                                         |
+|||   Filesystem usage and disk throughput                 |
+|||   Parses /proc/self/mountinfo once (again only when    |
+|||   poll() reports a mount change), statvfs()es the     |
+|||   selected filesystems and turns /proc/diskstats      |
+|||   sector counters into per-device read/write rates.   |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct FilesystemUsage {
+    std::string mountPoint;     // Unescaped ("/mnt/My Disk")
+    std::string source;         // /dev/nvme0n1p2
+    std::string type;           // ext4, btrfs ...
+    unsigned int major = 0;     // Block device backing the mount (diskstats key)
+    unsigned int minor = 0;
+
+    uint64_t totalBytes = 0;
+    uint64_t usedBytes = 0;
+    uint64_t availableBytes = 0;    // Free to unprivileged users (df "Avail")
+    double usedPercent = NAN;       // used / (used + available), as df rounds it
+
+    double readBytesPerSecond = NAN;    // Since the previous sample, NaN on the first
+    double writeBytesPerSecond = NAN;
+};
+
+class StorageCollector {
+public:
+    using MountFilter = std::function<bool(const std::string& mountPoint, const std::string& source)>;
+
+    explicit StorageCollector(const std::string& procRoot = "/proc");
+    ~StorageCollector();
+
+    StorageCollector(const StorageCollector&) = delete;
+    StorageCollector& operator=(const StorageCollector&) = delete;
+
+    // Which mounts to report; default: block devices mounted at / or under /home
+    void setFilter(MountFilter filter);
+
+    // Refresh usage and rates of the selected filesystems
+    const std::vector<FilesystemUsage>& sample();
+    const std::vector<FilesystemUsage>& filesystems() const { return m_filesystems; }
+
+    // Combined rates over the distinct devices behind the selection
+    double totalReadBytesPerSecond() const { return m_totalRead; }
+    double totalWriteBytesPerSecond() const { return m_totalWrite; }
+
+    // Number of times mountinfo was (re)parsed, for diagnostics
+    int mountParses() const { return m_mountParses; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct DeviceCounters {
+        unsigned int major;
+        unsigned int minor;
+        uint64_t sectorsRead;
+        uint64_t sectorsWritten;
+    };
+
+    bool mountsChanged();
+    void parseMounts();
+    bool readDiskstats(std::vector<DeviceCounters>& counters);
+
+    int m_mountFd;
+    int m_diskstatsFd;
+    MountFilter m_filter;
+    bool m_parsed;
+    int m_mountParses;
+    std::vector<char> m_buffer;
+
+    std::vector<FilesystemUsage> m_filesystems;
+    std::vector<DeviceCounters> m_previous;
+    Clock::time_point m_previousTime;
+    bool m_havePrevious;
+    double m_totalRead;
+    double m_totalWrite;
+};
@@ -0,0 +1,692 @@
+/*---------------------------------------------------------*\
+||| telemetrylog.cpp                                        |
+|||                                                         |
+|||   Persistent telemetry log                             |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "telemetrylog.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/*---------------------------------------------------------*\
+| Segment file: a 4 KiB header page, then fixed-size       |
+| records. Native byte order; the log never leaves the     |
+| machine that wrote it.                                   |
+|                                                           |
+|   header:  magic, version, tier, series count, record    |
+|            size, creation time, names (NUL separated),   |
+|            CRC of all of it                              |
+|   record:  CRC, rows, time (ms since the epoch), values  |
+|                                                           |
+| A record counts only if rows != 0 and the CRC matches;   |
+| the preallocated tail reads as zeros and stops the scan. |
+\*---------------------------------------------------------*/
+
+const char MAGIC[8] = { 'L', 'L', 'T', 'L', 'O', 'G', '\0', '\0' };
+const uint32_t VERSION = 1;
+const size_t HEADER_BYTES = 4096;
+const size_t RECORD_HEADER_BYTES = 16;
+const char* const SUFFIX = ".tlog";
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t tier;
+    uint32_t seriesCount;
+    uint32_t recordBytes;
+    int64_t createdMs;
+    uint32_t namesBytes;
+    uint32_t crc;               // Over this header (crc = 0) and the names
+};
+
+const int64_t BUCKET_MS[TelemetryLog::TIER_COUNT] = { 0, 60 * 1000, 60 * 60 * 1000 };
+
+struct CrcTable {
+    uint32_t entries[256];
+
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            entries[i] = c;
+        }
+    }
+};
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const CrcTable table;
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t headerCrc(const SegmentHeader& header, const uint8_t* names) {
+    SegmentHeader copy = header;
+    copy.crc = 0;
+    uint32_t crc = crc32(reinterpret_cast<const uint8_t*>(&copy), sizeof(copy));
+    return crc32(names, header.namesBytes, crc);
+}
+
+size_t valueCount(TelemetryLog::Tier tier, size_t series) {
+    return tier == TelemetryLog::RAW ? series : 3 * series;
+}
+
+bool recordValid(const uint8_t* record, size_t recordBytes) {
+    uint32_t crc, rows;
+    std::memcpy(&crc, record, 4);
+    std::memcpy(&rows, record + 4, 4);
+    return rows != 0 && crc == crc32(record + 4, recordBytes - 4);
+}
+
+// Header of a mapped segment, or false if it isn't one of ours for this tier
+bool parseHeader(const uint8_t* map, size_t size, TelemetryLog::Tier tier,
+                 SegmentHeader& header, std::vector<std::string>& names) {
+    if (size < HEADER_BYTES) return false;
+    std::memcpy(&header, map, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.tier != uint32_t(tier) || header.namesBytes > HEADER_BYTES - sizeof(header)
+        || header.recordBytes != RECORD_HEADER_BYTES + 4 * valueCount(tier, header.seriesCount)) {
+        return false;
+    }
+    const uint8_t* p = map + sizeof(header);
+    if (header.crc != headerCrc(header, p)) return false;
+
+    names.clear();
+    const char* name = reinterpret_cast<const char*>(p);
+    const char* end = name + header.namesBytes;
+    while (name < end && names.size() < header.seriesCount) {
+        size_t length = strnlen(name, size_t(end - name));
+        names.emplace_back(name, length);
+        name += length + 1;
+    }
+    return names.size() == header.seriesCount;
+}
+
+bool makeDirectories(const std::string& path) {
+    for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1)) {
+        const std::string prefix = path.substr(0, slash);
+        if (mkdir(prefix.c_str(), 0700) != 0 && errno != EEXIST) return false;
+        if (slash == std::string::npos) return true;
+    }
+}
+
+std::string segmentName(TelemetryLog::Tier tier, int64_t createdMs) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s-%016lld%s", TelemetryLog::tierName(tier),
+                  static_cast<long long>(std::max<int64_t>(0, createdMs)), SUFFIX);
+    return name;
+}
+
+// "<tier>-<ms>.tlog", oldest first (the zero-padded time sorts as text)
+std::vector<std::string> listSegments(const std::string& directory, TelemetryLog::Tier tier) {
+    std::vector<std::string> files;
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return files;
+    const std::string prefix = std::string(TelemetryLog::tierName(tier)) + "-";
+    const size_t suffixLength = std::strlen(SUFFIX);
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.size() > prefix.size() + suffixLength && name.compare(0, prefix.size(), prefix) == 0
+            && name.compare(name.size() - suffixLength, suffixLength, SUFFIX) == 0) {
+            files.push_back(name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void unmap(uint8_t*& map, size_t size) {
+    if (map) munmap(map, size);
+    map = nullptr;
+}
+
+// Schedule write-back of [begin, end) without waiting for it
+void syncRange(uint8_t* map, size_t begin, size_t end, int flags) {
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    begin -= begin % page;
+    if (end > begin) msync(map + begin, end - begin, flags);
+}
+
+int64_t floorTo(int64_t value, int64_t step) {
+    int64_t q = value / step;
+    if (value % step < 0) --q;
+    return q * step;
+}
+
+void formatTime(int64_t timeMs, char* buf, size_t size) {
+    const int64_t seconds = floorTo(timeMs, 1000) / 1000;
+    const time_t t = time_t(seconds);
+    tm utc;
+    gmtime_r(&t, &utc);
+    const size_t length = std::strftime(buf, size, "%Y-%m-%dT%H:%M:%S", &utc);
+    std::snprintf(buf + length, size - length, ".%03dZ", int(timeMs - seconds * 1000));
+}
+
+void writeNumber(std::ostream& out, float value, const char* missing) {
+    if (std::isnan(value) || std::isinf(value)) {
+        out << missing;
+        return;
+    }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.7g", double(value));
+    out << buf;
+}
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out << '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+/*---------------------------------------------------------*\
+| TelemetryLog                                              |
+\*---------------------------------------------------------*/
+
+TelemetryLog::Limits::Limits()
+    : tierBytes{ 32u << 20, 16u << 20, 4u << 20 }
+    , segmentBytes{ 1u << 20, 256u << 10, 64u << 10 }
+    , flushSeconds(60)
+{
+}
+
+TelemetryLog::TelemetryLog()
+    : m_nextFlush(INT64_MIN)
+{
+}
+
+TelemetryLog::~TelemetryLog() {
+    close();
+}
+
+std::string TelemetryLog::defaultDirectory() {
+    const char* state = std::getenv("XDG_STATE_HOME");
+    if (state && state[0] == '/') return std::string(state) + "/ll-connect3/telemetry";
+    const char* home = std::getenv("HOME");
+    return std::string(home ? home : "") + "/.local/state/ll-connect3/telemetry";
+}
+
+const char* TelemetryLog::tierName(Tier tier) {
+    switch (tier) {
+    case RAW: return "raw";
+    case MINUTE: return "minute";
+    case HOUR: return "hour";
+    default: return "unknown";
+    }
+}
+
+size_t TelemetryLog::recordBytes(Tier tier) const {
+    return RECORD_HEADER_BYTES + 4 * valueCount(tier, m_series.size());
+}
+
+bool TelemetryLog::isOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_directory.empty();
+}
+
+std::string TelemetryLog::error() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+bool TelemetryLog::open(const std::string& directory, const std::vector<std::string>& series,
+                        const Limits& limits) {
+    close();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_error.clear();
+    size_t namesBytes = 0;
+    for (const std::string& name : series) namesBytes += name.size() + 1;
+    if (series.empty() || namesBytes > HEADER_BYTES - sizeof(SegmentHeader)) {
+        m_error = "series names do not fit a segment header";
+        return false;
+    }
+    if (directory.empty() || !makeDirectories(directory)) {
+        m_error = "cannot create " + directory + ": " + std::strerror(errno);
+        return false;
+    }
+
+    m_directory = directory;
+    m_series = series;
+    m_limits = limits;
+    m_scratch.assign(3 * series.size(), NAN);
+    m_nextFlush = INT64_MIN;
+
+    for (int t = 0; t < TIER_COUNT; ++t) {
+        Tier tier = Tier(t);
+        // Room for the header and at least a handful of records
+        m_limits.segmentBytes[t] = std::max(m_limits.segmentBytes[t], HEADER_BYTES + 16 * recordBytes(tier));
+        m_limits.tierBytes[t] = std::max(m_limits.tierBytes[t], m_limits.segmentBytes[t]);
+        m_pending[t].clear();
+        if (!openTier(tier)) {
+            for (int i = 0; i < t; ++i) sealSegment(Tier(i));
+            m_directory.clear();
+            return false;
+        }
+
+        Rollup& rollup = m_rollups[t];
+        rollup.bucket = -1;
+        rollup.rows = 0;
+        rollup.min.assign(series.size(), INFINITY);
+        rollup.max.assign(series.size(), -INFINITY);
+        rollup.sum.assign(series.size(), 0.0);
+        rollup.count.assign(series.size(), 0);
+    }
+    return true;
+}
+
+// Continue the newest segment if it is ours and has room; anything else (other series,
+// damaged header, full) is left alone and the first commit starts a fresh segment
+bool TelemetryLog::openTier(Tier tier) {
+    std::vector<std::string> files = listSegments(m_directory, tier);
+    if (files.empty()) return true;
+
+    const std::string path = m_directory + "/" + files.back();
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) return true;
+        m_error = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < off_t(HEADER_BYTES)) {
+        ::close(fd);
+        return true;
+    }
+    const size_t size = size_t(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        return true;
+    }
+
+    Segment& segment = m_segments[tier];
+    segment.fd = fd;
+    segment.map = static_cast<uint8_t*>(map);
+    segment.size = size;
+
+    SegmentHeader header;
+    std::vector<std::string> names;
+    if (!parseHeader(segment.map, size, tier, header, names) || names != m_series) {
+        segment.used = size;            // Never written to again
+        sealSegment(tier);
+        return true;
+    }
+
+    // Resume after the last intact record; a torn one at the end is overwritten
+    const size_t bytes = recordBytes(tier);
+    size_t used = HEADER_BYTES;
+    while (used + bytes <= size && recordValid(segment.map + used, bytes)) used += bytes;
+    segment.used = used;
+    if (used + bytes > size) sealSegment(tier);
+    return true;
+}
+
+bool TelemetryLog::startSegment(Tier tier, int64_t timeMs) {
+    const size_t size = m_limits.segmentBytes[tier];
+    int fd = -1;
+    std::string path;
+    // Two segments started in the same millisecond (series changed) get distinct names
+    for (int attempt = 0; attempt < 16 && fd < 0; ++attempt) {
+        path = m_directory + "/" + segmentName(tier, timeMs + attempt);
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0 && errno != EEXIST) break;
+    }
+    if (fd < 0) {
+        m_error = "cannot create " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    void* map = MAP_FAILED;
+    if (ftruncate(fd, off_t(size)) == 0) {
+        map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (map == MAP_FAILED) {
+        m_error = "cannot map " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+
+    Segment& segment = m_segments[tier];
+    segment.fd = fd;
+    segment.map = static_cast<uint8_t*>(map);
+    segment.size = size;
+    segment.used = HEADER_BYTES;
+
+    SegmentHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.tier = uint32_t(tier);
+    header.seriesCount = uint32_t(m_series.size());
+    header.recordBytes = uint32_t(recordBytes(tier));
+    header.createdMs = timeMs;
+
+    uint8_t* names = segment.map + sizeof(header);
+    for (const std::string& name : m_series) {
+        std::memcpy(names + header.namesBytes, name.c_str(), name.size() + 1);
+        header.namesBytes += uint32_t(name.size() + 1);
+    }
+    header.crc = headerCrc(header, names);
+    std::memcpy(segment.map, &header, sizeof(header));
+
+    enforceRetention(tier);
+    return true;
+}
+
+// The one place the log waits for the disk: a full segment is made durable before
+// it is let go, at most every few hours per tier
+void TelemetryLog::sealSegment(Tier tier) {
+    Segment& segment = m_segments[tier];
+    if (segment.map) msync(segment.map, std::min(segment.used, segment.size), MS_SYNC);
+    unmap(segment.map, segment.size);
+    if (segment.fd >= 0) ::close(segment.fd);
+    segment = Segment();
+}
+
+void TelemetryLog::enforceRetention(Tier tier) {
+    std::vector<std::string> files = listSegments(m_directory, tier);
+    std::vector<off_t> sizes(files.size(), 0);
+    size_t total = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        struct stat st;
+        if (stat((m_directory + "/" + files[i]).c_str(), &st) == 0) sizes[i] = st.st_size;
+        total += size_t(sizes[i]);
+    }
+    // The newest file is the segment being written
+    for (size_t i = 0; i + 1 < files.size() && total > m_limits.tierBytes[tier]; ++i) {
+        if (unlink((m_directory + "/" + files[i]).c_str()) == 0) total -= size_t(sizes[i]);
+    }
+}
+
+void TelemetryLog::queueRecord(Tier tier, int64_t timeMs, uint32_t rows, const float* values) {
+    const size_t bytes = recordBytes(tier);
+    std::vector<uint8_t>& pending = m_pending[tier];
+    const size_t at = pending.size();
+    pending.resize(at + bytes);
+    uint8_t* record = pending.data() + at;
+    std::memcpy(record + 4, &rows, 4);
+    std::memcpy(record + 8, &timeMs, 8);
+    std::memcpy(record + RECORD_HEADER_BYTES, values, bytes - RECORD_HEADER_BYTES);
+    const uint32_t crc = crc32(record + 4, bytes - 4);
+    std::memcpy(record, &crc, 4);
+}
+
+void TelemetryLog::emitRollup(Tier tier) {
+    Rollup& rollup = m_rollups[tier];
+    if (rollup.rows == 0) return;
+    for (size_t s = 0; s < m_series.size(); ++s) {
+        const bool any = rollup.count[s] != 0;
+        m_scratch[3 * s] = any ? rollup.min[s] : NAN;
+        m_scratch[3 * s + 1] = any ? float(rollup.sum[s] / rollup.count[s]) : NAN;
+        m_scratch[3 * s + 2] = any ? rollup.max[s] : NAN;
+    }
+    queueRecord(tier, rollup.bucket, rollup.rows, m_scratch.data());
+
+    rollup.rows = 0;
+    std::fill(rollup.min.begin(), rollup.min.end(), INFINITY);
+    std::fill(rollup.max.begin(), rollup.max.end(), -INFINITY);
+    std::fill(rollup.sum.begin(), rollup.sum.end(), 0.0);
+    std::fill(rollup.count.begin(), rollup.count.end(), 0);
+}
+
+// Move queued records into the mapping. The body goes in before the CRC, and the
+// kernel writes the dirty pages back on its own schedule; a record torn by a crash
+// fails its CRC and is overwritten on the next start.
+void TelemetryLog::commit(Tier tier) {
+    std::vector<uint8_t>& pending = m_pending[tier];
+    const size_t bytes = recordBytes(tier);
+    for (size_t at = 0; at + bytes <= pending.size(); at += bytes) {
+        Segment& segment = m_segments[tier];
+        if (segment.map && segment.used + bytes > segment.size) sealSegment(tier);
+        if (!segment.map) {
+            int64_t timeMs;
+            std::memcpy(&timeMs, pending.data() + at + 8, 8);
+            if (!startSegment(tier, timeMs)) break;     // Disk full or gone; drop the batch
+        }
+
+        const size_t begin = segment.used;
+        std::memcpy(segment.map + begin + 4, pending.data() + at + 4, bytes - 4);
+        std::memcpy(segment.map + begin, pending.data() + at, 4);
+        segment.used += bytes;
+
+        // Runs of records in the same segment share one write-back request
+        const bool last = at + 2 * bytes > pending.size() || segment.used + bytes > segment.size;
+        if (last) syncRange(segment.map, begin, segment.used, MS_ASYNC);
+    }
+    pending.clear();
+}
+
+void TelemetryLog::append(int64_t timeMs, const float* values) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) return;
+
+    queueRecord(RAW, timeMs, 1, values);
+
+    for (int t = MINUTE; t < TIER_COUNT; ++t) {
+        Rollup& rollup = m_rollups[t];
+        const int64_t bucket = floorTo(timeMs, BUCKET_MS[t]);
+        if (bucket != rollup.bucket) {
+            emitRollup(Tier(t));
+            rollup.bucket = bucket;
+        }
+        ++rollup.rows;
+        for (size_t s = 0; s < m_series.size(); ++s) {
+            const float value = values[s];
+            if (std::isnan(value)) continue;
+            rollup.min[s] = std::min(rollup.min[s], value);
+            rollup.max[s] = std::max(rollup.max[s], value);
+            rollup.sum[s] += value;
+            ++rollup.count[s];
+        }
+    }
+
+    const int64_t interval = int64_t(std::max(1, m_limits.flushSeconds)) * 1000;
+    if (m_nextFlush == INT64_MIN) {
+        m_nextFlush = timeMs + interval;
+    } else if (timeMs >= m_nextFlush || timeMs < m_nextFlush - 2 * interval) {
+        // Also flushes when the wall clock jumps back
+        for (int t = 0; t < TIER_COUNT; ++t) commit(Tier(t));
+        m_nextFlush = timeMs + interval;
+    }
+}
+
+void TelemetryLog::flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) return;
+    for (int t = 0; t < TIER_COUNT; ++t) commit(Tier(t));
+}
+
+void TelemetryLog::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty()) return;
+
+    // A partial minute or hour is still worth keeping; its rows count says how partial
+    for (int t = MINUTE; t < TIER_COUNT; ++t) emitRollup(Tier(t));
+    for (int t = 0; t < TIER_COUNT; ++t) {
+        commit(Tier(t));
+        sealSegment(Tier(t));
+    }
+    m_directory.clear();
+}
+
+/*---------------------------------------------------------*\
+| TelemetryReader                                           |
+\*---------------------------------------------------------*/
+
+TelemetryReader::TelemetryReader(const std::string& directory)
+    : m_directory(directory)
+{
+}
+
+std::vector<std::string> TelemetryReader::segmentFiles(TelemetryLog::Tier tier) const {
+    return listSegments(m_directory, tier);
+}
+
+bool TelemetryReader::forEach(TelemetryLog::Tier tier, int64_t fromMs, int64_t toMs,
+                              const std::function<void(const Row&)>& callback) const {
+    DIR* dir = opendir(m_directory.c_str());
+    if (!dir) return false;
+    closedir(dir);
+
+    std::vector<std::string> names;
+    std::vector<float> values;
+    size_t segment = 0;
+    for (const std::string& file : segmentFiles(tier)) {
+        const std::string path = m_directory + "/" + file;
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;               // Retention removed it meanwhile
+        struct stat st;
+        void* map = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size >= off_t(HEADER_BYTES)) {
+            map = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (map == MAP_FAILED) continue;
+
+        const uint8_t* data = static_cast<const uint8_t*>(map);
+        const size_t size = size_t(st.st_size);
+        SegmentHeader header;
+        if (parseHeader(data, size, tier, header, names) && header.createdMs <= toMs) {
+            const size_t bytes = header.recordBytes;
+            values.resize((bytes - RECORD_HEADER_BYTES) / 4);
+            for (size_t at = HEADER_BYTES; at + bytes <= size && recordValid(data + at, bytes); at += bytes) {
+                Row row;
+                std::memcpy(&row.rows, data + at + 4, 4);
+                std::memcpy(&row.timeMs, data + at + 8, 8);
+                if (row.timeMs < fromMs || row.timeMs > toMs) continue;
+                std::memcpy(values.data(), data + at + RECORD_HEADER_BYTES, bytes - RECORD_HEADER_BYTES);
+                row.segment = segment;
+                row.series = &names;
+                row.values = values.data();
+                callback(row);
+            }
+        }
+        munmap(map, size);
+        ++segment;
+    }
+    return true;
+}
+
+std::vector<std::string> TelemetryReader::series(TelemetryLog::Tier tier) const {
+    std::vector<std::string> all;
+    std::vector<std::string> names;
+    for (const std::string& file : segmentFiles(tier)) {
+        const std::string path = m_directory + "/" + file;
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+        uint8_t header[HEADER_BYTES];
+        const ssize_t n = pread(fd, header, sizeof(header), 0);
+        ::close(fd);
+
+        SegmentHeader parsed;
+        if (n != ssize_t(sizeof(header)) || !parseHeader(header, sizeof(header), tier, parsed, names)) continue;
+        for (const std::string& name : names) {
+            if (std::find(all.begin(), all.end(), name) == all.end()) all.push_back(name);
+        }
+    }
+    return all;
+}
+
+size_t TelemetryReader::exportTo(std::ostream& out, Format format, TelemetryLog::Tier tier,
+                                 int64_t fromMs, int64_t toMs,
+                                 const std::vector<std::string>& select) const {
+    const std::vector<std::string> columns = select.empty() ? series(tier) : select;
+    const bool rollup = tier != TelemetryLog::RAW;
+    const char* const STATS[] = { "min", "avg", "max" };
+
+    if (format == CSV) {
+        out << "time";
+        if (rollup) out << ",rows";
+        for (const std::string& name : columns) {
+            if (!rollup) {
+                out << ',' << name;
+                continue;
+            }
+            for (const char* stat : STATS) out << ',' << name << '.' << stat;
+        }
+        out << '\n';
+    } else {
+        out << "{\"tier\":\"" << TelemetryLog::tierName(tier) << "\",\"series\":[";
+        for (size_t c = 0; c < columns.size(); ++c) {
+            if (c) out << ',';
+            writeJsonString(out, columns[c]);
+        }
+        out << "],\"rows\":[";
+    }
+
+    // Column -> index in the current segment's series, rebuilt when the segment changes
+    size_t mapped = SIZE_MAX;
+    std::vector<int> index;
+    size_t written = 0;
+    const size_t stride = rollup ? 3 : 1;
+    const char* missing = format == CSV ? "" : "null";
+
+    forEach(tier, fromMs, toMs, [&](const Row& row) {
+        if (row.segment != mapped) {
+            mapped = row.segment;
+            index.assign(columns.size(), -1);
+            for (size_t c = 0; c < columns.size(); ++c) {
+                auto it = std::find(row.series->begin(), row.series->end(), columns[c]);
+                if (it != row.series->end()) index[c] = int(it - row.series->begin());
+            }
+        }
+
+        char time[40];
+        formatTime(row.timeMs, time, sizeof(time));
+        if (format == CSV) {
+            out << time;
+            if (rollup) out << ',' << row.rows;
+            for (size_t c = 0; c < columns.size(); ++c) {
+                for (size_t k = 0; k < stride; ++k) {
+                    out << ',';
+                    if (index[c] >= 0) writeNumber(out, row.values[size_t(index[c]) * stride + k], missing);
+                }
+            }
+            out << '\n';
+        } else {
+            out << (written ? ",\n" : "\n") << "{\"time\":\"" << time << "\",\"timeMs\":" << row.timeMs;
+            if (rollup) out << ",\"rows\":" << row.rows;
+            out << ",\"values\":[";
+            for (size_t c = 0; c < columns.size(); ++c) {
+                if (c) out << ',';
+                if (rollup) out << '[';
+                for (size_t k = 0; k < stride; ++k) {
+                    if (k) out << ',';
+                    if (index[c] >= 0) {
+                        writeNumber(out, row.values[size_t(index[c]) * stride + k], missing);
+                    } else {
+                        out << missing;
+                    }
+                }
+                if (rollup) out << ']';
+            }
+            out << "]}";
+        }
+        ++written;
+    });
+
+    if (format == JSON) out << (written ? "\n" : "") << "]}\n";
+    return written;
+}
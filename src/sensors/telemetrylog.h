@@ -0,0 +1,158 @@
+/*---------------------------------------------------------*\
+||| telemetrylog.h                                          |
+|||                                                         |
+|||   Persistent telemetry log                             |
+|||   Three tiers of append-only segment files: raw rows   |
+|||   (normally 1 Hz), and 1 minute and 1 hour rollups     |
+|||   holding min/avg/max per series. Segments are         |
+|||   preallocated and mmap'd; every record carries a      |
+|||   CRC, so after a crash the log resumes at the first   |
+|||   torn or empty record. Rows are buffered and copied   |
+|||   into the mapping once per flush interval, so the     |
+|||   kernel writes back a page or two a minute and        |
+|||   nothing is fsync'd except a segment being sealed.    |
+|||   Each tier keeps its newest segments within a byte    |
+|||   budget.                                               |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class TelemetryLog {
+public:
+    enum Tier {
+        RAW,
+        MINUTE,
+        HOUR,
+        TIER_COUNT
+    };
+
+    struct Limits {
+        Limits();
+
+        // Retention per tier (32 / 16 / 4 MiB); the oldest segments go first. At 1 Hz
+        // with ~20 series a raw row is ~100 bytes, so the defaults keep about 3 days
+        // of raw data, 6 weeks of minutes and a year and a half of hours.
+        size_t tierBytes[TIER_COUNT];
+        size_t segmentBytes[TIER_COUNT];    // 1 MiB / 256 KiB / 64 KiB
+
+        // Rows held in memory before they reach the mapping (60); a crash loses at
+        // most this many seconds
+        int flushSeconds;
+    };
+
+    TelemetryLog();
+    ~TelemetryLog();
+
+    TelemetryLog(const TelemetryLog&) = delete;
+    TelemetryLog& operator=(const TelemetryLog&) = delete;
+
+    // $XDG_STATE_HOME/ll-connect3/telemetry, or ~/.local/state/ll-connect3/telemetry
+    static std::string defaultDirectory();
+
+    static const char* tierName(Tier tier);
+
+    // Creates the directory if needed and continues the newest segment of each tier
+    // when it has the same series; otherwise starts new ones. False with error() set
+    // if the directory or a segment can't be used.
+    bool open(const std::string& directory, const std::vector<std::string>& series,
+              const Limits& limits = Limits());
+
+    // Writes out partial rollups and buffered rows, then unmaps everything
+    void close();
+
+    bool isOpen() const;
+    std::string error() const;
+
+    // One row of values[series.size()], NaN where a sensor has no reading
+    void append(int64_t timeMs, const float* values);
+
+    // Copy buffered rows into the segments now
+    void flush();
+
+private:
+    struct Segment {
+        int fd = -1;
+        uint8_t* map = nullptr;
+        size_t size = 0;
+        size_t used = 0;        // Header plus committed records
+    };
+
+    struct Rollup {
+        int64_t bucket = -1;    // Start of the current minute or hour
+        uint32_t rows = 0;
+        std::vector<float> min, max;
+        std::vector<double> sum;
+        std::vector<uint32_t> count;
+    };
+
+    bool openTier(Tier tier);
+    bool startSegment(Tier tier, int64_t timeMs);
+    void sealSegment(Tier tier);
+    void enforceRetention(Tier tier);
+    void queueRecord(Tier tier, int64_t timeMs, uint32_t rows, const float* values);
+    void emitRollup(Tier tier);
+    void commit(Tier tier);
+
+    size_t recordBytes(Tier tier) const;
+
+    mutable std::mutex m_mutex;
+    std::string m_directory;
+    std::vector<std::string> m_series;
+    Limits m_limits;
+    std::string m_error;
+
+    Segment m_segments[TIER_COUNT];
+    std::vector<uint8_t> m_pending[TIER_COUNT];
+    Rollup m_rollups[TIER_COUNT];           // MINUTE and HOUR only
+    std::vector<float> m_scratch;
+    int64_t m_nextFlush;
+};
+
+// Reads the segments of one tier in time order; works while the app is writing
+// (rows still buffered in the writer are not visible yet)
+class TelemetryReader {
+public:
+    struct Row {
+        int64_t timeMs;
+        uint32_t rows;                      // Raw rows summarised (1 for RAW)
+        size_t segment;                     // Changes when the series list may have
+        const std::vector<std::string>* series;
+        const float* values;                // RAW: one per series; rollups: min, avg, max per series
+    };
+
+    explicit TelemetryReader(const std::string& directory);
+
+    // Every series name found in the tier's segments, in first-seen order
+    std::vector<std::string> series(TelemetryLog::Tier tier) const;
+
+    // Calls back for each valid record with fromMs <= time <= toMs; false if the
+    // directory can't be read
+    bool forEach(TelemetryLog::Tier tier, int64_t fromMs, int64_t toMs,
+                 const std::function<void(const Row&)>& callback) const;
+
+    enum Format { CSV, JSON };
+
+    // Writes the selected series (all when empty) as CSV (one column per series, or
+    // min/avg/max columns for rollups) or a JSON object whose rows hold values in
+    // "series" order ([min, avg, max] each for rollups). Times are UTC ISO 8601;
+    // missing values are empty (CSV) or null (JSON). Returns rows written.
+    size_t exportTo(std::ostream& out, Format format, TelemetryLog::Tier tier,
+                    int64_t fromMs, int64_t toMs,
+                    const std::vector<std::string>& select = std::vector<std::string>()) const;
+
+private:
+    std::vector<std::string> segmentFiles(TelemetryLog::Tier tier) const;
+
+    std::string m_directory;
+};
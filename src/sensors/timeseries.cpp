@@ -0,0 +1,401 @@
+/*---------------------------------------------------------*\
+||| timeseries.cpp                                          |
+|||                                                         |
+|||   In-memory telemetry history                          |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "timeseries.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// Quantised stand-in for NaN
+const int32_t MISSING = INT32_MIN;
+
+// first value (4 bytes little endian) + delta width (1 byte); second-order columns
+// also keep their first delta (4 bytes) so it doesn't set the width of the rest
+const size_t HEADER_BYTES = 5;
+const size_t SECOND_ORDER_HEADER_BYTES = 9;
+
+void putInt32(uint8_t* out, int32_t value) {
+    const uint32_t v = uint32_t(value);
+    out[0] = uint8_t(v);
+    out[1] = uint8_t(v >> 8);
+    out[2] = uint8_t(v >> 16);
+    out[3] = uint8_t(v >> 24);
+}
+
+int32_t getInt32(const uint8_t* in) {
+    return int32_t(uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24);
+}
+
+uint64_t zigzag(int64_t v) {
+    return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v) {
+    return int64_t(v >> 1) ^ -int64_t(v & 1);
+}
+
+int bitWidth(uint64_t v) {
+    int width = 0;
+    while (v) {
+        ++width;
+        v >>= 1;
+    }
+    return width;
+}
+
+// LSB-first bit packing straight into the ring
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_out(out), m_acc(0), m_bits(0) {}
+
+    void put(uint64_t value, int width) {
+        while (width > 0) {
+            const int chunk = std::min(width, 32);
+            m_acc |= (value & ((uint64_t(1) << chunk) - 1)) << m_bits;
+            m_bits += chunk;
+            value >>= chunk;
+            width -= chunk;
+            while (m_bits >= 8) {
+                *m_out++ = uint8_t(m_acc);
+                m_acc >>= 8;
+                m_bits -= 8;
+            }
+        }
+    }
+
+    void flush() {
+        if (m_bits > 0) *m_out++ = uint8_t(m_acc);
+        m_acc = 0;
+        m_bits = 0;
+    }
+
+private:
+    uint8_t* m_out;
+    uint64_t m_acc;
+    int m_bits;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : m_in(in), m_acc(0), m_bits(0) {}
+
+    uint64_t get(int width) {
+        uint64_t value = 0;
+        int shift = 0;
+        while (width > 0) {
+            const int chunk = std::min(width, 32);
+            while (m_bits < chunk) {
+                m_acc |= uint64_t(*m_in++) << m_bits;
+                m_bits += 8;
+            }
+            value |= (m_acc & ((uint64_t(1) << chunk) - 1)) << shift;
+            m_acc >>= chunk;
+            m_bits -= chunk;
+            shift += chunk;
+            width -= chunk;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_in;
+    uint64_t m_acc;
+    int m_bits;
+};
+
+int32_t quantise(float value, float quantum) {
+    if (std::isnan(value)) return MISSING;
+    const double q = std::nearbyint(double(value) / quantum);
+    if (q <= double(INT32_MIN + 1)) return INT32_MIN + 1;
+    if (q >= double(INT32_MAX)) return INT32_MAX;
+    return int32_t(q);
+}
+
+float dequantise(int32_t q, float quantum) {
+    return q == MISSING ? NAN : float(double(q) * quantum);
+}
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(size_t maxRows, size_t bytesPerSeries)
+    : m_maxBlocks(std::max<size_t>(2, (maxRows + BLOCK_ROWS - 1) / BLOCK_ROWS))
+    , m_blockTime(m_maxBlocks, 0)
+    , m_blockRows(m_maxBlocks, 0)
+    , m_firstBlock(0)
+    , m_nextBlock(0)
+    , m_bytesPerColumn(std::max<size_t>(bytesPerSeries, 2048))
+    , m_openTime(0)
+    , m_openRows(0)
+    , m_rows(0)
+    , m_newestTime(-1)
+{
+}
+
+int TimeSeriesStore::addSeries(const std::string& name, float quantum) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_rows > 0) return -1;
+
+    m_names.push_back(name);
+    m_quanta.push_back(quantum > 0.0f ? quantum : 1.0f);
+
+    // Sized once here; append() never reallocates
+    const size_t columns = m_names.size() + 1;
+    m_arena.assign((columns + 1) * m_bytesPerColumn, 0);
+    m_head.assign(columns, 0);
+    m_columnFirst.assign(columns, 0);
+    m_offset.assign(columns * m_maxBlocks, 0);
+    m_size.assign(columns * m_maxBlocks, 0);
+    m_open.assign(columns * BLOCK_ROWS, 0);
+    return int(m_names.size()) - 1;
+}
+
+int TimeSeriesStore::seriesId(const std::string& name) const {
+    auto it = std::find(m_names.begin(), m_names.end(), name);
+    return it == m_names.end() ? -1 : int(it - m_names.begin());
+}
+
+uint64_t TimeSeriesStore::firstBlock(size_t column) const {
+    return std::max(m_columnFirst[column], m_firstBlock);
+}
+
+void TimeSeriesStore::storeBlock(size_t column, const int32_t* raw, int rows, bool secondOrder) {
+    // Widest delta decides the block's width
+    const int firstPacked = secondOrder ? 2 : 1;
+    const size_t header = secondOrder ? SECOND_ORDER_HEADER_BYTES : HEADER_BYTES;
+    uint64_t widest = 0;
+    for (int i = firstPacked; i < rows; ++i) {
+        int64_t delta = int64_t(raw[i]) - raw[i - 1];
+        if (secondOrder) delta -= int64_t(raw[i - 1]) - raw[i - 2];
+        widest |= zigzag(delta);
+    }
+    const int width = bitWidth(widest);
+    const size_t packed = rows > firstPacked ? size_t(rows - firstPacked) : 0;
+    const size_t size = header + (packed * size_t(width) + 7) / 8;
+
+    // Find room in the ring, evicting this column's oldest blocks as needed. The
+    // time column is shared by every series, so running out there drops the block
+    // for all of them.
+    auto evictOldest = [&]() {
+        if (column == 0) {
+            ++m_firstBlock;
+        } else {
+            m_columnFirst[column] = firstBlock(column) + 1;
+        }
+    };
+    auto oldest = [&](uint32_t& offset, uint32_t& length) {
+        const uint64_t first = firstBlock(column);
+        if (first >= m_nextBlock) return false;
+        const size_t slot = column * m_maxBlocks + first % m_maxBlocks;
+        offset = m_offset[slot];
+        length = m_size[slot];
+        return true;
+    };
+
+    uint32_t head = m_head[column];
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    if (head + size > columnCapacity(column)) {
+        // Blocks between the head and the end are the oldest; they go before wrapping
+        while (oldest(offset, length) && offset >= head) evictOldest();
+        head = 0;
+    }
+    while (oldest(offset, length) && offset < head + size && head < offset + length) evictOldest();
+
+    uint8_t* out = &m_arena[columnBase(column) + head];
+    putInt32(out, raw[0]);
+    out[4] = uint8_t(width);
+    if (secondOrder) putInt32(out + 5, rows > 1 ? raw[1] - raw[0] : 0);
+
+    BitWriter writer(out + header);
+    for (int i = firstPacked; i < rows && width > 0; ++i) {
+        int64_t delta = int64_t(raw[i]) - raw[i - 1];
+        if (secondOrder) delta -= int64_t(raw[i - 1]) - raw[i - 2];
+        writer.put(zigzag(delta), width);
+    }
+    writer.flush();
+
+    const size_t slot = column * m_maxBlocks + m_nextBlock % m_maxBlocks;
+    m_offset[slot] = head;
+    m_size[slot] = uint16_t(size);
+    m_head[column] = uint32_t(head + size);
+}
+
+int TimeSeriesStore::decodeBlock(size_t column, uint64_t block, int32_t* raw) const {
+    const size_t slot = block % m_maxBlocks;
+    const int rows = m_blockRows[slot];
+    const uint8_t* in = &m_arena[columnBase(column) + m_offset[column * m_maxBlocks + slot]];
+    const bool secondOrder = column == 0;
+
+    raw[0] = getInt32(in);
+    const int width = in[4];
+    int64_t delta = 0;
+    int i = 1;
+    if (secondOrder && rows > 1) {
+        delta = getInt32(in + 5);
+        raw[1] = int32_t(int64_t(raw[0]) + delta);
+        i = 2;
+    }
+
+    BitReader reader(in + (secondOrder ? SECOND_ORDER_HEADER_BYTES : HEADER_BYTES));
+    for (; i < rows; ++i) {
+        const int64_t step = width > 0 ? unzigzag(reader.get(width)) : 0;
+        delta = secondOrder ? delta + step : step;
+        raw[i] = int32_t(int64_t(raw[i - 1]) + delta);
+    }
+    return rows;
+}
+
+bool TimeSeriesStore::sealBlock() {
+    if (m_openRows == 0) return false;
+
+    // Index ring full: the oldest block goes for every column
+    if (m_nextBlock - m_firstBlock >= m_maxBlocks) ++m_firstBlock;
+
+    const size_t columns = m_names.size() + 1;
+    for (size_t column = 0; column < columns; ++column) {
+        storeBlock(column, &m_open[column * BLOCK_ROWS], m_openRows, column == 0);
+    }
+    const size_t slot = m_nextBlock % m_maxBlocks;
+    m_blockTime[slot] = m_openTime;
+    m_blockRows[slot] = uint8_t(m_openRows);
+    ++m_nextBlock;
+    m_openRows = 0;
+    return true;
+}
+
+void TimeSeriesStore::append(int64_t timeMs, const float* values) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_names.empty()) return;
+    timeMs = std::max(timeMs, m_newestTime);
+
+    // Times in the open block are offsets from its first row; start a new block
+    // rather than overflow one across a very long gap
+    if (m_openRows == BLOCK_ROWS || (m_openRows > 0 && timeMs - m_openTime > INT32_MAX)) sealBlock();
+    if (m_openRows == 0) m_openTime = timeMs;
+
+    const size_t columns = m_names.size() + 1;
+    m_open[m_openRows] = int32_t(timeMs - m_openTime);
+    for (size_t column = 1; column < columns; ++column) {
+        m_open[column * BLOCK_ROWS + m_openRows] = quantise(values[column - 1], m_quanta[column - 1]);
+    }
+    ++m_openRows;
+    ++m_rows;
+    m_newestTime = timeMs;
+}
+
+// Last indexed block starting at or before timeMs (or the first one)
+uint64_t TimeSeriesStore::findBlock(int64_t timeMs) const {
+    uint64_t low = m_firstBlock;
+    uint64_t high = m_nextBlock;
+    while (high - low > 1) {
+        const uint64_t middle = low + (high - low) / 2;
+        if (m_blockTime[middle % m_maxBlocks] <= timeMs) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+size_t TimeSeriesStore::query(int series, int64_t fromMs, int64_t toMs,
+                              int64_t* times, float* values, size_t maxPoints) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (series < 0 || series >= seriesCount() || maxPoints == 0 || fromMs > toMs) return 0;
+
+    const size_t valueColumn = column(series);
+    const float quantum = m_quanta[size_t(series)];
+    size_t count = 0;
+
+    auto emit = [&](int64_t base, const int32_t* t, const int32_t* v, int rows) {
+        for (int i = 0; i < rows && count < maxPoints; ++i) {
+            const int64_t time = base + t[i];
+            if (time < fromMs) continue;
+            if (time > toMs) return false;
+            times[count] = time;
+            values[count] = dequantise(v[i], quantum);
+            ++count;
+        }
+        return count < maxPoints;
+    };
+
+    int32_t t[BLOCK_ROWS];
+    int32_t v[BLOCK_ROWS];
+    uint64_t block = std::max(firstBlock(valueColumn), m_nextBlock > m_firstBlock ? findBlock(fromMs) : m_nextBlock);
+    for (; block < m_nextBlock; ++block) {
+        const int64_t base = m_blockTime[block % m_maxBlocks];
+        if (base > toMs) return count;
+        const int rows = decodeBlock(0, block, t);
+        decodeBlock(valueColumn, block, v);
+        if (!emit(base, t, v, rows)) return count;
+    }
+
+    if (m_openRows > 0) {
+        emit(m_openTime, &m_open[0], &m_open[valueColumn * BLOCK_ROWS], m_openRows);
+    }
+    return count;
+}
+
+std::vector<TimeSeriesStore::Point> TimeSeriesStore::range(int series, int64_t fromMs, int64_t toMs) const {
+    // Upper bound from the row count; exact enough, and only the caller's vector allocates
+    size_t capacity = size_t(std::min<uint64_t>(rowCount(), uint64_t(m_maxBlocks + 1) * BLOCK_ROWS));
+    std::vector<int64_t> times(capacity);
+    std::vector<float> values(capacity);
+    size_t count = query(series, fromMs, toMs, times.data(), values.data(), capacity);
+
+    std::vector<Point> points(count);
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = { times[i], values[i] };
+    }
+    return points;
+}
+
+float TimeSeriesStore::latest(int series) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (series < 0 || series >= seriesCount()) return NAN;
+    const float quantum = m_quanta[size_t(series)];
+    const size_t valueColumn = column(series);
+
+    if (m_openRows > 0) return dequantise(m_open[valueColumn * BLOCK_ROWS + m_openRows - 1], quantum);
+    if (m_nextBlock == firstBlock(valueColumn)) return NAN;
+
+    int32_t v[BLOCK_ROWS];
+    const int rows = decodeBlock(valueColumn, m_nextBlock - 1, v);
+    return dequantise(v[rows - 1], quantum);
+}
+
+int64_t TimeSeriesStore::oldestTime(int series) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (series < 0 || series >= seriesCount()) return -1;
+    const uint64_t first = firstBlock(column(series));
+    if (first < m_nextBlock) return m_blockTime[first % m_maxBlocks];
+    return m_openRows > 0 ? m_openTime : -1;
+}
+
+int64_t TimeSeriesStore::newestTime() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_newestTime;
+}
+
+uint64_t TimeSeriesStore::rowCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rows;
+}
+
+size_t TimeSeriesStore::memoryBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_arena.size()
+        + m_open.size() * sizeof(int32_t)
+        + m_offset.size() * sizeof(uint32_t)
+        + m_size.size() * sizeof(uint16_t)
+        + m_blockTime.size() * sizeof(int64_t)
+        + m_blockRows.size();
+}
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------*\
+||| timeseries.h                                            |
+|||                                                         |
+|||   In-memory telemetry history                          |
+|||   Rows of (time, value per series) go into fixed-size, |
+|||   per-column byte rings in blocks of BLOCK_ROWS. Each   |
+|||   sealed block stores its first value and zigzag deltas |
+|||   bit-packed at the block's widest width; values are    |
+|||   quantised to a per-series step first. Appends are    |
+|||   O(1) and allocate nothing after construction.        |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TimeSeriesStore {
+public:
+    static const int BLOCK_ROWS = 128;
+
+    // maxRows caps retention by count (default 48 h at 1 Hz); bytesPerSeries is each
+    // column's ring. A smooth series (temperature in 0.1 °C steps) packs a block into
+    // ~50 bytes, so the default holds 24 h at 1 Hz in 48 KiB; a column that
+    // compresses worse loses its oldest blocks first without affecting the others.
+    explicit TimeSeriesStore(size_t maxRows = 2 * 86400, size_t bytesPerSeries = 48 * 1024);
+
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+    // Register all series before the first append; quantum is the stored resolution
+    // (0.1 for °C, 0.001 for V). Returns the series id, or -1 once rows exist.
+    int addSeries(const std::string& name, float quantum);
+
+    int seriesCount() const { return int(m_names.size()); }
+    int seriesId(const std::string& name) const;
+    const std::string& seriesName(int series) const { return m_names[size_t(series)]; }
+
+    // One row: values[seriesCount()], NaN where a sensor has no reading. Times must
+    // not go backwards (milliseconds, any epoch).
+    void append(int64_t timeMs, const float* values);
+
+    // Rows with fromMs <= time <= toMs, oldest first, at most maxPoints; returns
+    // the number written
+    size_t query(int series, int64_t fromMs, int64_t toMs,
+                 int64_t* times, float* values, size_t maxPoints) const;
+
+    struct Point {
+        int64_t timeMs;
+        float value;
+    };
+    std::vector<Point> range(int series, int64_t fromMs, int64_t toMs) const;
+
+    // Most recent value, NaN when empty
+    float latest(int series) const;
+
+    // Oldest time still held for a series (-1 if none) and the newest row's time
+    int64_t oldestTime(int series) const;
+    int64_t newestTime() const;
+
+    uint64_t rowCount() const;          // Appended since construction
+    size_t memoryBytes() const;         // Everything allocated for the store
+
+private:
+    // Column 0 is the time column (milliseconds since the block's first row,
+    // second-order deltas); columns 1.. are the series
+    size_t column(int series) const { return size_t(series) + 1; }
+
+    // Every row has a time, so the time column gets a double-sized ring
+    size_t columnBase(size_t column) const { return column == 0 ? 0 : (column + 1) * m_bytesPerColumn; }
+    size_t columnCapacity(size_t column) const { return column == 0 ? 2 * m_bytesPerColumn : m_bytesPerColumn; }
+
+    bool sealBlock();
+    void storeBlock(size_t column, const int32_t* raw, int rows, bool secondOrder);
+    int decodeBlock(size_t column, uint64_t block, int32_t* raw) const;
+    uint64_t firstBlock(size_t column) const;
+    uint64_t findBlock(int64_t timeMs) const;
+
+    std::vector<std::string> m_names;
+    std::vector<float> m_quanta;
+
+    // Block index, a ring of m_maxBlocks entries addressed by sequence % m_maxBlocks
+    size_t m_maxBlocks;
+    std::vector<int64_t> m_blockTime;   // First row's time
+    std::vector<uint8_t> m_blockRows;
+    uint64_t m_firstBlock;              // Oldest sealed block still indexed
+    uint64_t m_nextBlock;
+
+    // Per column: byte ring, write head, oldest block it still holds, and for each
+    // indexed block its offset and size ([column * m_maxBlocks + slot])
+    size_t m_bytesPerColumn;
+    std::vector<uint8_t> m_arena;
+    std::vector<uint32_t> m_head;
+    std::vector<uint64_t> m_columnFirst;
+    std::vector<uint32_t> m_offset;
+    std::vector<uint16_t> m_size;
+
+    // The open block, quantised but not yet packed ([column * BLOCK_ROWS + row])
+    std::vector<int32_t> m_open;
+    int64_t m_openTime;
+    int m_openRows;
+
+    uint64_t m_rows;
+    int64_t m_newestTime;
+    mutable std::mutex m_mutex;
+};
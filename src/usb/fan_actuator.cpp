@@ -0,0 +1,249 @@
+/*---------------------------------------------------------*\
+|| fan_actuator.cpp                                        |
+||                                                         |
+||   Fan duty writer for the SL Infinity kernel driver    |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "fan_actuator.h"
+#include "../utils/debugutil.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// How long a negative (or positive) driver probe result is trusted
+constexpr auto PROBE_INTERVAL = std::chrono::seconds(5);
+
+// Window used to compute writes per second
+constexpr auto RATE_WINDOW = std::chrono::seconds(1);
+
+} // namespace
+
+FanActuator::FanActuator(const std::string& procRoot)
+    : m_procRoot(procRoot)
+    , m_minInterval(200)
+    , m_rateWindowStart(Clock::now())
+    , m_rateWindowWrites(0)
+    , m_latencySumUs(0.0)
+    , m_available(false)
+    , m_lastProbe()
+{
+}
+
+FanActuator::~FanActuator()
+{
+    Close();
+}
+
+bool FanActuator::IsAvailable() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // An open fd is proof enough that the driver is loaded
+    for (const PortState& port : m_ports)
+    {
+        if (port.fd >= 0)
+        {
+            return true;
+        }
+    }
+
+    Clock::time_point now = Clock::now();
+    if (m_lastProbe == Clock::time_point() || now - m_lastProbe >= PROBE_INTERVAL)
+    {
+        std::string path = m_procRoot + "/Port_1/fan_speed";
+        m_available = (access(path.c_str(), F_OK) == 0);
+        m_lastProbe = now;
+    }
+    return m_available;
+}
+
+FanActuator::WriteResult FanActuator::SetDuty(int port, int percent, bool force)
+{
+    if (port < 1 || port > PORT_COUNT)
+    {
+        return WRITE_FAILED;
+    }
+
+    int duty = std::clamp(percent, 0, 100);
+    int index = port - 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PortState& state = m_ports[index];
+    Clock::time_point now = Clock::now();
+
+    if (!force && duty == state.lastDuty)
+    {
+        // A newer request cancels anything still pending for this port
+        state.pendingDuty = -1;
+        m_stats.suppressed++;
+        return WRITE_SUPPRESSED;
+    }
+
+    if (!force && state.lastDuty >= 0 && now - state.lastWrite < m_minInterval)
+    {
+        state.pendingDuty = duty;
+        m_stats.deferred++;
+        return WRITE_DEFERRED;
+    }
+
+    return WritePort(index, duty, now);
+}
+
+void FanActuator::FlushPending()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clock::time_point now = Clock::now();
+
+    for (int index = 0; index < PORT_COUNT; index++)
+    {
+        PortState& state = m_ports[index];
+        if (state.pendingDuty < 0 || now - state.lastWrite < m_minInterval)
+        {
+            continue;
+        }
+        WritePort(index, state.pendingDuty, now);
+    }
+    UpdateRate(now);
+}
+
+int FanActuator::GetLastDuty(int port) const
+{
+    if (port < 1 || port > PORT_COUNT)
+    {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_ports[port - 1].lastDuty;
+}
+
+void FanActuator::SetMinInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_minInterval = std::max(std::chrono::milliseconds(0), interval);
+}
+
+std::chrono::milliseconds FanActuator::GetMinInterval() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_minInterval;
+}
+
+FanActuatorStats FanActuator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void FanActuator::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = FanActuatorStats();
+    m_rateWindowStart = Clock::now();
+    m_rateWindowWrites = 0;
+    m_latencySumUs = 0.0;
+}
+
+void FanActuator::Close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int index = 0; index < PORT_COUNT; index++)
+    {
+        ClosePort(index);
+    }
+}
+
+bool FanActuator::OpenPort(int index)
+{
+    PortState& state = m_ports[index];
+    if (state.fd >= 0)
+    {
+        return true;
+    }
+
+    std::string path = m_procRoot + "/Port_" + std::to_string(index + 1) + "/fan_speed";
+    state.fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (state.fd < 0)
+    {
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to open %s: %s\n", path.c_str(), std::strerror(errno));
+        m_available = false;
+        m_lastProbe = Clock::now();
+        return false;
+    }
+
+    m_available = true;
+    return true;
+}
+
+void FanActuator::ClosePort(int index)
+{
+    PortState& state = m_ports[index];
+    if (state.fd >= 0)
+    {
+        close(state.fd);
+        state.fd = -1;
+    }
+}
+
+FanActuator::WriteResult FanActuator::WritePort(int index, int duty, Clock::time_point now)
+{
+    PortState& state = m_ports[index];
+    state.pendingDuty = -1;
+
+    if (!OpenPort(index))
+    {
+        m_stats.failures++;
+        return WRITE_FAILED;
+    }
+
+    char buf[8];
+    int len = std::snprintf(buf, sizeof(buf), "%d", duty);
+
+    Clock::time_point start = Clock::now();
+    ssize_t written = pwrite(state.fd, buf, len, 0);
+    Clock::time_point end = Clock::now();
+
+    if (written != len)
+    {
+        // The module may have been reloaded; drop the fd so the next write reopens it
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Write to Port %d failed: %s\n", index + 1, std::strerror(errno));
+        ClosePort(index);
+        m_stats.failures++;
+        return WRITE_FAILED;
+    }
+
+    double latencyUs = std::chrono::duration<double, std::micro>(end - start).count();
+    m_stats.writes++;
+    m_stats.lastLatencyUs = latencyUs;
+    m_stats.maxLatencyUs = std::max(m_stats.maxLatencyUs, latencyUs);
+    m_latencySumUs += latencyUs;
+    m_stats.avgLatencyUs = m_latencySumUs / m_stats.writes;
+
+    state.lastDuty = duty;
+    state.lastWrite = now;
+    m_rateWindowWrites++;
+    UpdateRate(now);
+
+    DEBUG_PRINTF_CATEGORY("FanSpeeds", "Set Port %d to %d%% via kernel driver (%.0f us)\n", index + 1, duty, latencyUs);
+    return WRITE_OK;
+}
+
+void FanActuator::UpdateRate(Clock::time_point now)
+{
+    auto elapsed = now - m_rateWindowStart;
+    if (elapsed < RATE_WINDOW)
+    {
+        return;
+    }
+
+    m_stats.writesPerSecond = m_rateWindowWrites / std::chrono::duration<double>(elapsed).count();
+    m_rateWindowStart = now;
+    m_rateWindowWrites = 0;
+}
@@ -0,0 +1,107 @@
+/*---------------------------------------------------------*\
+|| fan_actuator.h                                          |
+||                                                         |
+||   Fan duty writer for the SL Infinity kernel driver    |
+||   Keeps the /proc port files open, drops writes that   |
+||   do not change the quantized duty and rate-limits     |
+||   each port                                             |
+||                                                         |
+||   This file is part of the L-Connect project           |
+||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/*----------------------------------------------------------------------------*\
+|| Actuator statistics                                                         |
+\*----------------------------------------------------------------------------*/
+
+struct FanActuatorStats
+{
+    uint64_t writes             = 0;    // Successful writes to the driver
+    uint64_t suppressed         = 0;    // Dropped because the duty did not change
+    uint64_t deferred           = 0;    // Held back by the per-port minimum interval
+    uint64_t failures           = 0;    // open()/pwrite() errors
+    double   writesPerSecond    = 0.0;  // Rate over the last completed window
+    double   lastLatencyUs      = 0.0;
+    double   avgLatencyUs       = 0.0;
+    double   maxLatencyUs       = 0.0;
+};
+
+/*----------------------------------------------------------------------------*\
+|| Fan Actuator Class                                                          |
+\*----------------------------------------------------------------------------*/
+
+class FanActuator
+{
+public:
+    static constexpr int PORT_COUNT = 4;
+
+    enum WriteResult
+    {
+        WRITE_OK,           // Duty written to the driver
+        WRITE_SUPPRESSED,   // Same quantized duty as last write, nothing to do
+        WRITE_DEFERRED,     // Minimum interval not elapsed, kept as pending
+        WRITE_FAILED,       // Driver missing or write error
+    };
+
+    explicit FanActuator(const std::string& procRoot = "/proc/Lian_li_SL_INFINITY");
+    ~FanActuator();
+
+    FanActuator(const FanActuator&) = delete;
+    FanActuator& operator=(const FanActuator&) = delete;
+
+    // Driver presence, re-probed at most every few seconds
+    bool IsAvailable() const;
+
+    // Request a duty (0-100%) for port 1-4. force bypasses suppression and the interval.
+    WriteResult SetDuty(int port, int percent, bool force = false);
+
+    // Write any deferred duties whose interval has elapsed. Call once per control tick.
+    void FlushPending();
+
+    // Last duty actually written to the port, -1 if none yet
+    int GetLastDuty(int port) const;
+
+    void SetMinInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds GetMinInterval() const;
+
+    FanActuatorStats GetStats() const;
+    void ResetStats();
+
+    // Close all port files (they are reopened on the next write)
+    void Close();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PortState
+    {
+        int                 fd          = -1;
+        int                 lastDuty    = -1;
+        int                 pendingDuty = -1;
+        Clock::time_point   lastWrite   = {};
+    };
+
+    std::string                 m_procRoot;
+    PortState                   m_ports[PORT_COUNT];
+    std::chrono::milliseconds   m_minInterval;
+    FanActuatorStats            m_stats;
+    Clock::time_point           m_rateWindowStart;
+    uint64_t                    m_rateWindowWrites;
+    double                      m_latencySumUs;
+
+    mutable bool                m_available;
+    mutable Clock::time_point   m_lastProbe;
+    mutable std::mutex          m_mutex;
+
+    bool OpenPort(int index);
+    void ClosePort(int index);
+    WriteResult WritePort(int index, int duty, Clock::time_point now);
+    void UpdateRate(Clock::time_point now);
+};
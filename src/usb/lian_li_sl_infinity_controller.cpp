@@ -385,19 +385,13 @@ bool LianLiSLInfinityController::SetChannelSpeed(uint8_t channel, uint8_t speed)
     }
 
     // Use kernel driver for fan control (more reliable than direct HID)
-    std::string procPath = "/proc/Lian_li_SL_INFINITY/Port_" + std::to_string(channel + 1) + "/fan_speed";
-    
-    std::ofstream file(procPath);
-    if (file.is_open()) {
-        file << (int)speed;
-        file.close();
-        
-        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Successfully set Port %d to %d%% via kernel driver\n", (channel + 1), (int)speed);
-        return true;
-    } else {
-        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to open %s for writing\n", procPath.c_str());
+    FanActuator::WriteResult result = m_fanActuator.SetDuty(channel + 1, speed);
+    if (result == FanActuator::WRITE_FAILED)
+    {
+        DEBUG_PRINTF_CATEGORY("FanSpeeds", "Failed to set Port %d to %d%% via kernel driver\n", (channel + 1), (int)speed);
         return false;
     }
+    return true;
 }
 
 bool LianLiSLInfinityController::SetChannelDirection(uint8_t channel, uint8_t direction)
@@ -485,7 +479,11 @@ bool LianLiSLInfinityController::GetChannelSpeed(uint8_t channel, uint8_t& speed
 
 bool LianLiSLInfinityController::IsKernelDriverAvailable() const
 {
-    // Check if the kernel driver's /proc directory exists
-    std::ifstream file("/proc/Lian_li_SL_INFINITY/Port_1/fan_speed");
-    return file.good();
+    // Cached by the actuator so the hot path does not open the /proc file every call
+    return m_fanActuator.IsAvailable();
+}
+
+FanActuator& LianLiSLInfinityController::GetFanActuator()
+{
+    return m_fanActuator;
 }
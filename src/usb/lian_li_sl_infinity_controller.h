@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <hidapi.h>
+#include "fan_actuator.h"
 
 /*----------------------------------------------------------------------------*\
 || SL Infinity Specific Definitions                                            |
@@ -122,6 +123,9 @@ public:
     bool GetChannelSpeed(uint8_t channel, uint8_t& speed);
     bool IsKernelDriverAvailable() const;
     
+    // Kernel driver fan duty writer (persistent fds, write suppression, stats)
+    FanActuator& GetFanActuator();
+    
     // Synchronization
     bool Synchronize();
     
@@ -135,6 +139,7 @@ private:
     std::string m_serialNumber;
     std::string m_location;
     bool m_initialized;
+    FanActuator m_fanActuator;
     
     // Internal methods
     bool OpenDevice();
@@ -10,6 +10,7 @@
 
 #include "sl_infinity_hid.h"
 #include "../utils/debugutil.h"
+#include "../utils/trace.h"
 #include <iostream>
 #include <cstring>
 #include <fstream>
@@ -138,6 +139,7 @@ bool SLInfinityHIDController::FindDevice() {
 }
 
 bool SLInfinityHIDController::SendStartAction(uint8_t channel, uint8_t numFans) {
+    TRACE_SCOPE("SLInfinityHID::SendStartAction");
     if (!m_device.IsOpen()) {
         return false;
     }
@@ -157,6 +159,7 @@ bool SLInfinityHIDController::SendStartAction(uint8_t channel, uint8_t numFans)
 }
 
 bool SLInfinityHIDController::SendColorData(uint8_t channel, uint8_t numLeds, const uint8_t* ledData) {
+    TRACE_SCOPE("SLInfinityHID::SendColorData");
     if (!m_device.IsOpen()) {
         return false;
     }
@@ -177,6 +180,7 @@ bool SLInfinityHIDController::SendColorData(uint8_t channel, uint8_t numLeds, co
 }
 
 bool SLInfinityHIDController::SendCommitAction(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness) {
+    TRACE_SCOPE("SLInfinityHID::SendCommitAction");
     if (!m_device.IsOpen()) {
         return false;
     }
@@ -217,6 +221,7 @@ float SLInfinityHIDController::CalculateBrightnessLimit(const SLInfinityColor& c
 }
 
 bool SLInfinityHIDController::SetChannelColors(uint8_t channel, const std::vector<SLInfinityColor>& colors, float brightness, bool interleavedPattern) {
+    TRACE_SCOPE("SLInfinityHID::SetChannelColors");
     DEBUG_PRINTF("SetChannelColors: channel=%d, colors.size()=%zu, brightness=%f, interleavedPattern=%d\n", channel, colors.size(), brightness, interleavedPattern);
     
     if (!m_device.IsOpen() || channel >= 8) {
@@ -507,6 +512,19 @@ bool SLInfinityHIDController::SetChannelColors(uint8_t channel, const std::vecto
     return true;
 }
 
+bool SLInfinityHIDController::SetChannelLeds(uint8_t channel, const uint8_t* ledData) {
+    TRACE_SCOPE("SLInfinityHID::SetChannelLeds");
+    if (!m_device.IsOpen() || channel >= 8) {
+        return false;
+    }
+
+    // Same start + 80 LED transfer SetChannelColors ends with
+    if (!SendStartAction(channel, 4)) {
+        return false;
+    }
+    return SendColorData(channel, 80, ledData);
+}
+
 bool SLInfinityHIDController::SetChannelMode(uint8_t channel, uint8_t mode) {
     DEBUG_PRINTF("SetChannelMode: channel=%d, mode=0x%02X\n", channel, mode);
     
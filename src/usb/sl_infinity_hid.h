@@ -65,6 +65,10 @@ public:
     bool SetChannelMode(uint8_t channel, uint8_t mode);
     bool TurnOffChannel(uint8_t channel);
     bool TurnOffAllChannels();
+
+    // Host-driven effects: 80 LEDs of R, B, G bytes (one LedFrame channel) sent
+    // as they are, without the brightness scaling or limiter SetChannelColors applies
+    bool SetChannelLeds(uint8_t channel, const uint8_t* ledData);
     
     // Public methods for testing
     bool SendCommitAction(uint8_t channel, uint8_t effect, uint8_t speed, uint8_t direction, uint8_t brightness);
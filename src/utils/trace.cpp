@@ -0,0 +1,198 @@
+/*---------------------------------------------------------*\
+||| trace.cpp                                               |
+|||                                                         |
+|||   Scoped-span tracer                                   |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "trace.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Trace {
+
+namespace detail {
+std::atomic<bool> enabled(false);
+}
+
+namespace {
+
+// 24 bytes a span, 384 KB a thread; the oldest spans are overwritten
+const size_t CAPACITY = 16384;
+
+struct Span {
+    const char* name;
+    int64_t begin;
+    int64_t end;
+};
+
+// Written only by its own thread. busy brackets each write so stop() can wait
+// out a writer that saw tracing enabled just before it was switched off.
+struct Buffer {
+    explicit Buffer(int tid) : tid(tid), name(nullptr), count(0), busy(false), spans(CAPACITY) {}
+
+    const int tid;
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> count;
+    std::atomic<bool> busy;
+    std::vector<Span> spans;
+};
+
+std::mutex g_mutex;
+std::vector<std::shared_ptr<Buffer>> g_buffers;     // Kept after their threads exit
+std::string g_path;
+std::string g_error;
+int64_t g_origin = 0;
+int g_nextTid = 1;
+
+thread_local Buffer* t_buffer = nullptr;
+thread_local const char* t_name = nullptr;
+
+Buffer* threadBuffer() {
+    if (t_buffer) return t_buffer;
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_buffers.push_back(std::make_shared<Buffer>(g_nextTid++));
+    t_buffer = g_buffers.back().get();
+    t_buffer->name.store(t_name, std::memory_order_relaxed);
+    return t_buffer;
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", *c);
+            out += escape;
+        } else {
+            out += *c;
+        }
+    }
+}
+
+bool makeParents(const std::string& path) {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        if (mkdir(path.substr(0, slash).c_str(), 0755) != 0 && errno != EEXIST) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void start(const std::string& path, int64_t origin) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_path = path;
+    g_error.clear();
+    if (detail::enabled.load()) return;
+    g_origin = origin > 0 ? origin : now();
+    for (const auto& buffer : g_buffers) {
+        buffer->count.store(0, std::memory_order_relaxed);
+    }
+    detail::enabled.store(true);
+}
+
+void record(const char* name, int64_t beginNs, int64_t endNs) {
+    Buffer* buffer = threadBuffer();
+    buffer->busy.store(true);
+    if (detail::enabled.load()) {
+        const uint64_t index = buffer->count.load(std::memory_order_relaxed);
+        buffer->spans[index % CAPACITY] = { name, beginNs, endNs };
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+    buffer->busy.store(false, std::memory_order_release);
+}
+
+void setThreadName(const char* name) {
+    t_name = name;
+    if (t_buffer) t_buffer->name.store(name, std::memory_order_relaxed);
+}
+
+bool stop() {
+    if (!detail::enabled.exchange(false)) return false;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    const int pid = static_cast<int>(getpid());
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    char line[160];
+    for (const auto& buffer : g_buffers) {
+        while (buffer->busy.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        if (const char* name = buffer->name.load(std::memory_order_relaxed)) {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"",
+                          first ? "" : ",\n", pid, buffer->tid);
+            json += line;
+            appendEscaped(json, name);
+            json += "\"}}";
+            first = false;
+        }
+
+        // Complete ("X") events: one per span, so a ring that wrapped never
+        // leaves an end without its begin
+        const uint64_t count = buffer->count.load(std::memory_order_acquire);
+        const uint64_t oldest = count > CAPACITY ? count - CAPACITY : 0;
+        for (uint64_t i = oldest; i < count; ++i) {
+            const Span& span = buffer->spans[i % CAPACITY];
+            if (span.begin < g_origin) continue;
+            json += first ? "{\"name\":\"" : ",\n{\"name\":\"";
+            appendEscaped(json, span.name);
+            std::snprintf(line, sizeof(line),
+                          "\",\"cat\":\"ll-connect3\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                          (span.begin - g_origin) / 1000.0, (span.end - span.begin) / 1000.0, pid, buffer->tid);
+            json += line;
+            first = false;
+        }
+    }
+    json += "\n]}\n";
+
+    if (!makeParents(g_path)) {
+        g_error = "Cannot create the directory for " + g_path + ": " + std::strerror(errno);
+        return false;
+    }
+    FILE* file = std::fopen(g_path.c_str(), "w");
+    if (!file) {
+        g_error = "Cannot open " + g_path + ": " + std::strerror(errno);
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    if (std::fclose(file) != 0 || !written) {
+        g_error = "Cannot write " + g_path;
+        return false;
+    }
+    return true;
+}
+
+std::string error() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_error;
+}
+
+std::string path() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_path;
+}
+
+std::string defaultPath() {
+    const char* state = std::getenv("XDG_STATE_HOME");
+    if (state && state[0] == '/') return std::string(state) + "/ll-connect3/trace.json";
+    const char* home = std::getenv("HOME");
+    return std::string(home ? home : "") + "/.local/state/ll-connect3/trace.json";
+}
+
+} // namespace Trace
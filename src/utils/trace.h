@@ -0,0 +1,83 @@
+/*---------------------------------------------------------*\
+||| trace.h                                                 |
+|||                                                         |
+|||   Scoped-span tracer                                   |
+|||   TRACE_SCOPE("name") records how long the enclosing  |
+|||   scope took into a per-thread ring buffer; stop()     |
+|||   writes every thread's spans as Chrome trace-event    |
+|||   JSON (chrome://tracing, ui.perfetto.dev). While      |
+|||   tracing is off a scope costs one relaxed load.       |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Trace {
+
+namespace detail {
+extern std::atomic<bool> enabled;
+}
+
+// Monotonic nanoseconds. steady_clock is CLOCK_MONOTONIC, which Linux serves
+// from the vDSO off the TSC: tens of nanoseconds, no system call
+inline int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline bool enabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+// Start recording; stop() writes the trace to path. Timestamps count from
+// origin (a now() value, default the call itself); spans that begin before it
+// are dropped, so pass the launch time to keep spans recorded around start().
+void start(const std::string& path, int64_t origin = 0);
+
+// Stop recording and write the Chrome trace. False when there was nothing to
+// stop or the file couldn't be written (see error()).
+bool stop();
+
+std::string error();
+std::string path();
+
+// $XDG_STATE_HOME/ll-connect3/trace.json, next to the telemetry log
+std::string defaultPath();
+
+// Names the calling thread in the trace; cheap, may be called while tracing is off.
+// name must outlive the trace (a string literal).
+void setThreadName(const char* name);
+
+// One completed span. name must outlive the trace (a string literal).
+void record(const char* name, int64_t beginNs, int64_t endNs);
+
+class Scope {
+public:
+    explicit Scope(const char* name)
+        : m_name(enabled() ? name : nullptr)
+        , m_begin(m_name ? now() : 0) {}
+
+    ~Scope() {
+        if (m_name) record(m_name, m_begin, now());
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_begin;
+};
+
+} // namespace Trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
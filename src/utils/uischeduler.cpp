@@ -0,0 +1,118 @@
+/*---------------------------------------------------------*\
+||| uischeduler.cpp                                         |
+|||                                                         |
+|||   Visibility-aware timer scheduling                    |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "uischeduler.h"
+#include "utils/qtdebugutil.h"
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+
+UiScheduler::UiScheduler(QObject *parent)
+    : QObject(parent)
+    , m_pending(false)
+{
+}
+
+UiScheduler &UiScheduler::instance()
+{
+    static UiScheduler scheduler;
+    return scheduler;
+}
+
+bool UiScheduler::isOnScreen(const QWidget *owner)
+{
+    if (!owner || !owner->isVisible()) {
+        return false;
+    }
+    const QWidget *window = owner->window();
+    return window->isVisible() && !window->isMinimized();
+}
+
+void UiScheduler::addTimer(QTimer *timer, QWidget *owner, Kind kind)
+{
+    if (!timer || !owner) {
+        return;
+    }
+    
+    m_entries.append({ timer, owner, timer->interval(), kind, false });
+    watch(owner);
+    reevaluate();
+}
+
+void UiScheduler::watch(QWidget *widget)
+{
+    for (const QPointer<QWidget> &watched : m_watched) {
+        if (watched == widget) return;
+    }
+    m_watched.append(widget);
+    widget->installEventFilter(this);
+}
+
+bool UiScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    case QEvent::ParentChange:
+        // Several of these arrive together on a page switch or minimize; one pass
+        // after they settle is enough
+        if (!m_pending) {
+            m_pending = true;
+            QMetaObject::invokeMethod(this, &UiScheduler::reevaluate, Qt::QueuedConnection);
+        }
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void UiScheduler::resume(Entry &entry)
+{
+    // Fire once right away, then settle back into the normal period
+    QTimer *timer = entry.timer;
+    const int interval = entry.interval;
+    connect(timer, &QTimer::timeout, timer, [timer, interval]() {
+        timer->setInterval(interval);
+    }, Qt::SingleShotConnection);
+    timer->start(0);
+}
+
+void UiScheduler::reevaluate()
+{
+    m_pending = false;
+    
+    // Timers and owners that were destroyed drop out here
+    for (int i = m_entries.size() - 1; i >= 0; --i) {
+        if (!m_entries[i].timer || !m_entries[i].owner) {
+            m_entries.removeAt(i);
+        }
+    }
+    
+    int paused = 0;
+    for (Entry &entry : m_entries) {
+        // Pages are built before they go into the main window, so the window to
+        // watch for minimize is only known later
+        watch(entry.owner->window());
+        
+        const bool run = entry.kind == Control || isOnScreen(entry.owner);
+        if (run && entry.paused) {
+            entry.paused = false;
+            resume(entry);
+        } else if (!run && !entry.paused) {
+            entry.paused = true;
+            entry.timer->stop();
+            entry.timer->setInterval(entry.interval); // In case it was paused mid-resume
+        }
+        if (entry.paused) ++paused;
+    }
+    
+    DEBUG_LOG_CATEGORY("Scheduler", "timers:", m_entries.size(), "paused:", paused);
+}
@@ -0,0 +1,65 @@
+/*---------------------------------------------------------*\
+||| uischeduler.h                                           |
+|||                                                         |
+|||   Visibility-aware timer scheduling                    |
+|||   Pages register their periodic timers as control or   |
+|||   visual work. Visual timers run only while their      |
+|||   owner widget is shown and its window is neither      |
+|||   hidden nor minimized; control timers always run.     |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+
+class QTimer;
+class QWidget;
+
+class UiScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Control,        // Fan control, logging: never paused
+        Visual          // Repaints and readouts nobody can see when the owner is hidden
+    };
+
+    static UiScheduler &instance();
+
+    // Takes over a timer whose interval is already set (it may or may not be running).
+    // A visual timer is stopped while owner can't be seen; when it comes back the
+    // timer fires at once, so the page never shows a stale value for a whole period.
+    void addTimer(QTimer *timer, QWidget *owner, Kind kind);
+
+    // Owner visible on screen: shown (with all its ancestors) in a window that isn't
+    // minimized
+    static bool isOnScreen(const QWidget *owner);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit UiScheduler(QObject *parent = nullptr);
+
+    struct Entry {
+        QPointer<QTimer> timer;
+        QPointer<QWidget> owner;
+        int interval;
+        Kind kind;
+        bool paused;
+    };
+
+    void watch(QWidget *widget);
+    void reevaluate();
+    void resume(Entry &entry);
+
+    QVector<Entry> m_entries;
+    QVector<QPointer<QWidget>> m_watched;
+    bool m_pending;
+};
@@ -0,0 +1,166 @@
+#include "coreheatstrip.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QHelpEvent>
+#include <QRegion>
+#include <QToolTip>
+#include <cmath>
+
+namespace {
+
+const int LEVELS = 21; // 0%, 5%, ... 100%
+
+// Card blue at idle through amber to red at saturation
+const QColor &levelColor(quint8 level)
+{
+    static QColor palette[LEVELS + 1];
+    static bool built = false;
+    if (!built) {
+        const QColor stops[] = { QColor(30, 60, 90), QColor(45, 166, 255), QColor(255, 176, 32), QColor(255, 64, 64) };
+        for (int i = 0; i < LEVELS; ++i) {
+            const double t = double(i) / (LEVELS - 1) * 3.0;
+            const int s = qMin(2, int(t));
+            const double f = t - s;
+            const QColor &a = stops[s];
+            const QColor &b = stops[s + 1];
+            palette[i] = QColor(int(a.red() + (b.red() - a.red()) * f),
+                                int(a.green() + (b.green() - a.green()) * f),
+                                int(a.blue() + (b.blue() - a.blue()) * f));
+        }
+        palette[LEVELS] = QColor(255, 255, 255, 25); // Offline / no data yet
+        built = true;
+    }
+    return palette[level < LEVELS ? level : LEVELS];
+}
+
+} // namespace
+
+CoreHeatStrip::CoreHeatStrip(QWidget *parent)
+    : QWidget(parent)
+    , m_columns(1)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+}
+
+void CoreHeatStrip::setCores(const float *utilization, const float *frequencyMHz, int count)
+{
+    count = qMax(0, count);
+    const bool relayout = count != m_levels.size();
+    if (relayout) {
+        m_levels.fill(UNKNOWN, count);
+        m_utilization.fill(NAN, count);
+        m_frequency.fill(NAN, count);
+    }
+
+    QRegion dirty;
+    for (int i = 0; i < count; ++i) {
+        const float value = utilization[i];
+        const quint8 level = std::isnan(value) ? UNKNOWN
+            : quint8(qBound(0, int(std::lround(value * (LEVELS - 1))), LEVELS - 1));
+        m_utilization[i] = value;
+        m_frequency[i] = frequencyMHz ? frequencyMHz[i] : NAN;
+        if (level != m_levels[i]) {
+            m_levels[i] = level;
+            if (!relayout) dirty += cellRect(i);
+        }
+    }
+
+    if (relayout) {
+        updateGeometry();
+        update();
+    } else if (!dirty.isEmpty()) {
+        update(dirty);
+    }
+}
+
+int CoreHeatStrip::columnsFor(int width) const
+{
+    return qMax(1, (width + GAP) / (CELL + GAP));
+}
+
+int CoreHeatStrip::heightForWidth(int width) const
+{
+    const int columns = columnsFor(width);
+    const int rows = (qMax(1, int(m_levels.size())) + columns - 1) / columns;
+    return rows * (CELL + GAP) - GAP;
+}
+
+QSize CoreHeatStrip::sizeHint() const
+{
+    // 32 cells per row keeps even 256 CPUs to eight rows
+    const int width = 32 * (CELL + GAP) - GAP;
+    return QSize(width, heightForWidth(width));
+}
+
+QSize CoreHeatStrip::minimumSizeHint() const
+{
+    return QSize(8 * (CELL + GAP) - GAP, CELL);
+}
+
+QRect CoreHeatStrip::cellRect(int index) const
+{
+    const int row = index / m_columns;
+    const int column = index % m_columns;
+    return QRect(column * (CELL + GAP), row * (CELL + GAP), CELL, CELL);
+}
+
+int CoreHeatStrip::cellAt(const QPoint &pos) const
+{
+    if (pos.x() < 0 || pos.y() < 0) return -1;
+    const int column = pos.x() / (CELL + GAP);
+    const int row = pos.y() / (CELL + GAP);
+    if (column >= m_columns) return -1;
+    const int index = row * m_columns + column;
+    return index < m_levels.size() && cellRect(index).contains(pos) ? index : -1;
+}
+
+void CoreHeatStrip::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_columns = columnsFor(width());
+}
+
+void CoreHeatStrip::paintEvent(QPaintEvent *event)
+{
+    if (m_levels.isEmpty()) return;
+
+    // Only the rows and columns the exposed area touches
+    const QRect area = event->rect();
+    const int firstRow = qMax(0, area.top() / (CELL + GAP));
+    const int lastRow = area.bottom() / (CELL + GAP);
+    const int firstColumn = qMax(0, area.left() / (CELL + GAP));
+    const int lastColumn = qMin(m_columns - 1, area.right() / (CELL + GAP));
+
+    QPainter painter(this);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const int index = row * m_columns + column;
+            if (index >= m_levels.size()) return;
+            // Qt has already repainted the panel behind the exposed area
+            painter.fillRect(cellRect(index), levelColor(m_levels[index]));
+        }
+    }
+}
+
+bool CoreHeatStrip::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        QHelpEvent *help = static_cast<QHelpEvent *>(event);
+        const int index = cellAt(help->pos());
+        if (index < 0) {
+            QToolTip::hideText();
+            event->ignore();
+            return true;
+        }
+
+        QString text = QString("CPU %1: ").arg(index);
+        text += std::isnan(m_utilization[index]) ? QString("--")
+                                                 : QString::number(int(std::lround(m_utilization[index] * 100.0f))) + "%";
+        if (!std::isnan(m_frequency[index])) {
+            text += QString(" @ %1 MHz").arg(int(m_frequency[index]));
+        }
+        QToolTip::showText(help->globalPos(), text, this, cellRect(index));
+        return true;
+    }
+    return QWidget::event(event);
+}
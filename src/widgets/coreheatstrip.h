@@ -0,0 +1,44 @@
+#ifndef COREHEATSTRIP_H
+#define COREHEATSTRIP_H
+
+#include <QWidget>
+#include <QVector>
+
+// One small cell per logical CPU, coloured by utilization. Only cells whose
+// colour step changed are repainted, so 256 CPUs cost a handful of fills per tick.
+class CoreHeatStrip : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CoreHeatStrip(QWidget *parent = nullptr);
+
+    // utilization 0-1 (NaN = offline/unknown), frequencyMHz may be null
+    void setCores(const float *utilization, const float *frequencyMHz, int count);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+    bool hasHeightForWidth() const override { return true; }
+    int heightForWidth(int width) const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    static constexpr int CELL = 9;
+    static constexpr int GAP = 2;
+    static constexpr quint8 UNKNOWN = 0xff;
+
+    int columnsFor(int width) const;
+    QRect cellRect(int index) const;
+    int cellAt(const QPoint &pos) const;
+
+    int m_columns;
+    QVector<quint8> m_levels;       // Utilization in 5% steps, UNKNOWN when NaN
+    QVector<float> m_utilization;   // Exact values for the tooltip
+    QVector<float> m_frequency;
+};
+
+#endif // COREHEATSTRIP_H
@@ -0,0 +1,289 @@
+#include "fancalibrationdialog.h"
+#include "usb/fan_actuator.h"
+#include "utils/qtdebugutil.h"
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDir>
+#include <QDoubleSpinBox>
+#include <QFile>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <cmath>
+
+FanCalibrationDialog::FanCalibrationDialog(int port, FanActuator *actuator, const FanModel &currentModel, QWidget *parent)
+    : QDialog(parent)
+    , m_port(port)
+    , m_actuator(actuator)
+    , m_currentModel(currentModel)
+    , m_stepIndex(-1)
+    , m_clearRequested(false)
+    , m_rpmUnread(false)
+{
+    // Start at full speed and walk down so the fan is already turning when it reaches the stall region
+    m_steps = {100, 90, 80, 70, 60, 50, 40, 30, 20, 10, 0};
+
+    m_settleTimer = new QTimer(this);
+    m_settleTimer->setSingleShot(true);
+    connect(m_settleTimer, &QTimer::timeout, this, &FanCalibrationDialog::onSettled);
+
+    setWindowTitle(QString("Calibrate Port %1").arg(port));
+    setupUI();
+    populateSources();
+}
+
+void FanCalibrationDialog::setupUI()
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setSpacing(10);
+
+    QLabel *intro = new QLabel(
+        "The fan will be driven through duty steps from 100% down to 0%. "
+        "At each step the speed is read from the selected source, or entered by hand "
+        "from a tachometer. Sound level readings are optional.");
+    intro->setWordWrap(true);
+    layout->addWidget(intro);
+
+    QFormLayout *form = new QFormLayout();
+    m_sourceCombo = new QComboBox();
+    form->addRow("Speed feedback:", m_sourceCombo);
+
+    m_settleSpin = new QSpinBox();
+    m_settleSpin->setRange(2, 30);
+    m_settleSpin->setValue(5);
+    m_settleSpin->setSuffix(" s");
+    form->addRow("Settle time per step:", m_settleSpin);
+
+    m_dbaCheck = new QCheckBox("Enter a sound level (dBA) at each step");
+    form->addRow("", m_dbaCheck);
+
+    m_rpmSpin = new QSpinBox();
+    m_rpmSpin->setRange(0, 5000);
+    m_rpmSpin->setSuffix(" RPM");
+    form->addRow("Measured speed:", m_rpmSpin);
+
+    m_dbaSpin = new QDoubleSpinBox();
+    m_dbaSpin->setRange(0.0, 100.0);
+    m_dbaSpin->setDecimals(1);
+    m_dbaSpin->setSuffix(" dBA");
+    m_dbaSpin->setSpecialValueText("not measured");
+    form->addRow("Measured sound level:", m_dbaSpin);
+    layout->addLayout(form);
+
+    m_statusLabel = new QLabel(m_currentModel.isCalibrated()
+        ? QString("Port %1 is calibrated (max %2 RPM).").arg(m_port).arg(m_currentModel.maxRPM())
+        : QString("Port %1 uses the stock model (max %2 RPM).").arg(m_port).arg(m_currentModel.maxRPM()));
+    m_statusLabel->setWordWrap(true);
+    layout->addWidget(m_statusLabel);
+
+    m_progress = new QProgressBar();
+    m_progress->setRange(0, m_steps.size());
+    m_progress->setValue(0);
+    layout->addWidget(m_progress);
+
+    m_resultTable = new QTableWidget(0, 3);
+    m_resultTable->setHorizontalHeaderLabels({"Duty", "RPM", "dBA"});
+    m_resultTable->verticalHeader()->setVisible(false);
+    m_resultTable->horizontalHeader()->setStretchLastSection(true);
+    m_resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultTable->setMinimumHeight(160);
+    layout->addWidget(m_resultTable);
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    m_startButton = new QPushButton("Start");
+    m_recordButton = new QPushButton("Record");
+    m_recordButton->setEnabled(false);
+    m_clearButton = new QPushButton("Reset to Stock");
+    m_clearButton->setEnabled(m_currentModel.isCalibrated());
+    m_saveButton = new QPushButton("Save");
+    m_saveButton->setEnabled(false);
+    QPushButton *cancelButton = new QPushButton("Cancel");
+
+    buttons->addWidget(m_startButton);
+    buttons->addWidget(m_recordButton);
+    buttons->addStretch();
+    buttons->addWidget(m_clearButton);
+    buttons->addWidget(m_saveButton);
+    buttons->addWidget(cancelButton);
+    layout->addLayout(buttons);
+
+    connect(m_startButton, &QPushButton::clicked, this, &FanCalibrationDialog::onStart);
+    connect(m_recordButton, &QPushButton::clicked, this, &FanCalibrationDialog::onRecord);
+    connect(m_clearButton, &QPushButton::clicked, this, &FanCalibrationDialog::onClear);
+    connect(m_saveButton, &QPushButton::clicked, this, &QDialog::accept);
+    connect(cancelButton, &QPushButton::clicked, this, &QDialog::reject);
+
+    resize(460, 520);
+}
+
+void FanCalibrationDialog::populateSources()
+{
+    m_sourceCombo->addItem("Manual entry", QString());
+
+    // Any tachometer the kernel exposes (motherboard headers, fan controllers)
+    QDir hwmonDir("/sys/class/hwmon");
+    for (const QString &hwmon : hwmonDir.entryList(QStringList() << "hwmon*", QDir::Dirs | QDir::System)) {
+        QString base = hwmonDir.absoluteFilePath(hwmon);
+        QString chip;
+        QFile nameFile(base + "/name");
+        if (nameFile.open(QIODevice::ReadOnly)) {
+            chip = QString::fromLatin1(nameFile.readAll()).trimmed();
+        }
+
+        QDir dir(base);
+        for (const QString &input : dir.entryList(QStringList() << "fan*_input", QDir::Files)) {
+            QString label = input.section('_', 0, 0);
+            QFile labelFile(base + "/" + label + "_label");
+            if (labelFile.open(QIODevice::ReadOnly)) {
+                label = QString::fromLatin1(labelFile.readAll()).trimmed();
+            }
+            m_sourceCombo->addItem(QString("%1 %2 (%3)").arg(chip, label, hwmon), base + "/" + input);
+        }
+    }
+}
+
+bool FanCalibrationDialog::usingManualSource() const
+{
+    return m_sourceCombo->currentData().toString().isEmpty();
+}
+
+double FanCalibrationDialog::readSourceRPM() const
+{
+    QFile file(m_sourceCombo->currentData().toString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return NAN;
+    }
+    bool ok = false;
+    double rpm = QString::fromLatin1(file.readAll()).trimmed().toDouble(&ok);
+    return ok ? rpm : NAN;
+}
+
+void FanCalibrationDialog::onStart()
+{
+    if (!m_actuator || !m_actuator->IsAvailable()) {
+        m_statusLabel->setText("Kernel driver not available - load the Lian_Li_SL_INFINITY module first.");
+        return;
+    }
+
+    m_samples.clear();
+    m_resultTable->setRowCount(0);
+    m_stepIndex = 0;
+    m_progress->setValue(0);
+    m_startButton->setEnabled(false);
+    m_saveButton->setEnabled(false);
+    m_sourceCombo->setEnabled(false);
+    m_settleSpin->setEnabled(false);
+    m_dbaCheck->setEnabled(false);
+    applyStep();
+}
+
+void FanCalibrationDialog::applyStep()
+{
+    int duty = m_steps[m_stepIndex];
+    m_actuator->SetDuty(m_port, duty, true);
+    m_recordButton->setEnabled(false);
+    m_statusLabel->setText(QString("Port %1 at %2% - waiting %3 s for the fan to settle...")
+                           .arg(m_port).arg(duty).arg(m_settleSpin->value()));
+    m_settleTimer->start(m_settleSpin->value() * 1000);
+}
+
+void FanCalibrationDialog::onSettled()
+{
+    int duty = m_steps[m_stepIndex];
+
+    m_rpmUnread = false;
+    if (!usingManualSource()) {
+        // A failed read is no reading, not 0 RPM; the fit ignores samples without a speed
+        double rpm = readSourceRPM();
+        m_rpmUnread = std::isnan(rpm);
+        m_rpmSpin->setValue(m_rpmUnread ? 0 : int(std::lround(rpm)));
+        m_rpmSpin->setEnabled(!m_rpmUnread);
+        if (!m_dbaCheck->isChecked()) {
+            onRecord();
+            return;
+        }
+    }
+
+    m_recordButton->setEnabled(true);
+    m_statusLabel->setText(m_rpmUnread
+                           ? QString("Port %1 at %2% - speed source unreadable; enter the noise level and press Record.").arg(m_port).arg(duty)
+                           : QString("Port %1 at %2% - enter the reading and press Record.").arg(m_port).arg(duty));
+}
+
+void FanCalibrationDialog::onRecord()
+{
+    if (m_stepIndex < 0 || m_stepIndex >= m_steps.size()) {
+        return;
+    }
+
+    FanCalibrationSample sample;
+    sample.duty = m_steps[m_stepIndex];
+    sample.rpm = m_rpmUnread ? NAN : m_rpmSpin->value();
+    sample.dba = m_dbaSpin->value() > 0.0 ? m_dbaSpin->value() : NAN;
+    m_samples.push_back(sample);
+
+    int row = m_resultTable->rowCount();
+    m_resultTable->insertRow(row);
+    m_resultTable->setItem(row, 0, new QTableWidgetItem(QString("%1%").arg(sample.duty)));
+    m_resultTable->setItem(row, 1, new QTableWidgetItem(std::isnan(sample.rpm) ? "-" : QString::number(sample.rpm, 'f', 0)));
+    m_resultTable->setItem(row, 2, new QTableWidgetItem(std::isnan(sample.dba) ? "-" : QString::number(sample.dba, 'f', 1)));
+
+    DEBUG_LOG_CATEGORY("FanSpeeds", "Calibration Port", m_port, "duty", sample.duty, "% ->", sample.rpm, "RPM", sample.dba, "dBA");
+
+    m_rpmUnread = false;
+    m_rpmSpin->setEnabled(true);
+    m_progress->setValue(++m_stepIndex);
+    if (m_stepIndex < m_steps.size()) {
+        applyStep();
+    } else {
+        finishSweep();
+    }
+}
+
+void FanCalibrationDialog::finishSweep()
+{
+    m_recordButton->setEnabled(false);
+    m_startButton->setEnabled(true);
+    m_startButton->setText("Restart");
+    m_sourceCombo->setEnabled(true);
+    m_settleSpin->setEnabled(true);
+    m_dbaCheck->setEnabled(true);
+
+    // fit() falls back to the stock model when the fan never turned or the top speed is
+    // implausible; saving that would clamp every target on this port to a stall
+    FanModel fitted = FanModel::fit(m_samples, FanModel::stock(m_currentModel.maxRPM()));
+    if (!fitted.isCalibrated()) {
+        m_statusLabel->setText("No usable speed readings were recorded (the fan never turned or the "
+                               "speed source failed) - nothing to save.");
+        return;
+    }
+
+    m_statusLabel->setText(QString("Fitted: %1 RPM at 100%, slowest running speed %2 RPM, %3 dBA at full speed. "
+                                   "Press Save to use this model for Port %4.")
+                           .arg(fitted.maxRPM()).arg(fitted.minRunningRPM())
+                           .arg(fitted.estimateDBA(fitted.maxRPM()), 0, 'f', 1).arg(m_port));
+    m_saveButton->setEnabled(true);
+}
+
+void FanCalibrationDialog::onClear()
+{
+    m_settleTimer->stop();
+    m_samples.clear();
+    m_clearRequested = true;
+    accept();
+}
+
+void FanCalibrationDialog::done(int result)
+{
+    // Stop the sweep; the caller hands the port back to the fan controller
+    m_settleTimer->stop();
+    m_stepIndex = -1;
+    QDialog::done(result);
+}
@@ -0,0 +1,77 @@
+#ifndef FANCALIBRATIONDIALOG_H
+#define FANCALIBRATIONDIALOG_H
+
+#include <QDialog>
+#include <QVector>
+#include <vector>
+#include "control/fanmodel.h"
+
+class QComboBox;
+class QSpinBox;
+class QDoubleSpinBox;
+class QCheckBox;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTableWidget;
+class QTimer;
+class FanActuator;
+
+// Sweeps one port through duty steps and records the fan's response, either from a
+// hwmon tachometer input or from readings the user types in (RPM from a tachometer,
+// dBA from a sound meter). The caller fits a FanModel from samples() on accept.
+class FanCalibrationDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    FanCalibrationDialog(int port, FanActuator *actuator, const FanModel &currentModel, QWidget *parent = nullptr);
+
+    std::vector<FanCalibrationSample> samples() const { return m_samples; }
+
+    // True if the user asked to drop the port's calibration and go back to the stock model
+    bool clearRequested() const { return m_clearRequested; }
+
+protected:
+    void done(int result) override;
+
+private slots:
+    void onStart();
+    void onSettled();
+    void onRecord();
+    void onClear();
+
+private:
+    void setupUI();
+    void populateSources();
+    void applyStep();
+    void finishSweep();
+    double readSourceRPM() const;
+    bool usingManualSource() const;
+
+    int m_port;
+    FanActuator *m_actuator;
+    FanModel m_currentModel;
+
+    QComboBox *m_sourceCombo;
+    QSpinBox *m_settleSpin;
+    QCheckBox *m_dbaCheck;
+    QLabel *m_statusLabel;
+    QProgressBar *m_progress;
+    QSpinBox *m_rpmSpin;
+    QDoubleSpinBox *m_dbaSpin;
+    QPushButton *m_startButton;
+    QPushButton *m_recordButton;
+    QPushButton *m_clearButton;
+    QPushButton *m_saveButton;
+    QTableWidget *m_resultTable;
+    QTimer *m_settleTimer;
+
+    QVector<int> m_steps;
+    int m_stepIndex;
+    std::vector<FanCalibrationSample> m_samples;
+    bool m_clearRequested;
+    bool m_rpmUnread;
+};
+
+#endif // FANCALIBRATIONDIALOG_H
@@ -4,6 +4,7 @@
 #include <QMouseEvent>
 #include <QFont>
 #include <QFontMetrics>
+#include <QPaintEvent>
 #include <cmath>
 
 FanCurveWidget::FanCurveWidget(QWidget *parent)
@@ -23,6 +24,7 @@ FanCurveWidget::FanCurveWidget(QWidget *parent)
     , m_dragging(false)
     , m_draggedPoint(-1)
     , m_graphEnabled(true)
+    , m_staticDirty(true)
     , m_backgroundColor(QColor(26, 26, 26))
     , m_gridColor(QColor(60, 60, 60))
     , m_axisColor(QColor(200, 200, 200))
@@ -31,48 +33,86 @@ FanCurveWidget::FanCurveWidget(QWidget *parent)
     , m_currentLineColor(QColor(0, 255, 0))
 {
     setMinimumSize(400, 200);
+    // Every paint covers its whole region from the cached layer
+    setAttribute(Qt::WA_OpaquePaintEvent);
     setupCurveData();
 }
 
 void FanCurveWidget::setFanSize(int maxRPM)
 {
+    if (maxRPM == m_displayRpmMax) {
+        return;
+    }
+    
     // Only change the display labels, not the actual curve scaling
     m_displayRpmMax = maxRPM;
     // Keep m_rpmMax at 2100 so curves don't move
-    update();
+    invalidateStaticLayer();
 }
 
 void FanCurveWidget::setProfile(const QString &profile)
 {
     m_profile = profile;
     setupCurveData();
-    update();
+    invalidateStaticLayer();
 }
 
 void FanCurveWidget::setCurrentTemperature(int temperature)
 {
+    if (temperature == m_currentTemperature) {
+        return;
+    }
+    
+    // Repaint where the cursor was and where it goes; the rest comes from the cache
+    QRect oldCursor = cursorRect(m_currentTemperature);
     m_currentTemperature = temperature;
-    update();
+    update(oldCursor.united(cursorRect(m_currentTemperature)));
 }
 
 void FanCurveWidget::setCurrentRPM(int rpm)
 {
+    // Kept for callers; the graph only draws the curve's RPM at the cursor
     m_currentRPM = rpm;
-    update();
 }
 
 void FanCurveWidget::setGraphEnabled(bool enabled)
 {
-    m_graphEnabled = enabled;
-    update();
+    if (enabled != m_graphEnabled) {
+        m_graphEnabled = enabled;
+        invalidateStaticLayer();
+    }
 }
 
 void FanCurveWidget::setCustomCurve(const QVector<QPointF> &points)
 {
-    m_curvePoints = points;
+    if (points != m_curvePoints) {
+        m_curvePoints = points;
+        invalidateStaticLayer();
+    }
+}
+
+void FanCurveWidget::invalidateStaticLayer()
+{
+    m_staticDirty = true;
     update();
 }
 
+void FanCurveWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_staticDirty = true;
+}
+
+QRect FanCurveWidget::cursorRect(int temperature)
+{
+    QRect graphRect = rect().adjusted(m_marginLeft, m_marginTop, -m_marginRight, -m_marginBottom);
+    int x = graphRect.left() + (temperature - m_tempMin) / (m_tempMax - m_tempMin) * graphRect.width();
+    
+    // Line from top to bottom plus the 7px ball (with its 2px pen) anywhere along it
+    const int reach = 10;
+    return QRect(x - reach, graphRect.top() - reach, reach * 2 + 1, graphRect.height() + reach * 2 + 1);
+}
+
 void FanCurveWidget::setupCurveData()
 {
     m_curvePoints.clear();
@@ -125,11 +165,13 @@ void FanCurveWidget::setupCurveData()
     }
 }
 
-void FanCurveWidget::paintEvent(QPaintEvent *event)
+void FanCurveWidget::renderStaticLayer()
 {
-    Q_UNUSED(event)
+    const qreal dpr = devicePixelRatioF();
+    m_staticLayer = QPixmap(size() * dpr);
+    m_staticLayer.setDevicePixelRatio(dpr);
     
-    QPainter painter(this);
+    QPainter painter(&m_staticLayer);
     painter.setRenderHint(QPainter::Antialiasing);
     
     // Fill background
@@ -140,9 +182,6 @@ void FanCurveWidget::paintEvent(QPaintEvent *event)
         painter.setOpacity(0.3);
     }
     
-    // Calculate graph area
-    QRect graphRect = rect().adjusted(m_marginLeft, m_marginTop, -m_marginRight, -m_marginBottom);
-    
     // Draw grid
     drawGrid(painter);
     
@@ -155,9 +194,31 @@ void FanCurveWidget::paintEvent(QPaintEvent *event)
     // Draw data points
     drawDataPoints(painter);
     
+    m_staticDirty = false;
+}
+
+void FanCurveWidget::paintEvent(QPaintEvent *event)
+{
+    if (m_staticDirty || m_staticLayer.devicePixelRatio() != devicePixelRatioF()) {
+        renderStaticLayer();
+    }
+    
+    QPainter painter(this);
+    
+    // Blit only the damaged part of the cached layers
+    const qreal dpr = m_staticLayer.devicePixelRatio();
+    for (const QRect &rect : event->region()) {
+        painter.drawPixmap(QRectF(rect), m_staticLayer,
+                           QRectF(rect.x() * dpr, rect.y() * dpr, rect.width() * dpr, rect.height() * dpr));
+    }
+    
+    painter.setRenderHint(QPainter::Antialiasing);
+    if (!m_graphEnabled) {
+        painter.setOpacity(0.3);
+    }
+    
     // Draw current temperature line
     drawCurrentLine(painter);
-    
 }
 
 void FanCurveWidget::drawGrid(QPainter &painter)
@@ -382,7 +443,7 @@ void FanCurveWidget::mouseMoveEvent(QMouseEvent *event)
         dataPoint.setY(qMax(minRPM, qMin((double)m_rpmMax, dataPoint.y())));
         
         m_curvePoints[m_draggedPoint] = dataPoint;
-        update();
+        invalidateStaticLayer();
     }
 }
 
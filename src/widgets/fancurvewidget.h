@@ -6,6 +6,7 @@
 #include <QMouseEvent>
 #include <QVector>
 #include <QPointF>
+#include <QPixmap>
 
 class FanCurveWidget : public QWidget
 {
@@ -27,12 +28,16 @@ signals:
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
 
 private:
     void setupCurveData();
+    void invalidateStaticLayer();
+    void renderStaticLayer();
+    QRect cursorRect(int temperature);
     void drawGrid(QPainter &painter);
     void drawAxes(QPainter &painter);
     void drawCurve(QPainter &painter);
@@ -68,6 +73,11 @@ private:
     // Graph state
     bool m_graphEnabled;
     
+    // Background, grid, axes, labels, curve and points at device resolution;
+    // only the current-temperature cursor is painted on top per update
+    QPixmap m_staticLayer;
+    bool m_staticDirty;
+    
     // Colors
     QColor m_backgroundColor;
     QColor m_gridColor;
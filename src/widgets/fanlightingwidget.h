@@ -6,14 +6,23 @@
 #include <QPainter>
 #include <QColor>
 #include <QString>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include "lighting/effectrenderer.h"
 
+// Preview of the four fans' LED rings. Each frame is rendered by EffectRenderer
+// into the same LedFrame the hub takes, and the preview draws each LED of a
+// port's first fan as a dot, so what it shows is exactly the bytes the hardware
+// would get. The frames, blades and labels are drawn once into a pixmap (rebuilt
+// on resize, device pixel ratio or port changes); a frame only repaints the rings,
+// and only when the rendered bytes changed.
 class FanLightingWidget : public QWidget
 {
     Q_OBJECT
 
 public:
     explicit FanLightingWidget(QWidget *parent = nullptr);
-    
+
     void setEffect(const QString &effect);
     void setSpeed(int speedPercent);
     void setBrightness(int brightnessPercent);
@@ -22,43 +31,44 @@ public:
     void setPortColors(const QColor colors[4]);
     void setPortEnabled(const bool enabled[4]);
 
+    // The latest frame, all 8 channels
+    const LedFrame &frame() const { return m_frame; }
+
+signals:
+    // Emitted when a render changed the frame; connect to
+    // LianLiQtIntegration::streamFrame to drive the hub from the same render
+    void frameRendered(const LedFrame &frame);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
 private slots:
     void updateAnimation();
 
 private:
-    void drawFan(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRainbowEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRainbowMorphEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStaticColorEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawBreathingEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawMeteorEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawRunwayEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawGrooveEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawMixingEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawNeonEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStackEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawStaggeredEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawTideEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawTunnelEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    void drawVoiceEffect(QPainter &painter, const QRect &rect, int fanIndex);
-    
-    QColor getRainbowColor(int position, int totalPositions) const;
-    QColor applyBrightness(const QColor &color, int brightnessPercent) const;
-    
-    QString m_effect;
-    int m_speed;
-    int m_brightness;
-    bool m_directionLeft;
-    QColor m_color;
-    QColor m_portColors[4]; // Colors for each port
+    void renderFrame();
+    void updateLayout();
+    void renderBackground();
+
+    EffectRenderer m_renderer;
+    LedFrame m_frame;
     bool m_portEnabled[4];  // Which ports have fans connected
-    
+
+    // Geometry, recomputed on resize: ring centres, the LED dots around the
+    // origin (all four fans share a size) and the region the rings cover
+    QPointF m_ringCenters[4];
+    QPointF m_dotOffsets[LedFrame::LEDS_PER_FAN];
+    qreal m_dotRadius;
+    qreal m_ringRadius;
+    QRegion m_ringRegion;
+
+    // Static artwork at device resolution
+    QPixmap m_background;
+    bool m_backgroundDirty;
+
     QTimer *m_animationTimer;
-    int m_animationFrame;
-    double m_timeOffset;
+    QElapsedTimer m_clock;
 };
 
 #endif // FANLIGHTINGWIDGET_H
@@ -0,0 +1,113 @@
+#include "fantablemodel.h"
+
+FanTableModel::FanTableModel(int ports, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_rows(ports)
+{
+    for (FanTableRow &row : m_rows) {
+        row.profile = "Quiet";
+    }
+}
+
+void FanTableModel::setRow(int row, const FanTableRow &values)
+{
+    if (row < 0 || row >= m_rows.size()) {
+        return;
+    }
+    
+    FanTableRow &current = m_rows[row];
+    if (values.profile != current.profile) {
+        current.profile = values.profile;
+        changed(row, ProfileColumn);
+    }
+    if (values.temperature != current.temperature) {
+        // The colour band only moves with the text, so one signal covers both roles
+        current.temperature = values.temperature;
+        changed(row, TemperatureColumn);
+    }
+    if (values.rpm != current.rpm) {
+        current.rpm = values.rpm;
+        changed(row, RpmColumn);
+    }
+}
+
+void FanTableModel::changed(int row, int column)
+{
+    const QModelIndex cell = index(row, column);
+    emit dataChanged(cell, cell, { Qt::DisplayRole, Qt::ForegroundRole });
+}
+
+int FanTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int FanTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FanTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+    
+    const FanTableRow &row = m_rows[index.row()];
+    const int port = index.row() + 1;
+    
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case NumberColumn: return QString::number(port);
+        case PortColumn: return QString("Port %1").arg(port);
+        case ProfileColumn: return row.profile;
+        case TemperatureColumn: return QString("%1°C").arg(row.temperature);
+        case RpmColumn: return QString("%1 RPM").arg(row.rpm);
+        default: return QVariant();
+        }
+    }
+    
+    if (role == Qt::ForegroundRole) {
+        if (index.column() == TemperatureColumn) {
+            return temperatureColor(row.temperature);
+        }
+        if (index.column() == RpmColumn) {
+            return QColor(255, 165, 0); // Orange
+        }
+    }
+    
+    return QVariant();
+}
+
+QVariant FanTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    
+    static const char *const HEADERS[ColumnCount] = { "#", "Port", "Profile", "Temperature", "Fan RPMs", "Size" };
+    return section >= 0 && section < ColumnCount ? QString(HEADERS[section]) : QVariant();
+}
+
+Qt::ItemFlags FanTableModel::flags(const QModelIndex &index) const
+{
+    // Read-only; rows are selectable to pick the port the curve editor shows
+    return index.isValid() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable : Qt::NoItemFlags;
+}
+
+QColor FanTableModel::temperatureColor(int temperature)
+{
+    if (temperature <= 41) {
+        // 0-41°C: Blue (cool)
+        return QColor(0, 150, 255);
+    } else if (temperature <= 60) {
+        // 42-60°C: Green (normal)
+        return QColor(0, 255, 0);
+    } else if (temperature <= 76) {
+        // 61-76°C: Yellow (warm)
+        return QColor(255, 255, 0);
+    } else {
+        // 77-100°C: Red (hot)
+        return QColor(255, 0, 0);
+    }
+}
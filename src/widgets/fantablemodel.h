@@ -0,0 +1,53 @@
+#ifndef FANTABLEMODEL_H
+#define FANTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QVector>
+
+// What the fan table shows for one port
+struct FanTableRow
+{
+    QString profile;
+    int temperature = 0;    // °C
+    int rpm = 0;
+};
+
+// Fan table backing store: one row per port, updated in place. setRow() only emits
+// dataChanged for cells whose shown value actually changed, so a steady system
+// costs the view nothing between refreshes.
+class FanTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        NumberColumn,
+        PortColumn,
+        ProfileColumn,
+        TemperatureColumn,
+        RpmColumn,
+        SizeColumn,         // Holds an index widget (size combo box)
+        ColumnCount
+    };
+
+    explicit FanTableModel(int ports, QObject *parent = nullptr);
+
+    void setRow(int row, const FanTableRow &values);
+    const FanTableRow &row(int row) const { return m_rows[row]; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    static QColor temperatureColor(int temperature);
+
+private:
+    void changed(int row, int column);
+
+    QVector<FanTableRow> m_rows;
+};
+
+#endif // FANTABLEMODEL_H
@@ -5,6 +5,7 @@
 #include <QFontMetrics>
 #include <QSizePolicy>
 #include <QtGlobal>
+#include <QtMath>
 
 MonitoringCard::MonitoringCard(CardType type, const QString &title, QWidget *parent)
     : QFrame(parent)
@@ -20,6 +21,9 @@ MonitoringCard::MonitoringCard(CardType type, const QString &title, QWidget *par
     , m_cardColor(QColor(45, 166, 255))
     , m_progressValue(0.0)
     , m_progressAnimation(nullptr)
+    , m_progressTarget(-1.0)
+    , m_cachedDpr(0.0)
+    , m_strokeWidth(0.0)
 {
     setupUI();
     m_titleLabel->setText(title);
@@ -249,24 +253,38 @@ void MonitoringCard::setupUI()
 
 void MonitoringCard::setValue(const QString &value)
 {
+    // Pages push every reading once a second; most don't change the text
+    if (value == m_valueText) {
+        return;
+    }
     m_valueText = value;
     m_valueLabel->setText(value);
     if (m_type == CircularProgress) {
-        update();
+        update(textDirtyRect());
     }
 }
 
 void MonitoringCard::setSubValue(const QString &subValue)
 {
+    if (subValue == m_subValueText) {
+        return;
+    }
     m_subValueText = subValue;
     m_subValueLabel->setText(subValue);
     if (m_type == CircularProgress) {
-        update();
+        update(textDirtyRect());
     }
 }
 
 void MonitoringCard::setProgress(int percentage)
 {
+    // Same target as the running or finished animation: nothing to do
+    qreal target = qBound(0, percentage, 100);
+    if (target == m_progressTarget) {
+        return;
+    }
+    m_progressTarget = target;
+
     if (m_progressAnimation) {
         m_progressAnimation->stop();
         m_progressAnimation->setStartValue(m_progressValue);
@@ -348,11 +366,110 @@ void MonitoringCard::setCircularSize(int widgetSize, int canvasSize)
 
 void MonitoringCard::setProgressValue(qreal value)
 {
+    qreal previous = m_progressValue;
     m_progressValue = qBound<qreal>(0.0, value, 100.0);
     if (m_progressBar) {
+        // The bar repaints itself
         m_progressBar->setValue(static_cast<int>(m_progressValue));
     }
-    update();
+    if (m_type == CircularProgress && m_progressValue != previous) {
+        update(ringDirtyRect(previous, m_progressValue));
+    }
+}
+
+bool MonitoringCard::updateRingCache()
+{
+    qreal devicePixelRatio = devicePixelRatioF();
+    QRectF canvasRect = QRectF(m_progressCanvas->pos(), QSizeF(m_progressCanvas->width(), m_progressCanvas->height()));
+    if (canvasRect.width() < 1.0 || canvasRect.height() < 1.0)
+        return false;
+
+    if (canvasRect == m_cachedCanvas && devicePixelRatio == m_cachedDpr && !m_ringCache.isNull()
+        && m_ringCache.size() == size() * devicePixelRatio)
+        return true;
+
+    qreal diameter = qMin(canvasRect.width(), canvasRect.height());
+    qreal padding = qMax<qreal>(12.0, diameter * 0.08);
+    diameter = qMax<qreal>(0.0, diameter - padding * 2.0);
+    if (diameter <= 0.0)
+        return false;
+
+    QPointF center = canvasRect.center();
+    QRectF baseRect(center.x() - diameter / 2.0,
+                    center.y() - diameter / 2.0,
+                    diameter,
+                    diameter);
+
+    m_strokeWidth = qBound<qreal>(3.0, diameter * 0.02, diameter * 0.04);
+    m_ringRect = baseRect.adjusted(m_strokeWidth / 2.0,
+                                   m_strokeWidth / 2.0,
+                                   -m_strokeWidth / 2.0,
+                                   -m_strokeWidth / 2.0);
+    m_innerRect = m_ringRect.adjusted(m_strokeWidth * 0.6,
+                                      m_strokeWidth * 0.6,
+                                      -m_strokeWidth * 0.6,
+                                      -m_strokeWidth * 0.6);
+
+    // Track ring and inner fill, drawn the way paintEvent draws the rest
+    m_ringCache = QPixmap(size() * devicePixelRatio);
+    m_ringCache.setDevicePixelRatio(devicePixelRatio);
+    m_ringCache.fill(Qt::transparent);
+
+    QPainter painter(&m_ringCache);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(1.0 / devicePixelRatio, 1.0 / devicePixelRatio);
+
+    painter.setPen(QPen(QColor(26, 45, 86, 220), m_strokeWidth, Qt::SolidLine, Qt::RoundCap));
+    painter.drawArc(m_ringRect, 0, 360 * 16);
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(7, 15, 36, 230));
+    painter.drawEllipse(m_innerRect);
+
+    m_cachedCanvas = canvasRect;
+    m_cachedDpr = devicePixelRatio;
+    return true;
+}
+
+QRect MonitoringCard::ringDirtyRect(qreal fromValue, qreal toValue) const
+{
+    if (m_ringCache.isNull() || m_cachedDpr <= 0.0) {
+        return rect();
+    }
+
+    // Bounding box of the arc between the two values: its end points plus any
+    // of the four extremes the sweep passes (angles clockwise from 12 o'clock)
+    qreal from = qMin(fromValue, toValue) * 3.6;
+    qreal to = qMax(fromValue, toValue) * 3.6;
+    QPointF center = m_ringRect.center();
+    qreal radius = m_ringRect.width() / 2.0;
+    auto pointAt = [&](qreal degrees) {
+        qreal radians = qDegreesToRadians(degrees);
+        return QPointF(center.x() + radius * qSin(radians), center.y() - radius * qCos(radians));
+    };
+
+    QRectF bounds(pointAt(from), QSizeF(0, 0));
+    bounds = bounds.united(QRectF(pointAt(to), QSizeF(0, 0)));
+    for (qreal extreme = 90.0; extreme < to; extreme += 90.0) {
+        if (extreme > from) {
+            bounds = bounds.united(QRectF(pointAt(extreme), QSizeF(0, 0)));
+        }
+    }
+
+    // Round caps reach half a stroke past the ends; painter units to widget pixels
+    qreal margin = m_strokeWidth / 2.0 + 1.0;
+    bounds.adjust(-margin, -margin, margin, margin);
+    QRectF widgetBounds(bounds.topLeft() / m_cachedDpr, bounds.size() / m_cachedDpr);
+    return widgetBounds.toAlignedRect().adjusted(-1, -1, 1, 1);
+}
+
+QRect MonitoringCard::textDirtyRect() const
+{
+    if (m_ringCache.isNull() || m_cachedDpr <= 0.0) {
+        return rect();
+    }
+    QRectF widgetBounds(m_innerRect.topLeft() / m_cachedDpr, m_innerRect.size() / m_cachedDpr);
+    return widgetBounds.toAlignedRect().adjusted(-1, -1, 1, 1);
 }
 
 void MonitoringCard::paintEvent(QPaintEvent *event)
@@ -360,59 +477,27 @@ void MonitoringCard::paintEvent(QPaintEvent *event)
     QFrame::paintEvent(event);
     
     if (m_type == CircularProgress && m_progressCanvas) {
+        if (!updateRingCache())
+            return;
+
         QPainter painter(this);
+        painter.drawPixmap(0, 0, m_ringCache);
+
         painter.setRenderHint(QPainter::Antialiasing);
         painter.setRenderHint(QPainter::SmoothPixmapTransform);
         
         // Handle High DPI scaling
-        qreal devicePixelRatio = painter.device()->devicePixelRatioF();
+        qreal devicePixelRatio = m_cachedDpr;
         painter.scale(1.0 / devicePixelRatio, 1.0 / devicePixelRatio);
-        
-        QRectF canvasRect = QRectF(m_progressCanvas->pos(), QSizeF(m_progressCanvas->width(), m_progressCanvas->height()));
-        if (canvasRect.width() < 1.0 || canvasRect.height() < 1.0)
-            return;
-
-        qreal diameter = qMin(canvasRect.width(), canvasRect.height());
-        if (diameter <= 0.0)
-            return;
-
-        qreal padding = qMax<qreal>(12.0, diameter * 0.08);
-        diameter = qMax<qreal>(0.0, diameter - padding * 2.0);
-        if (diameter <= 0.0)
-            return;
-
-        QPointF center = canvasRect.center();
-        QRectF baseRect(center.x() - diameter / 2.0,
-                        center.y() - diameter / 2.0,
-                        diameter,
-                        diameter);
-
-        qreal strokeWidth = qBound<qreal>(3.0, diameter * 0.02, diameter * 0.04);
-        QRectF ringRect = baseRect.adjusted(strokeWidth / 2.0,
-                                            strokeWidth / 2.0,
-                                            -strokeWidth / 2.0,
-                                            -strokeWidth / 2.0);
-
-        // Background ring
-        painter.setPen(QPen(QColor(26, 45, 86, 220), strokeWidth, Qt::SolidLine, Qt::RoundCap));
-        painter.drawArc(ringRect, 0, 360 * 16);
 
         // Progress arc
-        painter.setPen(QPen(m_cardColor, strokeWidth, Qt::SolidLine, Qt::RoundCap));
+        painter.setPen(QPen(m_cardColor, m_strokeWidth, Qt::SolidLine, Qt::RoundCap));
         int startAngle = 90 * 16;
         int spanAngle = static_cast<int>(-m_progressValue * 3.6 * 16);
-        painter.drawArc(ringRect, startAngle, spanAngle);
-
-        // Inner fill
-        QRectF innerRect = ringRect.adjusted(strokeWidth * 0.6,
-                                             strokeWidth * 0.6,
-                                             -strokeWidth * 0.6,
-                                             -strokeWidth * 0.6);
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(QColor(7, 15, 36, 230));
-        painter.drawEllipse(innerRect);
+        painter.drawArc(m_ringRect, startAngle, spanAngle);
 
         // Value text - scaled down for High DPI
+        QRectF innerRect = m_innerRect;
         QString valueText = m_valueText.isEmpty() ? QStringLiteral("--") : m_valueText;
         painter.setPen(Qt::white);
         QFont valueFont = painter.font();
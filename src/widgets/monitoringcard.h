@@ -8,6 +8,7 @@
 #include <QFrame>
 #include <QProgressBar>
 #include <QPropertyAnimation>
+#include <QPixmap>
 
 class MonitoringCard : public QFrame
 {
@@ -40,6 +41,13 @@ protected:
 
 private:
     void setupUI();
+
+    // Circular progress: ring geometry and the static track/inner fill layer,
+    // rebuilt when the canvas moves or resizes or the device pixel ratio changes
+    bool updateRingCache();
+    QRect ringDirtyRect(qreal fromValue, qreal toValue) const;
+    QRect textDirtyRect() const;
+
     CardType m_type;
     QVBoxLayout *m_layout;
     QHBoxLayout *m_headerLayout;
@@ -54,8 +62,16 @@ private:
     QColor m_cardColor;
     qreal m_progressValue;
     QPropertyAnimation *m_progressAnimation;
+    qreal m_progressTarget;
     QString m_valueText;
     QString m_subValueText;
+
+    QPixmap m_ringCache;
+    QRectF m_cachedCanvas;
+    qreal m_cachedDpr;
+    QRectF m_ringRect;      // In painter units (1/dpr of a widget pixel)
+    QRectF m_innerRect;
+    qreal m_strokeWidth;
 };
 
 #endif // MONITORINGCARD_H
@@ -0,0 +1,635 @@
+/*---------------------------------------------------------*\
+||| fansim.cpp                                              |
+|||                                                         |
+|||   Offline fan-control simulator                        |
+|||   Replays a recorded or synthetic load trace through   |
+|||   the production controllers against a thermal model, |
+|||   faster than real time, and reports overshoot,        |
+|||   time above target, write rate and estimated noise.   |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "thermalplant.h"
+#include "control/acousticcontroller.h"
+#include "control/fancontroller.h"
+#include "control/fancurve.h"
+#include "control/fanmodel.h"
+#include "control/zerorpm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct SimOptions {
+    std::string tracePath;
+    std::string scenario = "compile";
+    std::string profile = "Quiet";
+    bool acoustic = false;          // --mode acoustic: AcousticController instead of the curve
+    double weights[FanController::PORT_COUNT] = { 1.0, 1.0, 1.0, 1.0 };
+    ZeroRpmParams zeroRpm;          // --zero-rpm STOP,START applies to every port
+    std::string dumpPath;
+    double duration = 0.0;          // 0 = length of the trace
+    double controlPeriod = 0.05;    // s, FanProfilePage runs the loop every 50 ms
+    double sensorPeriod = 0.5;      // s, temperature refresh interval
+    double loadPeriod = 0.25;       // s, LoadSampler interval; 0 = no load feedforward
+    double target = 75.0;           // °C, ceiling for overshoot / time-above metrics
+    int minIntervalMs = 200;        // FanActuator per-port minimum write interval
+    bool csv = false;
+};
+
+struct SimMetrics {
+    double peakTemp = 0.0;
+    double overshoot = 0.0;
+    double timeAbove = 0.0;
+    double excess = 0.0;            // °C·s above the target
+    double writesPerMin = 0.0;      // Driver writes after quantization and rate limiting
+    double callsPerMin = 0.0;       // setFanSpeed calls from the controller
+    double meanDBA = 0.0;           // Energy average of all fans combined
+    double peakDBA = 0.0;
+};
+
+struct Variant {
+    std::string label;
+    FanControllerParams params;
+};
+
+/*---------------------------------------------------------*\
+| Tunable parameters reachable from the command line        |
+\*---------------------------------------------------------*/
+
+struct ParamField {
+    const char* name;
+    double FanControllerParams::* d;
+    int FanControllerParams::* i;
+};
+
+const ParamField PARAM_FIELDS[] = {
+    { "alphaHeating",     &FanControllerParams::alphaHeating,     nullptr },
+    { "alphaCooling",     &FanControllerParams::alphaCooling,     nullptr },
+    { "historySeconds",   &FanControllerParams::historySeconds,   nullptr },
+    { "maxRate",          &FanControllerParams::maxRate,          nullptr },
+    { "heatingRate",      &FanControllerParams::heatingRate,      nullptr },
+    { "lookAheadSeconds", &FanControllerParams::lookAheadSeconds, nullptr },
+    { "feedForwardGain",  &FanControllerParams::feedForwardGain,  nullptr },
+    { "boostRate",        &FanControllerParams::boostRate,        nullptr },
+    { "boostRPM",         nullptr, &FanControllerParams::boostRPM },
+    { "loadFastSeconds",  &FanControllerParams::loadFastSeconds,  nullptr },
+    { "loadSlowSeconds",  &FanControllerParams::loadSlowSeconds,  nullptr },
+    { "loadGain",         &FanControllerParams::loadGain,         nullptr },
+    { "loadDeadband",     &FanControllerParams::loadDeadband,     nullptr },
+    { "loadMaxRPM",       nullptr, &FanControllerParams::loadMaxRPM },
+    { "utilizationWatts", &FanControllerParams::utilizationWatts, nullptr },
+    { "upSlew",           &FanControllerParams::upSlew,           nullptr },
+    { "downSlew",         &FanControllerParams::downSlew,         nullptr },
+    { "hotThreshold",     &FanControllerParams::hotThreshold,     nullptr },
+    { "hotUpSlew",        &FanControllerParams::hotUpSlew,        nullptr },
+    { "hotDownSlew",      &FanControllerParams::hotDownSlew,      nullptr },
+    { "writeThreshold",   nullptr, &FanControllerParams::writeThreshold },
+    { "maxRPM",           nullptr, &FanControllerParams::maxRPM },
+};
+
+const ParamField* findParam(const std::string& name) {
+    for (const ParamField& field : PARAM_FIELDS) {
+        if (name == field.name) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+void setParam(FanControllerParams& params, const ParamField& field, double value) {
+    if (field.d) {
+        params.*(field.d) = value;
+    } else {
+        params.*(field.i) = static_cast<int>(std::lround(value));
+    }
+}
+
+// "a,b,c" or "start:stop:step"
+std::vector<double> parseValues(const std::string& text) {
+    std::vector<double> values;
+    if (std::count(text.begin(), text.end(), ':') == 2) {
+        double start = 0, stop = 0, step = 0;
+        if (std::sscanf(text.c_str(), "%lf:%lf:%lf", &start, &stop, &step) == 3 && step > 0) {
+            for (double v = start; v <= stop + step * 1e-6; v += step) {
+                values.push_back(v);
+            }
+        }
+        return values;
+    }
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::atof(item.c_str()));
+        }
+    }
+    return values;
+}
+
+/*---------------------------------------------------------*\
+| Load traces                                               |
+\*---------------------------------------------------------*/
+
+// Heat input per control step. Synthetic scenarios are described in watts directly.
+std::vector<double> syntheticPower(const std::string& scenario, double period, double& duration) {
+    const double idle = 15.0;
+    double length = 600.0;
+    if (scenario == "compile") length = 500.0;
+    if (duration <= 0.0) duration = length;
+
+    size_t steps = static_cast<size_t>(duration / period);
+    std::vector<double> power(steps, idle);
+
+    for (size_t i = 0; i < steps; ++i) {
+        double t = i * period;
+        if (scenario == "idle") {
+            power[i] = idle;
+        } else if (scenario == "compile") {
+            // Idle, then a long all-core build, then idle again
+            power[i] = (t >= 60.0 && t < 300.0) ? 130.0 : idle;
+        } else if (scenario == "burst") {
+            // Short 8 s spikes every 30 s (tab switches, shader compiles)
+            power[i] = (std::fmod(t, 30.0) < 8.0) ? 110.0 : idle;
+        } else if (scenario == "gaming") {
+            // Sustained mid load with a slow wobble and periodic loading spikes
+            power[i] = 70.0 + 20.0 * std::sin(t * 2.0 * M_PI / 20.0);
+            if (std::fmod(t, 120.0) < 5.0) power[i] += 50.0;
+        } else if (scenario == "render") {
+            // 90 W render jobs of 60 s with 60 s idle in between - within the cooler's
+            // capacity, so any overshoot comes from the fans reacting late
+            power[i] = (std::fmod(t, 120.0) >= 30.0 && std::fmod(t, 120.0) < 90.0) ? 90.0 : idle;
+        } else if (scenario == "step") {
+            power[i] = (t >= 30.0 && t < 330.0) ? 150.0 : idle;
+        } else {
+            std::fprintf(stderr, "Unknown scenario '%s'\n", scenario.c_str());
+            return {};
+        }
+    }
+    return power;
+}
+
+std::string lowerCase(std::string text) {
+    for (char& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return text;
+}
+
+// CSV with a header row. Recognised columns: time/time_s/t, temp/temp_c/temperature,
+// power/power_w, rpm/fan_rpm. With a power column the trace is used as-is; otherwise
+// the heat input is inferred from the recorded temperature slope and fan speed
+// (recorded RPM, or the profile curve if the trace has none).
+std::vector<double> recordedPower(const SimOptions& options, const ThermalPlant& plant,
+                                  const FanCurve& curve, double& duration, double& initialTemp) {
+    std::ifstream file(options.tracePath);
+    if (!file.is_open()) {
+        std::fprintf(stderr, "Cannot open trace %s\n", options.tracePath.c_str());
+        return {};
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        return {};
+    }
+
+    int timeCol = -1, tempCol = -1, powerCol = -1, rpmCol = -1;
+    {
+        std::stringstream header(line);
+        std::string name;
+        for (int col = 0; std::getline(header, name, ','); ++col) {
+            name = lowerCase(name);
+            name.erase(std::remove_if(name.begin(), name.end(), ::isspace), name.end());
+            if (name == "time" || name == "time_s" || name == "t") timeCol = col;
+            else if (name == "temp" || name == "temp_c" || name == "temperature") tempCol = col;
+            else if (name == "power" || name == "power_w") powerCol = col;
+            else if (name == "rpm" || name == "fan_rpm") rpmCol = col;
+        }
+    }
+    if (timeCol < 0 || (tempCol < 0 && powerCol < 0)) {
+        std::fprintf(stderr, "Trace needs a time column and a temp or power column\n");
+        return {};
+    }
+
+    struct Row { double t, temp, power, rpm; };
+    std::vector<Row> rows;
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string cell;
+        Row row{ 0, NAN, NAN, NAN };
+        for (int col = 0; std::getline(ss, cell, ','); ++col) {
+            double v = std::atof(cell.c_str());
+            if (col == timeCol) row.t = v;
+            else if (col == tempCol) row.temp = v;
+            else if (col == powerCol) row.power = v;
+            else if (col == rpmCol) row.rpm = v;
+        }
+        rows.push_back(row);
+    }
+    if (rows.size() < 2) {
+        std::fprintf(stderr, "Trace has fewer than two samples\n");
+        return {};
+    }
+
+    double t0 = rows.front().t;
+    for (Row& row : rows) row.t -= t0;
+
+    // Infer power from the temperature slope where it was not recorded
+    for (size_t i = 0; i < rows.size(); ++i) {
+        Row& row = rows[i];
+        if (!std::isnan(row.power)) continue;
+        size_t lo = i > 0 ? i - 1 : i;
+        size_t hi = i + 1 < rows.size() ? i + 1 : i;
+        double span = rows[hi].t - rows[lo].t;
+        double slope = span > 0 ? (rows[hi].temp - rows[lo].temp) / span : 0.0;
+        double rpm = std::isnan(row.rpm) ? FanCurves::evaluate(curve, int(std::lround(row.temp))) : row.rpm;
+        row.power = plant.inferPower(row.temp, slope, rpm);
+    }
+
+    if (!std::isnan(rows.front().temp)) {
+        initialTemp = rows.front().temp;
+    }
+    if (duration <= 0.0) {
+        duration = rows.back().t;
+    }
+
+    size_t steps = static_cast<size_t>(duration / options.controlPeriod);
+    std::vector<double> power(steps);
+    size_t r = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        double t = i * options.controlPeriod;
+        while (r + 1 < rows.size() && rows[r + 1].t <= t) ++r;
+        if (r + 1 < rows.size() && rows[r + 1].t > rows[r].t) {
+            double f = (t - rows[r].t) / (rows[r + 1].t - rows[r].t);
+            power[i] = rows[r].power + std::clamp(f, 0.0, 1.0) * (rows[r + 1].power - rows[r].power);
+        } else {
+            power[i] = rows[r].power;
+        }
+    }
+    return power;
+}
+
+/*---------------------------------------------------------*\
+| Closed-loop run                                           |
+\*---------------------------------------------------------*/
+
+// Temperature the curve settles at for a constant load
+double steadyState(const ThermalPlant& plant, const FanCurve& curve, const FanModel& model, double power) {
+    double t = plant.params().ambient;
+    for (int i = 0; i < 100; ++i) {
+        int rpm = model.clampTarget(FanCurves::evaluate(curve, int(std::lround(t))));
+        t = plant.params().ambient + power / plant.conductance(rpm);
+    }
+    return t;
+}
+
+SimMetrics runVariant(const SimOptions& options, const FanControllerParams& params, const FanCurve& curve,
+                      const std::vector<double>& power, double initialTemp, FILE* dump) {
+    constexpr int PORTS = FanController::PORT_COUNT;
+
+    FanModel model;
+    ThermalPlant plant;
+    plant.reset(initialTemp);
+
+    FanController controller(params);
+    controller.setCurveFunction([&curve](int, int temperature) {
+        return FanCurves::evaluate(curve, temperature);
+    });
+
+    double sensor = std::round(initialTemp);
+    double nextSample = 0.0;
+    const double dt = options.controlPeriod;
+    const double minInterval = options.minIntervalMs / 1000.0;
+
+    // Emulates FanActuator: quantized duty, suppression, per-port minimum interval
+    int lastDuty[PORTS], pendingDuty[PORTS];
+    double lastWrite[PORTS], fanRPM[PORTS];
+    for (int p = 0; p < PORTS; ++p) {
+        int rpm = model.clampTarget(FanCurves::evaluate(curve, int(sensor)));
+        lastDuty[p] = model.rpmToPercent(rpm);
+        pendingDuty[p] = -1;
+        lastWrite[p] = -1e9;
+        fanRPM[p] = model.percentToRPM(lastDuty[p]);
+    }
+
+    SimMetrics m;
+    m.peakTemp = initialTemp;
+    long writes = 0, calls = 0;
+    double dbaEnergy = 0.0;
+
+    // The acoustic controller holds the metrics target as its ceiling
+    AcousticParams acousticParams;
+    acousticParams.maxTemperature = options.target;
+    AcousticController acoustic(acousticParams);
+    for (int p = 0; p < PORTS; ++p) {
+        acoustic.setPortWeight(p + 1, options.weights[p]);
+    }
+
+    // Package power as LoadSampler reports it: averaged over each sampling interval
+    double nextLoad = 0.0, loadEnergy = 0.0, loadTime = 0.0;
+
+    ZeroRpmStage zeroRpm;
+    for (int p = 1; p <= PORTS; ++p) {
+        zeroRpm.setPortParams(p, options.zeroRpm);
+        zeroRpm.setPortMaxRPM(p, model.maxRPM());
+    }
+
+    FanControlOutput out[PORTS];
+    for (size_t i = 0; i < power.size(); ++i) {
+        double t = i * dt;
+        if (t >= nextSample) {
+            sensor = std::round(plant.temperature());
+            nextSample += options.sensorPeriod;
+        }
+        if (options.loadPeriod > 0) {
+            loadEnergy += power[i] * dt;
+            loadTime += dt;
+            if (t >= nextLoad) {
+                controller.setLoad(NAN, loadEnergy / loadTime);
+                loadEnergy = loadTime = 0.0;
+                nextLoad += options.loadPeriod;
+            }
+        }
+
+        if (options.acoustic) {
+            acoustic.step(sensor, dt, out);
+        } else {
+            controller.step(sensor, dt, out);
+        }
+        zeroRpm.apply(sensor, dt, out);
+
+        double levels[PORTS];
+        double airflow = 0.0;
+        for (int p = 0; p < PORTS; ++p) {
+            if (out[p].write) {
+                ++calls;
+                int duty = model.rpmToPercent(model.clampTarget(out[p].rpm));
+                if (duty == lastDuty[p]) {
+                    pendingDuty[p] = -1;
+                } else if (t - lastWrite[p] < minInterval) {
+                    pendingDuty[p] = duty;
+                } else {
+                    lastDuty[p] = duty;
+                    lastWrite[p] = t;
+                    pendingDuty[p] = -1;
+                    ++writes;
+                }
+            }
+            if (pendingDuty[p] >= 0 && t - lastWrite[p] >= minInterval) {
+                lastDuty[p] = pendingDuty[p];
+                lastWrite[p] = t;
+                pendingDuty[p] = -1;
+                ++writes;
+            }
+
+            fanRPM[p] = plant.fanResponse(fanRPM[p], model.percentToRPM(lastDuty[p]), dt);
+            airflow += fanRPM[p];
+            levels[p] = model.estimateDBA(int(std::lround(fanRPM[p])));
+        }
+
+        plant.step(power[i], airflow / PORTS, dt);
+
+        double temp = plant.temperature();
+        double dba = FanModel::combineDBA(levels, PORTS);
+        m.peakTemp = std::max(m.peakTemp, temp);
+        m.peakDBA = std::max(m.peakDBA, dba);
+        if (temp > options.target) {
+            m.timeAbove += dt;
+            m.excess += (temp - options.target) * dt;
+        }
+        dbaEnergy += std::pow(10.0, dba / 10.0);
+
+        if (dump) {
+            std::fprintf(dump, "%.2f,%.1f,%.2f,%.0f,%d,%.0f,%.1f\n", t, power[i], temp, sensor,
+                         out[0].rpm, airflow / PORTS, dba);
+        }
+    }
+
+    double minutes = power.size() * dt / 60.0;
+    m.overshoot = std::max(0.0, m.peakTemp - options.target);
+    m.writesPerMin = minutes > 0 ? writes / minutes : 0.0;
+    m.callsPerMin = minutes > 0 ? calls / minutes : 0.0;
+    m.meanDBA = power.empty() ? 0.0 : 10.0 * std::log10(dbaEnergy / power.size());
+    return m;
+}
+
+/*---------------------------------------------------------*\
+| Command line                                              |
+\*---------------------------------------------------------*/
+
+void printUsage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "Load source (one of):\n"
+        "  --trace FILE            CSV with time and temp and/or power columns\n"
+        "  --scenario NAME         idle | compile | burst | gaming | render | step (default compile)\n"
+        "\n"
+        "Controller:\n"
+        "  --profile NAME          Quiet | Standard | High Speed | Full Speed (default Quiet)\n"
+        "  --mode MODE             curve | acoustic (default curve); acoustic holds --target\n"
+        "  --weights a,b,c,d       Per-port noise weights for acoustic mode (default 1,1,1,1)\n"
+        "  --zero-rpm STOP,START   Stop fans below STOP °C (after 60 s), restart above START °C\n"
+        "  --set KEY=VALUE         Override a FanControllerParams field\n"
+        "  --sweep KEY=a,b,c       Run one variant per value (a:b:step ranges allowed);\n"
+        "                          several --sweep options form a grid\n"
+        "  --list-params           Print tunable parameter names and defaults\n"
+        "\n"
+        "Simulation:\n"
+        "  --duration SECONDS      Override the trace length\n"
+        "  --target CELSIUS        Temperature ceiling for the metrics (default 75)\n"
+        "  --min-interval MS       Actuator per-port minimum write interval (default 200)\n"
+        "  --sensor-period SECONDS Temperature refresh interval (default 0.5)\n"
+        "  --load-period SECONDS   Package power sampling interval for the load\n"
+        "                          feedforward (default 0.25, 0 = temperature only)\n"
+        "  --dump FILE             Write the time series of the first variant as CSV\n"
+        "  --csv                   Print results as CSV\n",
+        argv0);
+}
+
+bool splitAssignment(const std::string& text, std::string& key, std::string& value) {
+    size_t eq = text.find('=');
+    if (eq == std::string::npos) return false;
+    key = text.substr(0, eq);
+    value = text.substr(eq + 1);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    FanControllerParams base;
+    std::vector<std::pair<const ParamField*, std::vector<double>>> sweeps;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s needs a value\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--list-params") {
+            for (const ParamField& field : PARAM_FIELDS) {
+                double v = field.d ? base.*(field.d) : base.*(field.i);
+                std::printf("%-18s %g\n", field.name, v);
+            }
+            return 0;
+        } else if (arg == "--trace") {
+            options.tracePath = next();
+        } else if (arg == "--scenario") {
+            options.scenario = next();
+        } else if (arg == "--profile") {
+            options.profile = next();
+        } else if (arg == "--mode") {
+            std::string mode = next();
+            if (mode != "curve" && mode != "acoustic") {
+                std::fprintf(stderr, "Unknown mode '%s'\n", mode.c_str());
+                return 2;
+            }
+            options.acoustic = (mode == "acoustic");
+        } else if (arg == "--weights") {
+            std::vector<double> weights = parseValues(next());
+            for (size_t p = 0; p < weights.size() && p < FanController::PORT_COUNT; ++p) {
+                options.weights[p] = weights[p];
+            }
+        } else if (arg == "--zero-rpm") {
+            std::vector<double> thresholds = parseValues(next());
+            if (thresholds.size() != 2) {
+                std::fprintf(stderr, "--zero-rpm expects STOP,START\n");
+                return 2;
+            }
+            options.zeroRpm.enabled = true;
+            options.zeroRpm.stopTemperature = thresholds[0];
+            options.zeroRpm.startTemperature = thresholds[1];
+        } else if (arg == "--duration") {
+            options.duration = std::atof(next().c_str());
+        } else if (arg == "--target") {
+            options.target = std::atof(next().c_str());
+        } else if (arg == "--min-interval") {
+            options.minIntervalMs = std::atoi(next().c_str());
+        } else if (arg == "--sensor-period") {
+            options.sensorPeriod = std::max(0.05, std::atof(next().c_str()));
+        } else if (arg == "--load-period") {
+            options.loadPeriod = std::max(0.0, std::atof(next().c_str()));
+        } else if (arg == "--dump") {
+            options.dumpPath = next();
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else if (arg == "--set" || arg == "--sweep") {
+            std::string key, value;
+            if (!splitAssignment(next(), key, value)) {
+                std::fprintf(stderr, "%s expects KEY=VALUE\n", arg.c_str());
+                return 2;
+            }
+            const ParamField* field = findParam(key);
+            if (!field) {
+                std::fprintf(stderr, "Unknown parameter '%s' (see --list-params)\n", key.c_str());
+                return 2;
+            }
+            if (arg == "--set") {
+                setParam(base, *field, std::atof(value.c_str()));
+            } else {
+                std::vector<double> values = parseValues(value);
+                if (values.empty()) {
+                    std::fprintf(stderr, "No values for --sweep %s\n", key.c_str());
+                    return 2;
+                }
+                sweeps.emplace_back(field, values);
+            }
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    FanModel model;
+    ThermalPlant plant;
+    FanCurve curve = FanCurves::builtin(options.profile);
+
+    double duration = options.duration;
+    double initialTemp = NAN;
+    std::vector<double> power = options.tracePath.empty()
+        ? syntheticPower(options.scenario, options.controlPeriod, duration)
+        : recordedPower(options, plant, curve, duration, initialTemp);
+    if (power.empty()) {
+        return 1;
+    }
+    if (std::isnan(initialTemp)) {
+        initialTemp = steadyState(plant, curve, model, power.front());
+    }
+
+    // Expand the sweep grid
+    std::vector<Variant> variants{ { "baseline", base } };
+    for (const auto& sweep : sweeps) {
+        std::vector<Variant> expanded;
+        for (const Variant& variant : variants) {
+            for (double value : sweep.second) {
+                Variant v = variant;
+                setParam(v.params, *sweep.first, value);
+                char buf[64];
+                std::snprintf(buf, sizeof(buf), "%s=%g", sweep.first->name, value);
+                v.label = (variant.label == "baseline") ? buf : variant.label + " " + buf;
+                expanded.push_back(v);
+            }
+        }
+        variants.swap(expanded);
+    }
+
+    FILE* dump = nullptr;
+    if (!options.dumpPath.empty()) {
+        dump = std::fopen(options.dumpPath.c_str(), "w");
+        if (!dump) {
+            std::fprintf(stderr, "Cannot write %s\n", options.dumpPath.c_str());
+            return 1;
+        }
+        std::fprintf(dump, "time_s,power_w,temp_c,sensor_c,target_rpm,fan_rpm,dba\n");
+    }
+
+    if (options.csv) {
+        std::printf("variant,peak_c,overshoot_c,time_above_s,excess_cs,writes_per_min,calls_per_min,mean_dba,peak_dba\n");
+    } else {
+        std::printf("%s, %s %s, %.0f s simulated, target %.1f°C\n\n",
+                    options.tracePath.empty() ? options.scenario.c_str() : options.tracePath.c_str(),
+                    options.acoustic ? "mode" : "profile", options.acoustic ? "acoustic" : options.profile.c_str(),
+                    duration, options.target);
+        std::printf("%-40s %8s %9s %9s %9s %10s %9s %8s %8s\n", "variant", "peak°C", "over°C",
+                    "above s", "°C·s", "writes/m", "calls/m", "mean dB", "peak dB");
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    for (size_t v = 0; v < variants.size(); ++v) {
+        SimMetrics m = runVariant(options, variants[v].params, curve, power, initialTemp, v == 0 ? dump : nullptr);
+        const char* fmt = options.csv
+            ? "\"%s\",%.2f,%.2f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n"
+            : "%-40s %8.2f %9.2f %9.1f %9.1f %10.1f %9.1f %8.1f %8.1f\n";
+        std::printf(fmt, variants[v].label.c_str(), m.peakTemp, m.overshoot, m.timeAbove, m.excess,
+                    m.writesPerMin, m.callsPerMin, m.meanDBA, m.peakDBA);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    if (dump) {
+        std::fclose(dump);
+    }
+    if (!options.csv) {
+        std::printf("\n%zu variant(s) in %.3f s (%.0fx real time)\n", variants.size(), elapsed,
+                    elapsed > 0 ? duration * variants.size() / elapsed : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*---------------------------------------------------------*\
+||| thermalplant.h                                          |
+|||                                                         |
+|||   Lumped thermal model of a CPU cooled by case fans    |
+|||   used by the offline fan-control simulator            |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Single-node model:  C · dT/dt = P − G(rpm) · (T − Tambient)
+// G grows sub-linearly with airflow; the defaults put a 120 W load at ~65°C
+// with fans at full speed and ~98°C at the 840 RPM floor.
+struct ThermalPlantParams {
+    double heatCapacity  = 60.0;    // J/K, heatsink + die
+    double ambient       = 25.0;    // °C
+    double passiveG      = 0.4;     // W/K with fans stopped
+    double fanG          = 2.6;     // W/K added at full airflow
+    double airflowExp    = 0.8;     // G ∝ (rpm / maxRPM)^airflowExp
+    double maxRPM        = 2100.0;
+    double spinUpTau     = 1.2;     // s, fan speed lag when accelerating
+    double spinDownTau   = 2.0;     // s, fan speed lag when coasting down
+};
+
+class ThermalPlant {
+public:
+    explicit ThermalPlant(const ThermalPlantParams& params = ThermalPlantParams())
+        : m_params(params), m_temperature(params.ambient) {}
+
+    const ThermalPlantParams& params() const { return m_params; }
+
+    void reset(double temperature) { m_temperature = temperature; }
+    double temperature() const { return m_temperature; }
+
+    double conductance(double rpm) const {
+        double airflow = std::clamp(rpm / m_params.maxRPM, 0.0, 1.0);
+        return m_params.passiveG + m_params.fanG * std::pow(airflow, m_params.airflowExp);
+    }
+
+    // Heat input that explains a recorded temperature slope at the given fan speed
+    double inferPower(double temperature, double slope, double rpm) const {
+        return std::max(0.0, m_params.heatCapacity * slope + conductance(rpm) * (temperature - m_params.ambient));
+    }
+
+    // Advance by dt with heat input power (W) and effective fan speed rpm
+    void step(double power, double rpm, double dt) {
+        double g = conductance(rpm);
+        m_temperature += dt * (power - g * (m_temperature - m_params.ambient)) / m_params.heatCapacity;
+    }
+
+    // First-order fan response towards the commanded speed
+    double fanResponse(double current, double commanded, double dt) const {
+        double tau = commanded > current ? m_params.spinUpTau : m_params.spinDownTau;
+        return current + (commanded - current) * (1.0 - std::exp(-dt / tau));
+    }
+
+private:
+    ThermalPlantParams m_params;
+    double m_temperature;
+};
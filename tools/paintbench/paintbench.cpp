@@ -0,0 +1,118 @@
+/*---------------------------------------------------------*\
+||| paintbench.cpp                                          |
+|||                                                         |
+|||   Lighting preview paint benchmark                     |
+|||   Times EffectRenderer producing a full 8-channel LED  |
+|||   frame for every effect, then renders                 |
+|||   FanLightingWidget offscreen and reports the mean     |
+|||   paint time of a warm frame (cached artwork) against  |
+|||   a cold one (everything rebuilt after a resize).      |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "lighting/effectrenderer.h"
+#include "widgets/fanlightingwidget.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const char* const EFFECTS[] = {
+    "Rainbow", "Rainbow Morph", "Static Color", "Breathing", "Meteor", "Runway", "Groove",
+    "Mixing", "Neon", "Stack", "Staggered", "Tide", "Tunnel", "Voice",
+};
+
+// Mean microseconds per render(); a cold frame first nudges the size so the
+// artwork pixmap and ring geometry are rebuilt and the frame re-rendered
+double timeFrames(FanLightingWidget& widget, QImage& target, int frames, bool cold) {
+    const QSize size = widget.size();
+    QElapsedTimer timer;
+    qint64 total = 0;
+
+    for (int i = 0; i < frames; ++i) {
+        if (cold) {
+            widget.resize(size + QSize(i % 2, 0));
+            widget.setBrightness(100 - i % 2);
+        }
+        timer.start();
+        widget.render(&target);
+        total += timer.nsecsElapsed();
+    }
+    widget.resize(size);
+    return total / 1000.0 / frames;
+}
+
+// Mean microseconds per EffectRenderer::render() over a 20 FPS timeline
+double timeRender(EffectRenderer::Effect effect, int frames) {
+    EffectRenderer renderer;
+    renderer.setEffect(effect);
+    LedFrame frame;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frames; ++i) {
+        renderer.render(i * 0.05, frame);
+    }
+    return timer.nsecsElapsed() / 1000.0 / frames;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // No display needed
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    int frames = 500;
+    int width = 600;
+    int height = 400;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (!std::strcmp(argv[i], "--size") && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                std::fprintf(stderr, "--size needs WIDTHxHEIGHT\n");
+                return 2;
+            }
+        } else {
+            std::printf("Usage: %s [--frames N] [--size WIDTHxHEIGHT]\n", argv[0]);
+            return std::strcmp(argv[i], "--help") ? 2 : 0;
+        }
+    }
+
+    FanLightingWidget widget;
+    widget.resize(width, height);
+    QImage target(widget.size(), QImage::Format_ARGB32_Premultiplied);
+
+    std::printf("%dx%d, %d frames per effect\n\n", width, height, frames);
+    std::printf("%-16s %12s %12s %12s\n", "effect", "render us", "warm us", "cold us");
+
+    double renderTotal = 0.0, warmTotal = 0.0, coldTotal = 0.0;
+    for (const char* effect : EFFECTS) {
+        widget.setEffect(effect);
+        widget.render(&target); // Build the caches once
+
+        const double render = timeRender(EffectRenderer::effectFromName(effect), frames);
+        const double warm = timeFrames(widget, target, frames, false);
+        const double cold = timeFrames(widget, target, frames, true);
+        renderTotal += render;
+        warmTotal += warm;
+        coldTotal += cold;
+        std::printf("%-16s %12.2f %12.1f %12.1f\n", effect, render, warm, cold);
+    }
+
+    const int count = int(sizeof(EFFECTS) / sizeof(EFFECTS[0]));
+    std::printf("%-16s %12.2f %12.1f %12.1f\n", "mean", renderTotal / count, warmTotal / count, coldTotal / count);
+    return 0;
+}
@@ -0,0 +1,240 @@
+/*---------------------------------------------------------*\
+||| procbench.cpp                                           |
+|||                                                         |
+|||   /proc parsing microbenchmark                         |
+|||   Times one sample of /proc/stat, meminfo, net/dev and |
+|||   cpuinfo the old way (stream per read, line strings,  |
+|||   split into tokens) against ProcFile and the procfs   |
+|||   scanners, with and without the read itself, and     |
+|||   counts heap allocations per sample.                  |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "sensors/procfs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_allocations(0);
+
+} // namespace
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps results alive so the optimiser can't drop a parse
+volatile uint64_t g_sink;
+
+std::vector<std::string> split(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(line);
+    std::string token;
+    while (stream >> token) tokens.push_back(token);
+    return tokens;
+}
+
+// The pattern the pages used before: open, getline, split every interesting line
+
+uint64_t baselineStat(std::istream& in) {
+    std::string line;
+    uint64_t busy = 0;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 3, "cpu") != 0) break;
+        std::vector<std::string> parts = split(line);
+        for (size_t i = 1; i < parts.size() && i <= 8; ++i) {
+            if (i != 4 && i != 5) busy += std::stoull(parts[i]);
+        }
+    }
+    return busy;
+}
+
+uint64_t baselineMeminfo(std::istream& in) {
+    std::string line;
+    uint64_t sum = 0;
+    while (std::getline(in, line)) {
+        if (line.rfind("MemTotal:", 0) == 0 || line.rfind("MemFree:", 0) == 0
+            || line.rfind("MemAvailable:", 0) == 0 || line.rfind("Buffers:", 0) == 0
+            || line.rfind("Cached:", 0) == 0) {
+            sum += std::stoull(split(line)[1]);
+        }
+    }
+    return sum;
+}
+
+uint64_t baselineNetDev(std::istream& in) {
+    std::string line;
+    uint64_t sum = 0;
+    std::getline(in, line);
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string name = line.substr(0, colon);
+        std::vector<std::string> parts = split(line.substr(colon + 1));
+        if (parts.size() >= 9) sum += std::stoull(parts[0]) + std::stoull(parts[8]) + name.size();
+    }
+    return sum;
+}
+
+uint64_t baselineCpuInfo(std::istream& in) {
+    std::string line;
+    double maxMHz = 0.0;
+    while (std::getline(in, line)) {
+        if (line.rfind("cpu MHz", 0) != 0) continue;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        maxMHz = std::max(maxMHz, std::stod(line.substr(colon + 1)));
+    }
+    return uint64_t(maxMHz);
+}
+
+// The replacement: one pread into a kept buffer, scanners straight over it
+
+uint64_t fastStat(const char* text) {
+    CpuTimes total;
+    CpuTimes cores[256];
+    parseStat(text, total, cores, 256);
+    return total.busy() + cores[0].busy();
+}
+
+uint64_t fastMeminfo(const char* text) {
+    MemInfo info;
+    parseMeminfo(text, info);
+    return info.totalKB + info.freeKB + info.availableKB + info.buffersKB + info.cachedKB;
+}
+
+uint64_t fastNetDev(const char* text) {
+    NetDevCounters devices[64];
+    int count = parseNetDev(text, devices, 64);
+    uint64_t sum = 0;
+    for (int i = 0; i < count && i < 64; ++i) sum += devices[i].rxBytes + devices[i].txBytes;
+    return sum;
+}
+
+uint64_t fastCpuInfo(const char* text) {
+    CpuInfoSummary summary;
+    parseCpuInfo(text, summary);
+    return uint64_t(summary.maxMHz);
+}
+
+struct Source {
+    const char* name;
+    uint64_t (*baseline)(std::istream&);
+    uint64_t (*fast)(const char*);
+};
+
+const Source SOURCES[] = {
+    { "stat",    baselineStat,    fastStat },
+    { "meminfo", baselineMeminfo, fastMeminfo },
+    { "net/dev", baselineNetDev,  fastNetDev },
+    { "cpuinfo", baselineCpuInfo, fastCpuInfo },
+};
+
+struct Result {
+    double nanoseconds;
+    double allocations;
+};
+
+template <typename Body>
+Result measure(int iterations, Body body) {
+    body();     // Warm up: first-read buffer growth, page faults
+    uint64_t allocationsBefore = g_allocations.load();
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i) body();
+    double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    uint64_t allocations = g_allocations.load() - allocationsBefore;
+    return { elapsed / iterations, double(allocations) / iterations };
+}
+
+void printUsage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "  --iterations N          Samples per measurement (default 20000)\n"
+        "  --proc DIR              procfs root to read (default /proc)\n"
+        "\n"
+        "\"sample\" includes reading the file, \"parse\" scans text already in memory.\n",
+        argv0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = 20000;
+    std::string procRoot = "/proc";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--proc" && i + 1 < argc) {
+            procRoot = argv[++i];
+        } else {
+            std::fprintf(stderr, "Unknown option '%s'\n", arg.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("%-8s  %13s %8s  %13s %8s  %13s %13s\n", "file",
+                "old sample ns", "allocs", "new sample ns", "allocs", "old parse ns", "new parse ns");
+
+    for (const Source& source : SOURCES) {
+        const std::string path = procRoot + "/" + source.name;
+        ProcFile file(path);
+        if (!file.isOpen()) {
+            std::printf("%-8s  (cannot open %s)\n", source.name, path.c_str());
+            continue;
+        }
+
+        Result oldSample = measure(iterations, [&]() {
+            std::ifstream in(path);
+            g_sink = source.baseline(in);
+        });
+        Result newSample = measure(iterations, [&]() {
+            g_sink = source.fast(file.read());
+        });
+
+        // Same text for both parsers, so only the scanning differs
+        const std::string text = file.read();
+        Result oldParse = measure(iterations, [&]() {
+            std::istringstream in(text);
+            g_sink = source.baseline(in);
+        });
+        Result newParse = measure(iterations, [&]() {
+            g_sink = source.fast(text.c_str());
+        });
+
+        std::printf("%-8s  %13.0f %8.1f  %13.0f %8.1f  %13.0f %13.0f\n", source.name,
+                    oldSample.nanoseconds, oldSample.allocations,
+                    newSample.nanoseconds, newSample.allocations,
+                    oldParse.nanoseconds, newParse.nanoseconds);
+    }
+    return 0;
+}
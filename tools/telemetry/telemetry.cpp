@@ -0,0 +1,210 @@
+/*---------------------------------------------------------*\
+||| telemetry.cpp                                           |
+|||                                                         |
+|||   Telemetry log export                                 |
+|||   Lists what the persistent telemetry log holds and    |
+|||   exports a tier (raw, minute or hour rollups) for a   |
+|||   time range as CSV or JSON. Safe to run while         |
+|||   LL-Connect 3 is writing the log.                     |
+|||                                                         |
+|||   This file is part of the LL-Connect 3 project        |
+|||   SPDX-License-Identifier: GPL-2.0-or-later            |
+\*---------------------------------------------------------*/
+
+#include "sensors/telemetrylog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// "now", a duration back from now ("90m", "24h", "7d"), seconds since the epoch,
+// or a UTC date "YYYY-MM-DD[THH:MM[:SS]]"; -1 if none of those
+int64_t parseTime(const std::string& text) {
+    if (text == "now") return nowMs();
+
+    char* end = nullptr;
+    const double number = std::strtod(text.c_str(), &end);
+    if (end != text.c_str() && *end && !end[1]) {
+        const double unit = *end == 's' ? 1e3 : *end == 'm' ? 60e3 : *end == 'h' ? 3600e3 : *end == 'd' ? 86400e3 : 0.0;
+        if (unit > 0.0) return nowMs() - int64_t(number * unit);
+    }
+    if (end != text.c_str() && !*end && text.find('-') == std::string::npos) {
+        return int64_t(number * 1000.0);
+    }
+
+    tm utc;
+    std::memset(&utc, 0, sizeof(utc));
+    int fields = std::sscanf(text.c_str(), "%d-%d-%d%*1[T ]%d:%d:%d", &utc.tm_year, &utc.tm_mon, &utc.tm_mday,
+                             &utc.tm_hour, &utc.tm_min, &utc.tm_sec);
+    if (fields < 3) return -1;
+    utc.tm_year -= 1900;
+    utc.tm_mon -= 1;
+    return int64_t(timegm(&utc)) * 1000;
+}
+
+bool parseTier(const std::string& text, TelemetryLog::Tier& tier) {
+    for (int t = 0; t < TelemetryLog::TIER_COUNT; ++t) {
+        if (text == TelemetryLog::tierName(TelemetryLog::Tier(t))) {
+            tier = TelemetryLog::Tier(t);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        if (comma > start) items.push_back(text.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return items;
+}
+
+void printSummary(const TelemetryReader& reader) {
+    for (int t = 0; t < TelemetryLog::TIER_COUNT; ++t) {
+        const TelemetryLog::Tier tier = TelemetryLog::Tier(t);
+        int64_t first = 0, last = 0;
+        size_t rows = 0;
+        reader.forEach(tier, INT64_MIN, INT64_MAX, [&](const TelemetryReader::Row& row) {
+            if (rows++ == 0) first = row.timeMs;
+            last = row.timeMs;
+        });
+
+        std::printf("%-7s %8zu records", TelemetryLog::tierName(tier), rows);
+        if (rows) {
+            char from[32], to[32];
+            const time_t a = time_t(first / 1000), b = time_t(last / 1000);
+            std::strftime(from, sizeof(from), "%Y-%m-%d %H:%M:%S", std::gmtime(&a));
+            std::strftime(to, sizeof(to), "%Y-%m-%d %H:%M:%S", std::gmtime(&b));
+            std::printf("  %s .. %s UTC", from, to);
+        }
+        std::printf("\n");
+    }
+
+    std::printf("\nSeries:\n");
+    for (const std::string& name : reader.series(TelemetryLog::RAW)) {
+        std::printf("  %s\n", name.c_str());
+    }
+}
+
+void printUsage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "  --dir DIR           Log directory (default %s)\n"
+        "  --list              Show the time span of each tier and the recorded series\n"
+        "  --tier TIER         raw | minute | hour (default minute)\n"
+        "  --format FORMAT     csv | json (default csv)\n"
+        "  --from TIME         Start of the range (default 24h)\n"
+        "  --to TIME           End of the range (default now)\n"
+        "  --series a,b,...    Only these series (default all)\n"
+        "  --output FILE       Write to FILE instead of stdout\n"
+        "\n"
+        "TIME is 'now', an age such as 90m, 24h or 7d, seconds since the epoch, or a UTC\n"
+        "date YYYY-MM-DD[THH:MM[:SS]].\n",
+        argv0, TelemetryLog::defaultDirectory().c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = TelemetryLog::defaultDirectory();
+    std::string outputPath;
+    std::vector<std::string> series;
+    TelemetryLog::Tier tier = TelemetryLog::MINUTE;
+    TelemetryReader::Format format = TelemetryReader::CSV;
+    int64_t from = parseTime("24h");
+    int64_t to = parseTime("now");
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s needs a value\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--dir") {
+            directory = next();
+        } else if (arg == "--list") {
+            list = true;
+        } else if (arg == "--tier") {
+            std::string name = next();
+            if (!parseTier(name, tier)) {
+                std::fprintf(stderr, "Unknown tier '%s'\n", name.c_str());
+                return 2;
+            }
+        } else if (arg == "--format") {
+            std::string name = next();
+            if (name != "csv" && name != "json") {
+                std::fprintf(stderr, "Unknown format '%s'\n", name.c_str());
+                return 2;
+            }
+            format = name == "csv" ? TelemetryReader::CSV : TelemetryReader::JSON;
+        } else if (arg == "--from" || arg == "--to") {
+            std::string text = next();
+            int64_t time = parseTime(text);
+            if (time < 0) {
+                std::fprintf(stderr, "Can't read time '%s'\n", text.c_str());
+                return 2;
+            }
+            (arg == "--from" ? from : to) = time;
+        } else if (arg == "--series") {
+            series = splitList(next());
+        } else if (arg == "--output") {
+            outputPath = next();
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    TelemetryReader reader(directory);
+    if (reader.series(tier).empty() && reader.series(TelemetryLog::RAW).empty()) {
+        std::fprintf(stderr, "No telemetry log in %s\n", directory.c_str());
+        return 1;
+    }
+
+    if (list) {
+        printSummary(reader);
+        return 0;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            std::fprintf(stderr, "Can't write %s\n", outputPath.c_str());
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    const size_t rows = reader.exportTo(out, format, tier, from, to, series);
+    out.flush();
+    std::fprintf(stderr, "%zu %s records\n", rows, TelemetryLog::tierName(tier));
+    return out ? 0 : 1;
+}